@@ -10,6 +10,8 @@
 #include <iso_chronology.h>
 #include <timezone.h>
 #include <smalltime_exceptions.h>
+#include <float_util.h>
+#include <result.h>
 
 #include "datetime_util.h"
 
@@ -30,6 +32,10 @@ namespace smalltime
 		DateTime(RD utc_rd);
 		DateTime(RD local_rd, const std::string& time_zone);
 
+		DateTime(int year, int month, int day, int hour, int minute, int second, int millisecond, const tz::ZoneHandle& zone_handle);
+		DateTime(int year, int month, int day, int hour, int minute, int second, int millisecond, RS rel, const tz::ZoneHandle& zone_handle);
+		DateTime(RD rd, const tz::ZoneHandle& zone_handle);
+
 		template <typename U>
 		DateTime(const DateTime<U>& other) noexcept;
 
@@ -39,6 +45,21 @@ namespace smalltime
 		template <typename U>
 		DateTime(const LocalDateTime<U>& other, const std::string& time_zone);
 
+		template <typename U>
+		DateTime(const LocalDateTime<U>& other, const tz::ZoneHandle& zone_handle);
+
+		// Non-throwing factories, invalid fields, an unknown zone or an ambiguous local time come back as a status
+		static Result<DateTime> TryCreate(int year, int month, int day, int hour, int minute, int second, int millisecond, const std::string& time_zone, Choose choose = Choose::KError);
+		static Result<DateTime> TryCreate(int year, int month, int day, int hour, int minute, int second, int millisecond, const tz::ZoneHandle& zone_handle, Choose choose = Choose::KError);
+		static Result<DateTime> TryCreate(RD local_rd, const std::string& time_zone, Choose choose = Choose::KError);
+		static Result<DateTime> TryCreate(RD local_rd, const tz::ZoneHandle& zone_handle, Choose choose = Choose::KError);
+
+		template <typename U>
+		static Result<DateTime> TryFrom(const LocalDateTime<U>& other, const std::string& time_zone);
+
+		template <typename U>
+		static Result<DateTime> TryFrom(const LocalDateTime<U>& other, const tz::ZoneHandle& zone_handle);
+
 		int GetYear() const { return ymd_[0]; }
 		int GetMonth() const { return ymd_[1]; }
 		int GetDay() const { return ymd_[2]; }
@@ -51,6 +72,10 @@ namespace smalltime
 		RD GetFixed() const { return fixed_; }
 
 	private:
+		// utc_rd is known to be valid, fields are derived without checks
+		struct Unchecked {};
+		DateTime(RD utc_rd, Unchecked) noexcept;
+
 		std::array<int, 3> ymd_;
 		std::array<int, 4> hms_;
 		RD fixed_;
@@ -62,16 +87,16 @@ namespace smalltime
 	//==================================
 	// Init static member
 	//==================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	T DateTime<T>::KCHRONOLOGY;
 
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	tz::TimeZone DateTime<T>::KTIMEZONE;
 
 	//================================================
 	// Ctor - create date from fields
 	//================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	DateTime<T>::DateTime(int year, int month, int day, int hour, int minute, int second, int millisecond, std::string time_zone)
 	{
 		fixed_ = KCHRONOLOGY.FixedFromYmd(year, month, day);
@@ -94,10 +119,36 @@ namespace smalltime
 
 	}
 
+	//======================================================
+	// Ctor - create date from fields in a resolved time zone
+	//======================================================
+	template <typename T>
+	DateTime<T>::DateTime(int year, int month, int day, int hour, int minute, int second, int millisecond, const tz::ZoneHandle& zone_handle)
+	{
+		fixed_ = KCHRONOLOGY.FixedFromYmd(year, month, day);
+		fixed_ += KCHRONOLOGY.FixedFromTime(hour, minute, second, millisecond);
+
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		// check if valid date
+		if (year != ymd_[0] || month != ymd_[1] || day != ymd_[2])
+			throw InvalidFieldException("Invalid field or fields");
+		// check if valid time
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
+		if (hour != hms_[0] || minute != hms_[1] || second != hms_[2] || millisecond != hms_[3])
+			throw InvalidFieldException("Invalid field or fields");
+		
+		auto offset = KTIMEZONE.FixedOffsetFromLocal(fixed_, zone_handle, Choose::KError);
+		fixed_ -= offset;
+
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
+
+	}
+
 	//====================================================
 	// Ctor - create date from fields relative to
 	//====================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	DateTime<T>::DateTime(int year, int month, int day, int hour, int minute, int second, int millisecond, RS rel, std::string time_zone)
 	{
 		fixed_ = KCHRONOLOGY.FixedFromYmd(year, month, day);
@@ -122,10 +173,38 @@ namespace smalltime
 
 	}
 
+	//==================================================================
+	// Ctor - create date from fields relative to in a resolved time zone
+	//==================================================================
+	template <typename T>
+	DateTime<T>::DateTime(int year, int month, int day, int hour, int minute, int second, int millisecond, RS rel, const tz::ZoneHandle& zone_handle)
+	{
+		fixed_ = KCHRONOLOGY.FixedFromYmd(year, month, day);
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		// check if valid date
+		if (year != ymd_[0] || month != ymd_[1] || day != ymd_[2])
+			throw InvalidFieldException("Invalid field or fields");
+
+		fixed_ = KCHRONOLOGY.FixedRelativeTo(fixed_, rel);
+		fixed_ += KCHRONOLOGY.FixedFromTime(hour, minute, second, millisecond);
+
+		// check if valid time
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
+		if (hour != hms_[0] || minute != hms_[1] || second != hms_[2] || millisecond != hms_[3])
+			throw InvalidFieldException("Invalid field or fields");
+
+		auto offset = KTIMEZONE.FixedOffsetFromLocal(fixed_, zone_handle, Choose::KError);
+		fixed_ -= offset;
+
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
+
+	}
+
 	//====================================================
 	// Ctor - create date from local fixed date
 	//====================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	DateTime<T>::DateTime(RD rd, std::string time_zone)
 	{
 		ymd_ = KCHRONOLOGY.YmdFromFixed(rd);
@@ -146,10 +225,34 @@ namespace smalltime
 
 	}
 
+	//================================================================
+	// Ctor - create date from local fixed date in a resolved time zone
+	//================================================================
+	template <typename T>
+	DateTime<T>::DateTime(RD rd, const tz::ZoneHandle& zone_handle)
+	{
+		ymd_ = KCHRONOLOGY.YmdFromFixed(rd);
+		fixed_ = KCHRONOLOGY.FixedFromYmd(ymd_[0], ymd_[1], ymd_[2]);
+
+		hms_ = KCHRONOLOGY.TimeFromFixed(rd);
+		fixed_ += KCHRONOLOGY.FixedFromTime(hms_[0], hms_[1], hms_[2], hms_[3]);
+
+		// check if valid date
+		if (fixed_ != rd)
+			throw InvalidFieldException("Invalid field or fields");
+
+		auto offset = KTIMEZONE.FixedOffsetFromLocal(fixed_, zone_handle, Choose::KError);
+		fixed_ -= offset;
+
+		ymd_ = KCHRONOLOGY.YmdFromFixed(rd);
+		hms_ = KCHRONOLOGY.TimeFromFixed(rd);
+
+	}
+
 	//=============================================================
 	// create from DateTime of diffrent chronology
 	//============================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	template <typename U>
 	DateTime<T>::DateTime(const DateTime<U>& other) noexcept
 	{
@@ -164,7 +267,7 @@ namespace smalltime
 	//=============================================================
 	// create relative to another DateTime
 	//============================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	template <typename U>
 	DateTime<T>::DateTime(const DateTime<U>& other, RS rel) noexcept
 	{
@@ -181,7 +284,7 @@ namespace smalltime
 	//=============================================================
 	// create from a LocalDateTime
 	//============================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	template <typename U>
 	DateTime<T>::DateTime(const LocalDateTime<U>& other, const std::string& time_zone)
 	{
@@ -197,10 +300,29 @@ namespace smalltime
 
 	}
 
+	//===================================================
+	// create from a LocalDateTime in a resolved time zone
+	//===================================================
+	template <typename T>
+	template <typename U>
+	DateTime<T>::DateTime(const LocalDateTime<U>& other, const tz::ZoneHandle& zone_handle)
+	{
+		// We know the other DateTime must be valid if it didn't throw an exception,
+		// no reason to check if fields are valid
+		fixed_ = other.GetFixed();
+
+		auto offset = KTIMEZONE.FixedOffsetFromUtc(fixed_, zone_handle);
+		fixed_ -= offset;
+
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
+
+	}
+
 	//=============================================================
 	// Ctor - create date from fixed date interpreted as  utc
 	//=============================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	DateTime<T>::DateTime(RD utc_rd)
 	{
 		ymd_ = KCHRONOLOGY.YmdFromFixed(utc_rd);
@@ -221,7 +343,7 @@ namespace smalltime
 	//===============================================================
 	// Ctor - create date from fixed date interpreted as local
 	//==============================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	DateTime<T>::DateTime(RD local_rd, const std::string& time_zone)
 	{
 		ymd_ = KCHRONOLOGY.YmdFromFixed(local_rd);
@@ -241,6 +363,117 @@ namespace smalltime
 		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
 	}
 
+	//================================================
+	// Ctor - fields of a valid utc fixed date
+	//================================================
+	template <typename T>
+	DateTime<T>::DateTime(RD utc_rd, Unchecked) noexcept
+	{
+		fixed_ = utc_rd;
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
+	}
+
+	//================================================
+	// Create date from fields, no throw
+	//================================================
+	template <typename T>
+	Result<DateTime<T>> DateTime<T>::TryCreate(int year, int month, int day, int hour, int minute, int second, int millisecond, const std::string& time_zone, Choose choose)
+	{
+		RD local_rd = 0.0;
+		Status status = FixedFromFields(KCHRONOLOGY, year, month, day, hour, minute, second, millisecond, local_rd);
+		if (status != Status::KOk)
+			return status;
+
+		auto offset = KTIMEZONE.TryFixedOffsetFromLocal(local_rd, time_zone, choose);
+		if (!offset)
+			return offset.GetStatus();
+
+		return DateTime(local_rd - offset.GetValue(), Unchecked());
+	}
+
+	//======================================================
+	// Create date from fields in a resolved time zone, no throw
+	//======================================================
+	template <typename T>
+	Result<DateTime<T>> DateTime<T>::TryCreate(int year, int month, int day, int hour, int minute, int second, int millisecond, const tz::ZoneHandle& zone_handle, Choose choose)
+	{
+		RD local_rd = 0.0;
+		Status status = FixedFromFields(KCHRONOLOGY, year, month, day, hour, minute, second, millisecond, local_rd);
+		if (status != Status::KOk)
+			return status;
+
+		auto offset = KTIMEZONE.TryFixedOffsetFromLocal(local_rd, zone_handle, choose);
+		if (!offset)
+			return offset.GetStatus();
+
+		return DateTime(local_rd - offset.GetValue(), Unchecked());
+	}
+
+	//==============================================
+	// Create date from local fixed date, no throw
+	//==============================================
+	template <typename T>
+	Result<DateTime<T>> DateTime<T>::TryCreate(RD local_rd, const std::string& time_zone, Choose choose)
+	{
+		RD fixed = RebuildFixed(KCHRONOLOGY, local_rd);
+		if (fixed != local_rd)
+			return Status::KInvalidField;
+
+		auto offset = KTIMEZONE.TryFixedOffsetFromLocal(fixed, time_zone, choose);
+		if (!offset)
+			return offset.GetStatus();
+
+		return DateTime(fixed - offset.GetValue(), Unchecked());
+	}
+
+	//======================================================================
+	// Create date from local fixed date in a resolved time zone, no throw
+	//======================================================================
+	template <typename T>
+	Result<DateTime<T>> DateTime<T>::TryCreate(RD local_rd, const tz::ZoneHandle& zone_handle, Choose choose)
+	{
+		RD fixed = RebuildFixed(KCHRONOLOGY, local_rd);
+		if (fixed != local_rd)
+			return Status::KInvalidField;
+
+		auto offset = KTIMEZONE.TryFixedOffsetFromLocal(fixed, zone_handle, choose);
+		if (!offset)
+			return offset.GetStatus();
+
+		return DateTime(fixed - offset.GetValue(), Unchecked());
+	}
+
+	//========================================
+	// Create from a LocalDateTime, no throw
+	//========================================
+	template <typename T>
+	template <typename U>
+	Result<DateTime<T>> DateTime<T>::TryFrom(const LocalDateTime<U>& other, const std::string& time_zone)
+	{
+		// Same offset as the converting constructor
+		auto offset = KTIMEZONE.TryFixedOffsetFromUtc(other.GetFixed(), time_zone);
+		if (!offset)
+			return offset.GetStatus();
+
+		return DateTime(other.GetFixed() - offset.GetValue(), Unchecked());
+	}
+
+	//================================================================
+	// Create from a LocalDateTime in a resolved time zone, no throw
+	//================================================================
+	template <typename T>
+	template <typename U>
+	Result<DateTime<T>> DateTime<T>::TryFrom(const LocalDateTime<U>& other, const tz::ZoneHandle& zone_handle)
+	{
+		// Same offset as the converting constructor
+		auto offset = KTIMEZONE.TryFixedOffsetFromUtc(other.GetFixed(), zone_handle);
+		if (!offset)
+			return offset.GetStatus();
+
+		return DateTime(other.GetFixed() - offset.GetValue(), Unchecked());
+	}
+
 	//==================================================================
 	// Explicit specialization for Iso calendar
 	// allows initialization by year/week/day and year/day format
@@ -255,6 +488,10 @@ namespace smalltime
 		DateTime(RD utc_rd);
 		DateTime(RD local_rd, const std::string& time_zone);
 
+		DateTime(int year, int month, int day, int hour, int minute, int second, int millisecond, const tz::ZoneHandle& zone_handle);
+		DateTime(int year, int month, int day, int hour, int minute, int second, int millisecond, RS rel, const tz::ZoneHandle& zone_handle);
+		DateTime(RD local_rd, const tz::ZoneHandle& zone_handle);
+
 		template <typename U>
 		DateTime(const DateTime<U>& other) noexcept;
 
@@ -264,32 +501,50 @@ namespace smalltime
 		template <typename U>
 		DateTime(const LocalDateTime<U>& other, const std::string& time_zone);
 
+		template <typename U>
+		DateTime(const LocalDateTime<U>& other, const tz::ZoneHandle& zone_handle);
+
+		// Non-throwing factories, invalid fields, an unknown zone or an ambiguous local time come back as a status
+		static Result<DateTime> TryCreate(int year, int month, int day, int hour, int minute, int second, int millisecond, const std::string& time_zone, Choose choose = Choose::KError);
+		static Result<DateTime> TryCreate(int year, int month, int day, int hour, int minute, int second, int millisecond, const tz::ZoneHandle& zone_handle, Choose choose = Choose::KError);
+		static Result<DateTime> TryCreate(RD local_rd, const std::string& time_zone, Choose choose = Choose::KError);
+		static Result<DateTime> TryCreate(RD local_rd, const tz::ZoneHandle& zone_handle, Choose choose = Choose::KError);
+
+		template <typename U>
+		static Result<DateTime> TryFrom(const LocalDateTime<U>& other, const std::string& time_zone);
+
+		template <typename U>
+		static Result<DateTime> TryFrom(const LocalDateTime<U>& other, const tz::ZoneHandle& zone_handle);
+
 		int GetYear() const { return ymd_[0]; }
 		int GetMonth() const { return ymd_[1]; }
 		int GetDay() const { return ymd_[2]; }
 
-		int GetWeekYear() const { return ywd_[0]; }
-		int GetWeekOfWeekYear() const { return ywd_[1]; }
-		int GetDayOfWeekYear() const { return ywd_[2]; }
+		// week date, day of year, week of month and leap year are derived on each call
+		int GetWeekYear() const { return KCHRONOLOGY.YwdFromFixed(fixed_)[0]; }
+		int GetWeekOfWeekYear() const { return KCHRONOLOGY.YwdFromFixed(fixed_)[1]; }
+		int GetDayOfWeekYear() const { return KCHRONOLOGY.YwdFromFixed(fixed_)[2]; }
+		std::array<int, 3> GetWeekDate() const { return KCHRONOLOGY.YwdFromFixed(fixed_); }
 
-		int GetDayOfYear() const { return day_of_year_; }
+		int GetDayOfYear() const { return KCHRONOLOGY.YdFromFixed(fixed_)[1]; }
 
 		int GetHour() const { return hms_[0]; }
 		int GetMinute() const { return hms_[1]; }
 		int GetSecond() const { return hms_[2]; }
 		int GetMillisecond() const { return hms_[3]; }
 
-		int GetWeekOfMonth() const { return week_of_month_; }
-		bool IsLeapYear() const { return leap_year_; }
+		int GetWeekOfMonth() const { return KCHRONOLOGY.WeekOfMonth(ymd_, fixed_); }
+		bool IsLeapYear() const { return KCHRONOLOGY.IsLeapYear(ymd_[0]); }
 
 		RD GetFixed() const { return fixed_; }
 
 	private:
+		// utc_rd is known to be valid, fields are derived without checks
+		struct Unchecked {};
+		DateTime(RD utc_rd, Unchecked) noexcept;
+
 		std::array<int, 3> ymd_;
-		std::array<int, 3> ywd_;
 		std::array<int, 4> hms_;
-		int day_of_year_, week_of_month_;
-		bool leap_year_;
 		RD fixed_;
 
 		static chrono::IsoChronology KCHRONOLOGY;
@@ -324,12 +579,31 @@ namespace smalltime
 
 		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
 		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
-		// since this should be a valid date we can obtain the other data
-		ywd_ = KCHRONOLOGY.YwdFromFixed(fixed_);
-		leap_year_ = KCHRONOLOGY.IsLeapYear(ymd_[0]);
-		week_of_month_ = KCHRONOLOGY.WeekOfMonth(ymd_, fixed_);
-		auto yd = KCHRONOLOGY.YdFromFixed(fixed_);
-		day_of_year_ = yd[1];
+
+	}
+
+	//======================================================
+	// Ctor - create date from fields in a resolved time zone
+	//======================================================
+	DateTime<chrono::IsoChronology>::DateTime(int year, int month, int day, int hour, int minute, int second, int millisecond, const tz::ZoneHandle& zone_handle)
+	{
+		fixed_ = KCHRONOLOGY.FixedFromYmd(year, month, day);
+		fixed_ += KCHRONOLOGY.FixedFromTime(hour, minute, second, millisecond);
+
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		// check if valid date
+		if (year != ymd_[0] || month != ymd_[1] || day != ymd_[2])
+			throw InvalidFieldException("Invalid field or fields");
+		// check if valid time
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
+		if (hour != hms_[0] || minute != hms_[1] || second != hms_[2] || millisecond != hms_[3])
+			throw InvalidFieldException("Invalid field or fields");
+
+		auto offset = KTIMEZONE.FixedOffsetFromLocal(fixed_, zone_handle, Choose::KError);
+		fixed_ -= offset;
+
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
 
 	}
 
@@ -358,12 +632,33 @@ namespace smalltime
 
 		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
 		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
-		// since this should be a valid date we can obtain the other data
-		ywd_ = KCHRONOLOGY.YwdFromFixed(fixed_);
-		leap_year_ = KCHRONOLOGY.IsLeapYear(ymd_[0]);
-		week_of_month_ = KCHRONOLOGY.WeekOfMonth(ymd_, fixed_);
-		auto yd = KCHRONOLOGY.YdFromFixed(fixed_);
-		day_of_year_ = yd[1];
+	}
+
+	//==================================================================
+	// Ctor - create date from fields relative to in a resolved time zone
+	//==================================================================
+	DateTime<chrono::IsoChronology>::DateTime(int year, int month, int day, int hour, int minute, int second, int millisecond, RS rel, const tz::ZoneHandle& zone_handle)
+	{
+		fixed_ = KCHRONOLOGY.FixedFromYmd(year, month, day);
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		// check if valid date
+		if (year != ymd_[0] || month != ymd_[1] || day != ymd_[2])
+			throw InvalidFieldException("Invalid field or fields");
+
+		fixed_ = KCHRONOLOGY.FixedRelativeTo(fixed_, rel);
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+
+		fixed_ += KCHRONOLOGY.FixedFromTime(hour, minute, second, millisecond);
+		// check if valid time
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
+		if (hour != hms_[0] || minute != hms_[1] || second != hms_[2] || millisecond != hms_[3])
+			throw InvalidFieldException("Invalid field or fields");
+
+		auto offset = KTIMEZONE.FixedOffsetFromLocal(fixed_, zone_handle, Choose::KError);
+		fixed_ -= offset;
+
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
 	}
 
 	//====================================================
@@ -386,12 +681,28 @@ namespace smalltime
 
 		ymd_ = KCHRONOLOGY.YmdFromFixed(local_rd);
 		hms_ = KCHRONOLOGY.TimeFromFixed(local_rd);
-		// since this should be a valid date we can obtain the other data
-		ywd_ = KCHRONOLOGY.YwdFromFixed(fixed_);
-		leap_year_ = KCHRONOLOGY.IsLeapYear(ymd_[0]);
-		week_of_month_ = KCHRONOLOGY.WeekOfMonth(ymd_, fixed_);
-		auto yd = KCHRONOLOGY.YdFromFixed(fixed_);
-		day_of_year_ = yd[1];
+	}
+
+	//================================================================
+	// Ctor - create date from local fixed date in a resolved time zone
+	//================================================================
+	DateTime<chrono::IsoChronology>::DateTime(RD local_rd, const tz::ZoneHandle& zone_handle)
+	{
+		ymd_ = KCHRONOLOGY.YmdFromFixed(local_rd);
+		fixed_ = KCHRONOLOGY.FixedFromYmd(ymd_[0], ymd_[1], ymd_[2]);
+
+		hms_ = KCHRONOLOGY.TimeFromFixed(local_rd);
+		fixed_ += KCHRONOLOGY.FixedFromTime(hms_[0], hms_[1], hms_[2], hms_[3]);
+
+		// check if valid date
+		if (fixed_ != local_rd)
+			throw InvalidFieldException("Invalid field or fields");
+
+		auto offset = KTIMEZONE.FixedOffsetFromLocal(fixed_, zone_handle, Choose::KError);
+		fixed_ -= offset;
+
+		ymd_ = KCHRONOLOGY.YmdFromFixed(local_rd);
+		hms_ = KCHRONOLOGY.TimeFromFixed(local_rd);
 	}
 
 	//====================================================
@@ -412,13 +723,6 @@ namespace smalltime
 		ymd_ = KCHRONOLOGY.YmdFromFixed(utc_rd);
 		hms_ = KCHRONOLOGY.TimeFromFixed(utc_rd);
 
-		// since this should be a valid date we can obtain the other data
-		ywd_ = KCHRONOLOGY.YwdFromFixed(fixed_);
-		leap_year_ = KCHRONOLOGY.IsLeapYear(ymd_[0]);
-		week_of_month_ = KCHRONOLOGY.WeekOfMonth(ymd_, fixed_);
-		auto yd = KCHRONOLOGY.YdFromFixed(fixed_);
-		day_of_year_ = yd[1];
-
 	}
 
 	//=============================================================
@@ -432,13 +736,6 @@ namespace smalltime
 		fixed_ = other.GetFixed();
 		ymd_ = KCHRONOLOGY.YmdFromFixed(other.GetFixed());
 		hms_ = KCHRONOLOGY.TimeFromFixed(other.GetFixed());
-	
-		// since this should be a valid date we can obtain the other data
-		ywd_ = KCHRONOLOGY.YwdFromFixed(fixed_);
-		leap_year_ = KCHRONOLOGY.IsLeapYear(ymd_[0]);
-		week_of_month_ = KCHRONOLOGY.WeekOfMonth(ymd_, fixed_);
-		auto yd = KCHRONOLOGY.YdFromFixed(fixed_);
-		day_of_year_ = yd[1];
 	}
 
 	//=============================================================
@@ -455,13 +752,6 @@ namespace smalltime
 		ymd_ = KCHRONOLOGY.YmdFromFixed(other.GetFixed());
 		fixed_ += KCHRONOLOGY.FixedFromTime(hms_[0], hms_[1], hms_[2], hms_[3]);
 
-		// since this should be a valid date we can obtain the other data
-		ywd_ = KCHRONOLOGY.YwdFromFixed(fixed_);
-		leap_year_ = KCHRONOLOGY.IsLeapYear(ymd_[0]);
-		week_of_month_ = KCHRONOLOGY.WeekOfMonth(ymd_, fixed_);
-		auto yd = KCHRONOLOGY.YdFromFixed(fixed_);
-		day_of_year_ = yd[1];
-
 	}
 
 	//=============================================================
@@ -480,12 +770,128 @@ namespace smalltime
 		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
 		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
 
-		// since this should be a valid date we can obtain the other data
-		ywd_ = KCHRONOLOGY.YwdFromFixed(fixed_);
-		leap_year_ = KCHRONOLOGY.IsLeapYear(ymd_[0]);
-		week_of_month_ = KCHRONOLOGY.WeekOfMonth(ymd_, fixed_);
-		auto yd = KCHRONOLOGY.YdFromFixed(fixed_);
-		day_of_year_ = yd[1];
+	}
+
+	//===================================================
+	// create from a LocalDateTime in a resolved time zone
+	//===================================================
+	template <typename U>
+	DateTime<chrono::IsoChronology>::DateTime(const LocalDateTime<U>& other, const tz::ZoneHandle& zone_handle)
+	{
+		// We know the other DateTime must be valid if it didn't throw an exception,
+		// no reason to check if fields are valid
+		fixed_ = other.GetFixed();
+
+		auto offset = KTIMEZONE.FixedOffsetFromUtc(fixed_, zone_handle);
+		fixed_ -= offset;
+
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
+
+	}
+
+	//================================================
+	// Ctor - fields of a valid utc fixed date
+	//================================================
+	DateTime<chrono::IsoChronology>::DateTime(RD utc_rd, Unchecked) noexcept
+	{
+		fixed_ = utc_rd;
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
+	}
+
+	//================================================
+	// Create date from fields, no throw
+	//================================================
+	Result<DateTime<chrono::IsoChronology>> DateTime<chrono::IsoChronology>::TryCreate(int year, int month, int day, int hour, int minute, int second, int millisecond, const std::string& time_zone, Choose choose)
+	{
+		RD local_rd = 0.0;
+		Status status = FixedFromFields(KCHRONOLOGY, year, month, day, hour, minute, second, millisecond, local_rd);
+		if (status != Status::KOk)
+			return status;
+
+		auto offset = KTIMEZONE.TryFixedOffsetFromLocal(local_rd, time_zone, choose);
+		if (!offset)
+			return offset.GetStatus();
+
+		return DateTime(local_rd - offset.GetValue(), Unchecked());
+	}
+
+	//======================================================
+	// Create date from fields in a resolved time zone, no throw
+	//======================================================
+	Result<DateTime<chrono::IsoChronology>> DateTime<chrono::IsoChronology>::TryCreate(int year, int month, int day, int hour, int minute, int second, int millisecond, const tz::ZoneHandle& zone_handle, Choose choose)
+	{
+		RD local_rd = 0.0;
+		Status status = FixedFromFields(KCHRONOLOGY, year, month, day, hour, minute, second, millisecond, local_rd);
+		if (status != Status::KOk)
+			return status;
+
+		auto offset = KTIMEZONE.TryFixedOffsetFromLocal(local_rd, zone_handle, choose);
+		if (!offset)
+			return offset.GetStatus();
+
+		return DateTime(local_rd - offset.GetValue(), Unchecked());
+	}
+
+	//==============================================
+	// Create date from local fixed date, no throw
+	//==============================================
+	Result<DateTime<chrono::IsoChronology>> DateTime<chrono::IsoChronology>::TryCreate(RD local_rd, const std::string& time_zone, Choose choose)
+	{
+		RD fixed = RebuildFixed(KCHRONOLOGY, local_rd);
+		if (fixed != local_rd)
+			return Status::KInvalidField;
+
+		auto offset = KTIMEZONE.TryFixedOffsetFromLocal(fixed, time_zone, choose);
+		if (!offset)
+			return offset.GetStatus();
+
+		return DateTime(fixed - offset.GetValue(), Unchecked());
+	}
+
+	//======================================================================
+	// Create date from local fixed date in a resolved time zone, no throw
+	//======================================================================
+	Result<DateTime<chrono::IsoChronology>> DateTime<chrono::IsoChronology>::TryCreate(RD local_rd, const tz::ZoneHandle& zone_handle, Choose choose)
+	{
+		RD fixed = RebuildFixed(KCHRONOLOGY, local_rd);
+		if (fixed != local_rd)
+			return Status::KInvalidField;
+
+		auto offset = KTIMEZONE.TryFixedOffsetFromLocal(fixed, zone_handle, choose);
+		if (!offset)
+			return offset.GetStatus();
+
+		return DateTime(fixed - offset.GetValue(), Unchecked());
+	}
+
+	//========================================
+	// Create from a LocalDateTime, no throw
+	//========================================
+	template <typename U>
+	Result<DateTime<chrono::IsoChronology>> DateTime<chrono::IsoChronology>::TryFrom(const LocalDateTime<U>& other, const std::string& time_zone)
+	{
+		// Same offset as the converting constructor
+		auto offset = KTIMEZONE.TryFixedOffsetFromUtc(other.GetFixed(), time_zone);
+		if (!offset)
+			return offset.GetStatus();
+
+		return DateTime(other.GetFixed() - offset.GetValue(), Unchecked());
+	}
+
+	//================================================================
+	// Create from a LocalDateTime in a resolved time zone, no throw
+	//================================================================
+	template <typename U>
+	Result<DateTime<chrono::IsoChronology>> DateTime<chrono::IsoChronology>::TryFrom(const LocalDateTime<U>& other, const tz::ZoneHandle& zone_handle)
+	{
+		// Same offset as the converting constructor
+		auto offset = KTIMEZONE.TryFixedOffsetFromUtc(other.GetFixed(), zone_handle);
+		if (!offset)
+			return offset.GetStatus();
+
+		return DateTime(other.GetFixed() - offset.GetValue(), Unchecked());
 	}
 
 	//=============================================
@@ -1,10 +1,49 @@
 #pragma once
 
 #include <string>
+#include <core_decls.h>
+#include <timezone_db.h>
 
 namespace smalltime
 {
 	// Sets the path for the tzdb.bin to be searched for
 	void SetTimeZoneFilePath(std::string file_path);
+	// Sets whether the tzdb.bin is memory-mapped, read into private memory
+	// or the compiled in tables are used
+	void SetTimeZoneLoadMode(tz::LoadMode load_mode);
+
+	//=====================================================================
+	// Fixed date of calendar and time fields, Status::KInvalidField when
+	// the fields do not come back out of the chronology unchanged
+	//=====================================================================
+	template <typename T>
+	Status FixedFromFields(const T& chronology, int year, int month, int day, int hour, int minute, int second, int millisecond, RD& rd)
+	{
+		rd = chronology.FixedFromYmd(year, month, day);
+		rd += chronology.FixedFromTime(hour, minute, second, millisecond);
+
+		auto ymd = chronology.YmdFromFixed(rd);
+		if (year != ymd[0] || month != ymd[1] || day != ymd[2])
+			return Status::KInvalidField;
+
+		auto hms = chronology.TimeFromFixed(rd);
+		if (hour != hms[0] || minute != hms[1] || second != hms[2] || millisecond != hms[3])
+			return Status::KInvalidField;
+
+		return Status::KOk;
+	}
+
+	//=====================================================================
+	// Fixed date rebuilt from the calendar and time fields of rd, the
+	// constructors taking a fixed date reject rd when the two differ
+	//=====================================================================
+	template <typename T>
+	RD RebuildFixed(const T& chronology, RD rd)
+	{
+		auto ymd = chronology.YmdFromFixed(rd);
+		auto hms = chronology.TimeFromFixed(rd);
+
+		return chronology.FixedFromYmd(ymd[0], ymd[1], ymd[2]) + chronology.FixedFromTime(hms[0], hms[1], hms[2], hms[3]);
+	}
 
 }
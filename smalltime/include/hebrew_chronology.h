@@ -4,6 +4,8 @@
 
 #include "core_decls.h"
 
+#include <cinttypes>
+
 namespace smalltime
 {
 
@@ -23,6 +25,22 @@ namespace smalltime
 			bool IsLeapYear(int year) const;
 
 		private:
+			//=====================================================================
+			// New year, length and kind of a hebrew year, the kind picks the
+			// row of cumulative month offsets
+			//=====================================================================
+			struct HebrewYear
+			{
+				int32_t new_year;
+				int16_t days;
+				int16_t kind;
+			};
+
+			HebrewYear FindHebrewYear(int year) const;
+			HebrewYear ComputeHebrewYear(int year) const;
+
+			RD FixedFromMonthDays(int year, int month, int day) const;
+
 			int HebrewMonthDays(int month, int year) const;
 			int HebrewYearMonths(int year) const;
 			RD HebrewYearDays(int year) const;
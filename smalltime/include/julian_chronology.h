@@ -3,25 +3,33 @@
 #define _JULIANCHRONOLOGY_
 
 #include "core_decls.h"
+#include <core_math.h>
+#include <time_math.h>
 
 namespace smalltime
 {
 
 	namespace chrono
 	{
+		static constexpr int64_t KJULIAN_EPOCH = -1;
+
+		//=====================================================================
+		// Julian calendar, conversions between fields and whole days are
+		// constexpr integer arithmetic
+		//=====================================================================
 		class JulianChronology
 		{
 		public:
-			RD FixedFromYmd(int year, int month, int day) const;
-			std::array<int, 3> YmdFromFixed(RD rd) const;
+			constexpr RD FixedFromYmd(int year, int month, int day) const;
+			constexpr std::array<int, 3> YmdFromFixed(RD rd) const;
 			
 
 			RD FixedRelativeTo(RD rd, RS rel) const;
 
-			RD FixedFromTime(int hour, int minute, int second, int milli) const;
+			constexpr RD FixedFromTime(int hour, int minute, int second, int milli) const;
 			std::array<int, 4> TimeFromFixed(RD rd) const;
 
-			bool IsLeapYear(int year) const;
+			constexpr bool IsLeapYear(int year) const;
 
 		private:
 			int DetermineYearFromFixed(RD rd) const;
@@ -30,6 +38,72 @@ namespace smalltime
 
 		};
 
+		//============================================================
+		// Calculate the RD format from the year, month, day format
+		//============================================================
+		constexpr RD JulianChronology::FixedFromYmd(int year, int month, int day) const
+		{
+			// there is no year 0
+			int64_t y = year < 0 ? static_cast<int64_t>(year) + 1 : year;
+
+			int64_t lp = 0;
+			if (month <= 2)
+				lp = 0;
+			else if (IsLeapYear(year))
+				lp = -1;
+			else
+				lp = -2;
+
+			return static_cast<RD>(KJULIAN_EPOCH - 1 + 365 * (y - 1) + math::FloorDiv(y - 1, 4) +
+				math::FloorDiv(367 * static_cast<int64_t>(month) - 362, 12) + lp + day);
+		}
+
+		//=====================================================
+		// Calculate the YMD format from RD format
+		//=====================================================
+		constexpr std::array<int, 3> JulianChronology::YmdFromFixed(RD rd) const
+		{
+			int64_t dt_only = static_cast<int64_t>(math::ConstFloor(rd));
+			int64_t approx = math::FloorDiv(4 * (dt_only - KJULIAN_EPOCH) + 1464, 1461);
+
+			int year = static_cast<int>(approx <= 0 ? approx - 1 : approx);
+
+			int64_t prior_days = dt_only - static_cast<int64_t>(FixedFromYmd(year, 1, 1));
+			int64_t correction = 0;
+
+			if (dt_only < FixedFromYmd(year, 3, 1))
+				correction = 0;
+			else if (IsLeapYear(year))
+				correction = 1;
+			else
+				correction = 2;
+
+			int month = static_cast<int>(math::FloorDiv(12 * (prior_days + correction) + 373, 367));
+			int day = static_cast<int>(dt_only - static_cast<int64_t>(FixedFromYmd(year, month, 1)) + 1);
+
+			return{ year, month, day };
+		}
+
+		//=====================================================
+		// Calculate RD format from time fields
+		//=====================================================
+		constexpr RD JulianChronology::FixedFromTime(int hour, int min, int sec, int milli) const
+		{
+			return math::FixedFromTime(hour, min, sec, milli);
+		}
+
+		//=====================================================
+		// Find if the given year is a leap year
+		//=====================================================
+		constexpr bool JulianChronology::IsLeapYear(int year) const
+		{
+			// years before 1 count back from 1 BC, which is a leap year
+			if (year > 0)
+				return year % 4 == 0;
+
+			return year % 4 == -1;
+		}
+
 	}
 }
 
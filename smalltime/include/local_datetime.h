@@ -7,6 +7,7 @@
 #include <smalltime_exceptions.h>
 #include <timezone.h>
 #include <float_util.h>
+#include <result.h>
 
 #include "datetime_util.h"
 
@@ -27,6 +28,7 @@ namespace smalltime
 
 		LocalDateTime(RD local_rd);
 		LocalDateTime(RD utc_rd, const std::string& time_zone);
+		LocalDateTime(RD utc_rd, const tz::ZoneHandle& zone_handle);
 
 		template <typename U>
 		LocalDateTime(const LocalDateTime<U>& other) noexcept;
@@ -34,9 +36,23 @@ namespace smalltime
 		template <typename U>
 		LocalDateTime(const DateTime<U>& other, const std::string& time_zone);
 
+		template <typename U>
+		LocalDateTime(const DateTime<U>& other, const tz::ZoneHandle& zone_handle);
+
 		template <typename U>
 		LocalDateTime(const LocalDateTime<U>& other, RS rel) noexcept;
 
+		// Non-throwing factories, invalid fields or an unknown zone come back as a status
+		static Result<LocalDateTime> TryCreate(int year, int month, int day, int hour, int minute, int second, int millisecond);
+		static Result<LocalDateTime> TryFrom(RD utc_rd, const std::string& time_zone);
+		static Result<LocalDateTime> TryFrom(RD utc_rd, const tz::ZoneHandle& zone_handle);
+
+		template <typename U>
+		static Result<LocalDateTime> TryFrom(const DateTime<U>& other, const std::string& time_zone);
+
+		template <typename U>
+		static Result<LocalDateTime> TryFrom(const DateTime<U>& other, const tz::ZoneHandle& zone_handle);
+
 		int GetYear() const { return ymd_[0]; }
 		int GetMonth() const { return ymd_[1]; }
 		int GetDay() const { return ymd_[2]; }
@@ -49,6 +65,10 @@ namespace smalltime
 		RD GetFixed() const { return fixed_; }
 
 	private:
+		// local_rd is known to be valid, fields are derived without checks
+		struct Unchecked {};
+		LocalDateTime(RD local_rd, Unchecked) noexcept;
+
 		std::array<int, 3> ymd_;
 		std::array<int, 4> hms_;
 		RD fixed_;
@@ -60,16 +80,16 @@ namespace smalltime
 	//==================================
 	// Init static member
 	//==================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	T LocalDateTime<T>::KCHRONOLOGY;
 
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	tz::TimeZone LocalDateTime<T>::KTIMEZONE;
 
 	//================================================
 	// Ctor - create date from fields
 	//================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	LocalDateTime<T>::LocalDateTime(int year, int month, int day, int hour, int minute, int second, int millisecond)
 	{
 		fixed_ = KCHRONOLOGY.FixedFromYmd(year, month, day);
@@ -89,7 +109,7 @@ namespace smalltime
 	//====================================================
 	// Ctor - create date from fields relative to
 	//====================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	LocalDateTime<T>::LocalDateTime(int year, int month, int day, int hour, int minute, int second, int millisecond, RS rel)
 	{
 		fixed_ = KCHRONOLOGY.FixedFromYmd(year, month, day);
@@ -111,7 +131,7 @@ namespace smalltime
 	//===========================================================
 	// Ctor - create date from fixed date interpreted as local
 	//============================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	LocalDateTime<T>::LocalDateTime(RD local_rd)
 	{
 		ymd_ = KCHRONOLOGY.YmdFromFixed(local_rd);
@@ -128,7 +148,7 @@ namespace smalltime
 	//===============================================================
 	// Ctor - create date from fixed date interpreted as utc
 	//==============================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	LocalDateTime<T>::LocalDateTime(RD utc_rd, const std::string& time_zone)
 	{
 		ymd_ = KCHRONOLOGY.YmdFromFixed(utc_rd);
@@ -148,10 +168,33 @@ namespace smalltime
 		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
 	}
 
+	//==============================================================================
+	// Ctor - create date from fixed date interpreted as utc in a resolved time zone
+	//==============================================================================
+	template <typename T>
+	LocalDateTime<T>::LocalDateTime(RD utc_rd, const tz::ZoneHandle& zone_handle)
+	{
+		ymd_ = KCHRONOLOGY.YmdFromFixed(utc_rd);
+		fixed_ = KCHRONOLOGY.FixedFromYmd(ymd_[0], ymd_[1], ymd_[2]);
+
+		hms_ = KCHRONOLOGY.TimeFromFixed(utc_rd);
+		fixed_ += KCHRONOLOGY.FixedFromTime(hms_[0], hms_[1], hms_[2], hms_[3]);
+
+		// check if valid date
+		if (!AlmostEqualRelative(fixed_, utc_rd))
+			throw InvalidFieldException("Invalid field or fields");
+
+		auto offset = KTIMEZONE.FixedOffsetFromUtc(fixed_, zone_handle);
+		fixed_ += offset;
+
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
+	}
+
 	//=============================================================
 	// create from LocalDateTime of diffrent chronology
 	//============================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	template <typename U>
 	LocalDateTime<T>::LocalDateTime(const LocalDateTime<U>& other) noexcept
 	{
@@ -165,7 +208,7 @@ namespace smalltime
 	//=============================================================
 	// create from a DateTime
 	//============================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	template <typename U>
 	LocalDateTime<T>::LocalDateTime(const DateTime<U>& other, const std::string& time_zone)
 	{
@@ -180,10 +223,28 @@ namespace smalltime
 
 	}
 
+	//===============================================
+	// create from a DateTime in a resolved time zone
+	//===============================================
+	template <typename T>
+	template <typename U>
+	LocalDateTime<T>::LocalDateTime(const DateTime<U>& other, const tz::ZoneHandle& zone_handle)
+	{
+		// We know the other DateTime must be valid if it didn't throw an exception,
+		// no reason to check if fields are valid
+		fixed_ = other.GetFixed();
+		auto offset = KTIMEZONE.FixedOffsetFromUtc(fixed_, zone_handle);
+		fixed_ += offset;
+
+		ymd_ = KCHRONOLOGY.YmdFromFixed(other.GetFixed());
+		hms_ = KCHRONOLOGY.TimeFromFixed(other.GetFixed());
+
+	}
+
 	//=================================================
 	// Create relative to another LocalDateTime
 	//=================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	template <typename U>
 	LocalDateTime<T>::LocalDateTime(const LocalDateTime<U>& other, RS rel) noexcept
 	{
@@ -195,6 +256,93 @@ namespace smalltime
 		fixed_ += KCHRONOLOGY.FixedFromTime(hms_[0], hms_[1], hms_[2], hms_[3]);
 	}
 
+	//================================================
+	// Ctor - fields of a valid local fixed date
+	//================================================
+	template <typename T>
+	LocalDateTime<T>::LocalDateTime(RD local_rd, Unchecked) noexcept
+	{
+		fixed_ = local_rd;
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
+	}
+
+	//================================================
+	// Create date from fields, no throw
+	//================================================
+	template <typename T>
+	Result<LocalDateTime<T>> LocalDateTime<T>::TryCreate(int year, int month, int day, int hour, int minute, int second, int millisecond)
+	{
+		RD local_rd = 0.0;
+		Status status = FixedFromFields(KCHRONOLOGY, year, month, day, hour, minute, second, millisecond, local_rd);
+		if (status != Status::KOk)
+			return status;
+
+		return LocalDateTime(local_rd, Unchecked());
+	}
+
+	//===========================================================
+	// Create date from fixed date interpreted as utc, no throw
+	//===========================================================
+	template <typename T>
+	Result<LocalDateTime<T>> LocalDateTime<T>::TryFrom(RD utc_rd, const std::string& time_zone)
+	{
+		RD fixed = RebuildFixed(KCHRONOLOGY, utc_rd);
+		if (!AlmostEqualRelative(fixed, utc_rd))
+			return Status::KInvalidField;
+
+		auto offset = KTIMEZONE.TryFixedOffsetFromUtc(fixed, time_zone);
+		if (!offset)
+			return offset.GetStatus();
+
+		return LocalDateTime(fixed + offset.GetValue(), Unchecked());
+	}
+
+	//===================================================================================
+	// Create date from fixed date interpreted as utc in a resolved time zone, no throw
+	//===================================================================================
+	template <typename T>
+	Result<LocalDateTime<T>> LocalDateTime<T>::TryFrom(RD utc_rd, const tz::ZoneHandle& zone_handle)
+	{
+		RD fixed = RebuildFixed(KCHRONOLOGY, utc_rd);
+		if (!AlmostEqualRelative(fixed, utc_rd))
+			return Status::KInvalidField;
+
+		auto offset = KTIMEZONE.TryFixedOffsetFromUtc(fixed, zone_handle);
+		if (!offset)
+			return offset.GetStatus();
+
+		return LocalDateTime(fixed + offset.GetValue(), Unchecked());
+	}
+
+	//===================================
+	// Create from a DateTime, no throw
+	//===================================
+	template <typename T>
+	template <typename U>
+	Result<LocalDateTime<T>> LocalDateTime<T>::TryFrom(const DateTime<U>& other, const std::string& time_zone)
+	{
+		auto offset = KTIMEZONE.TryFixedOffsetFromUtc(other.GetFixed(), time_zone);
+		if (!offset)
+			return offset.GetStatus();
+
+		return LocalDateTime(other.GetFixed() + offset.GetValue(), Unchecked());
+	}
+
+	//===========================================================
+	// Create from a DateTime in a resolved time zone, no throw
+	//===========================================================
+	template <typename T>
+	template <typename U>
+	Result<LocalDateTime<T>> LocalDateTime<T>::TryFrom(const DateTime<U>& other, const tz::ZoneHandle& zone_handle)
+	{
+		auto offset = KTIMEZONE.TryFixedOffsetFromUtc(other.GetFixed(), zone_handle);
+		if (!offset)
+			return offset.GetStatus();
+
+		return LocalDateTime(other.GetFixed() + offset.GetValue(), Unchecked());
+	}
+
 	//==================================================================
 	// Explicit specialization for Iso calendar
 	// allows initialization by year/week/day and year/day format
@@ -208,6 +356,7 @@ namespace smalltime
 
 		LocalDateTime(RD local_rd);
 		LocalDateTime(RD utc_rd, const std::string& time_zone);
+		LocalDateTime(RD utc_rd, const tz::ZoneHandle& zone_handle);
 
 		template <typename U>
 		LocalDateTime(const LocalDateTime<U>& other) noexcept;
@@ -215,35 +364,52 @@ namespace smalltime
 		template <typename U>
 		LocalDateTime(const DateTime<U>& other, const std::string& time_zone);
 
+		template <typename U>
+		LocalDateTime(const DateTime<U>& other, const tz::ZoneHandle& zone_handle);
+
 		template <typename U>
 		LocalDateTime(const LocalDateTime<U>& other, RS rel) noexcept;
 
+		// Non-throwing factories, invalid fields or an unknown zone come back as a status
+		static Result<LocalDateTime> TryCreate(int year, int month, int day, int hour, int minute, int second, int millisecond);
+		static Result<LocalDateTime> TryFrom(RD utc_rd, const std::string& time_zone);
+		static Result<LocalDateTime> TryFrom(RD utc_rd, const tz::ZoneHandle& zone_handle);
+
+		template <typename U>
+		static Result<LocalDateTime> TryFrom(const DateTime<U>& other, const std::string& time_zone);
+
+		template <typename U>
+		static Result<LocalDateTime> TryFrom(const DateTime<U>& other, const tz::ZoneHandle& zone_handle);
+
 		int GetYear() const { return ymd_[0]; }
 		int GetMonth() const { return ymd_[1]; }
 		int GetDay() const { return ymd_[2]; }
 
-		int GetWeekYear() const { return ywd_[0]; }
-		int GetWeekOfWeekYear() const { return ywd_[1]; }
-		int GetDayOfWeekYear() const { return ywd_[2]; }
+		// week date, day of year, week of month and leap year are derived on each call
+		int GetWeekYear() const { return KCHRONOLOGY.YwdFromFixed(fixed_)[0]; }
+		int GetWeekOfWeekYear() const { return KCHRONOLOGY.YwdFromFixed(fixed_)[1]; }
+		int GetDayOfWeekYear() const { return KCHRONOLOGY.YwdFromFixed(fixed_)[2]; }
+		std::array<int, 3> GetWeekDate() const { return KCHRONOLOGY.YwdFromFixed(fixed_); }
 
-		int GetDayOfYear() const { return day_of_year_; }
+		int GetDayOfYear() const { return KCHRONOLOGY.YdFromFixed(fixed_)[1]; }
 
 		int GetHour() const { return hms_[0]; }
 		int GetMinute() const { return hms_[1]; }
 		int GetSecond() const { return hms_[2]; }
 		int GetMillisecond() const { return hms_[3]; }
 
-		int GetWeekOfMonth() const { return week_of_month_; }
-		bool IsLeapYear() const { return leap_year_; }
+		int GetWeekOfMonth() const { return KCHRONOLOGY.WeekOfMonth(ymd_, fixed_); }
+		bool IsLeapYear() const { return KCHRONOLOGY.IsLeapYear(ymd_[0]); }
 
 		RD GetFixed() const { return fixed_; }
 
 	private:
+		// local_rd is known to be valid, fields are derived without checks
+		struct Unchecked {};
+		LocalDateTime(RD local_rd, Unchecked) noexcept;
+
 		std::array<int, 3> ymd_;
-		std::array<int, 3> ywd_;
 		std::array<int, 4> hms_;
-		int day_of_year_, week_of_month_, day_of_week_;
-		bool leap_year_;
 		RD fixed_;
 
 		static chrono::IsoChronology KCHRONOLOGY;
@@ -273,13 +439,6 @@ namespace smalltime
 		if (hour != hms_[0] || minute != hms_[1] || second != hms_[2] || millisecond != hms_[3])
 			throw InvalidFieldException("Invalid field or fields");
 
-		// since this should be a valid date we can obtain the other data
-		ywd_ = KCHRONOLOGY.YwdFromFixed(fixed_);
-		leap_year_ = KCHRONOLOGY.IsLeapYear(ymd_[0]);
-		week_of_month_ = KCHRONOLOGY.WeekOfMonth(ymd_, fixed_);
-		auto yd = KCHRONOLOGY.YdFromFixed(fixed_);
-		day_of_year_ = yd[1];
-
 	}
 
 	//====================================================
@@ -302,12 +461,6 @@ namespace smalltime
 		if (hour != hms_[0] || minute != hms_[1] || second != hms_[2] || millisecond != hms_[3])
 			throw InvalidFieldException("Invalid field or fields");
 
-		// since this should be a valid date we can obtain the other data
-		ywd_ = KCHRONOLOGY.YwdFromFixed(fixed_);
-		leap_year_ = KCHRONOLOGY.IsLeapYear(ymd_[0]);
-		week_of_month_ = KCHRONOLOGY.WeekOfMonth(ymd_, fixed_);
-		auto yd = KCHRONOLOGY.YdFromFixed(fixed_);
-		day_of_year_ = yd[1];
 	}
 
 	//====================================================
@@ -325,12 +478,6 @@ namespace smalltime
 		if (fixed_ != local_rd)
 			throw InvalidFieldException("Invalid field or fields");
 
-		// since this should be a valid date we can obtain the other data
-		ywd_ = KCHRONOLOGY.YwdFromFixed(fixed_);
-		leap_year_ = KCHRONOLOGY.IsLeapYear(ymd_[0]);
-		week_of_month_ = KCHRONOLOGY.WeekOfMonth(ymd_, fixed_);
-		auto yd = KCHRONOLOGY.YdFromFixed(fixed_);
-		day_of_year_ = yd[1];
 	}
 
 	//===============================================================
@@ -353,12 +500,28 @@ namespace smalltime
 
 		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
 		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
-		// since this should be a valid date we can obtain the other data
-		ywd_ = KCHRONOLOGY.YwdFromFixed(fixed_);
-		leap_year_ = KCHRONOLOGY.IsLeapYear(ymd_[0]);
-		week_of_month_ = KCHRONOLOGY.WeekOfMonth(ymd_, fixed_);
-		auto yd = KCHRONOLOGY.YdFromFixed(fixed_);
-		day_of_year_ = yd[1];
+	}
+
+	//==============================================================================
+	// Ctor - create date from fixed date interpreted as utc in a resolved time zone
+	//==============================================================================
+	LocalDateTime<chrono::IsoChronology>::LocalDateTime(RD utc_rd, const tz::ZoneHandle& zone_handle)
+	{
+		ymd_ = KCHRONOLOGY.YmdFromFixed(utc_rd);
+		fixed_ = KCHRONOLOGY.FixedFromYmd(ymd_[0], ymd_[1], ymd_[2]);
+
+		hms_ = KCHRONOLOGY.TimeFromFixed(utc_rd);
+		fixed_ += KCHRONOLOGY.FixedFromTime(hms_[0], hms_[1], hms_[2], hms_[3]);
+
+		// check if valid date
+		if (!AlmostEqualRelative(fixed_, utc_rd))
+			throw InvalidFieldException("Invalid field or fields");
+
+		auto offset = KTIMEZONE.FixedOffsetFromUtc(fixed_, zone_handle);
+		fixed_ += offset;
+
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
 	}
 
 	//==================================================================
@@ -373,12 +536,6 @@ namespace smalltime
 		ymd_ = KCHRONOLOGY.YmdFromFixed(other.GetFixed());
 		hms_ = KCHRONOLOGY.TimeFromFixed(other.GetFixed());
 
-		// since this should be a valid date we can obtain the other data
-		ywd_ = KCHRONOLOGY.YwdFromFixed(fixed_);
-		leap_year_ = KCHRONOLOGY.IsLeapYear(ymd_[0]);
-		week_of_month_ = KCHRONOLOGY.WeekOfMonth(ymd_, fixed_);
-		auto yd = KCHRONOLOGY.YdFromFixed(fixed_);
-		day_of_year_ = yd[1];
 	}
 
 	//=============================================================
@@ -396,12 +553,22 @@ namespace smalltime
 		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
 		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
 
-		// since this should be a valid date we can obtain the other data
-		ywd_ = KCHRONOLOGY.YwdFromFixed(fixed_);
-		leap_year_ = KCHRONOLOGY.IsLeapYear(ymd_[0]);
-		week_of_month_ = KCHRONOLOGY.WeekOfMonth(ymd_, fixed_);
-		auto yd = KCHRONOLOGY.YdFromFixed(fixed_);
-		day_of_year_ = yd[1];
+	}
+
+	//===============================================
+	// create from a DateTime in a resolved time zone
+	//===============================================
+	template <typename U>
+	LocalDateTime<chrono::IsoChronology>::LocalDateTime(const DateTime<U>& other, const tz::ZoneHandle& zone_handle)
+	{
+		// We know the other DateTime must be valid if it didn't throw an exception,
+		// no reason to check if fields are valid
+		fixed_ = other.GetFixed();
+		auto offset = KTIMEZONE.FixedOffsetFromUtc(fixed_, zone_handle);
+		fixed_ += offset;
+
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
 
 	}
 
@@ -418,12 +585,87 @@ namespace smalltime
 		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
 		fixed_ += KCHRONOLOGY.FixedFromTime(hms_[0], hms_[1], hms_[2], hms_[3]);
 
-		// since this should be a valid date we can obtain the other data
-		ywd_ = KCHRONOLOGY.YwdFromFixed(fixed_);
-		leap_year_ = KCHRONOLOGY.IsLeapYear(ymd_[0]);
-		week_of_month_ = KCHRONOLOGY.WeekOfMonth(ymd_, fixed_);
-		auto yd = KCHRONOLOGY.YdFromFixed(fixed_);
-		day_of_year_ = yd[1];
+	}
+
+	//================================================
+	// Ctor - fields of a valid local fixed date
+	//================================================
+	LocalDateTime<chrono::IsoChronology>::LocalDateTime(RD local_rd, Unchecked) noexcept
+	{
+		fixed_ = local_rd;
+		ymd_ = KCHRONOLOGY.YmdFromFixed(fixed_);
+		hms_ = KCHRONOLOGY.TimeFromFixed(fixed_);
+	}
+
+	//================================================
+	// Create date from fields, no throw
+	//================================================
+	Result<LocalDateTime<chrono::IsoChronology>> LocalDateTime<chrono::IsoChronology>::TryCreate(int year, int month, int day, int hour, int minute, int second, int millisecond)
+	{
+		RD local_rd = 0.0;
+		Status status = FixedFromFields(KCHRONOLOGY, year, month, day, hour, minute, second, millisecond, local_rd);
+		if (status != Status::KOk)
+			return status;
+
+		return LocalDateTime(local_rd, Unchecked());
+	}
+
+	//===========================================================
+	// Create date from fixed date interpreted as utc, no throw
+	//===========================================================
+	Result<LocalDateTime<chrono::IsoChronology>> LocalDateTime<chrono::IsoChronology>::TryFrom(RD utc_rd, const std::string& time_zone)
+	{
+		RD fixed = RebuildFixed(KCHRONOLOGY, utc_rd);
+		if (!AlmostEqualRelative(fixed, utc_rd))
+			return Status::KInvalidField;
+
+		auto offset = KTIMEZONE.TryFixedOffsetFromUtc(fixed, time_zone);
+		if (!offset)
+			return offset.GetStatus();
+
+		return LocalDateTime(fixed + offset.GetValue(), Unchecked());
+	}
+
+	//===================================================================================
+	// Create date from fixed date interpreted as utc in a resolved time zone, no throw
+	//===================================================================================
+	Result<LocalDateTime<chrono::IsoChronology>> LocalDateTime<chrono::IsoChronology>::TryFrom(RD utc_rd, const tz::ZoneHandle& zone_handle)
+	{
+		RD fixed = RebuildFixed(KCHRONOLOGY, utc_rd);
+		if (!AlmostEqualRelative(fixed, utc_rd))
+			return Status::KInvalidField;
+
+		auto offset = KTIMEZONE.TryFixedOffsetFromUtc(fixed, zone_handle);
+		if (!offset)
+			return offset.GetStatus();
+
+		return LocalDateTime(fixed + offset.GetValue(), Unchecked());
+	}
+
+	//===================================
+	// Create from a DateTime, no throw
+	//===================================
+	template <typename U>
+	Result<LocalDateTime<chrono::IsoChronology>> LocalDateTime<chrono::IsoChronology>::TryFrom(const DateTime<U>& other, const std::string& time_zone)
+	{
+		auto offset = KTIMEZONE.TryFixedOffsetFromUtc(other.GetFixed(), time_zone);
+		if (!offset)
+			return offset.GetStatus();
+
+		return LocalDateTime(other.GetFixed() + offset.GetValue(), Unchecked());
+	}
+
+	//===========================================================
+	// Create from a DateTime in a resolved time zone, no throw
+	//===========================================================
+	template <typename U>
+	Result<LocalDateTime<chrono::IsoChronology>> LocalDateTime<chrono::IsoChronology>::TryFrom(const DateTime<U>& other, const tz::ZoneHandle& zone_handle)
+	{
+		auto offset = KTIMEZONE.TryFixedOffsetFromUtc(other.GetFixed(), zone_handle);
+		if (!offset)
+			return offset.GetStatus();
+
+		return LocalDateTime(other.GetFixed() + offset.GetValue(), Unchecked());
 	}
 
 	//=============================================
@@ -0,0 +1,117 @@
+#pragma once
+#ifndef _PACKEDDATETIME_
+#define _PACKEDDATETIME_
+
+#include <core_decls.h>
+#include <iso_chronology.h>
+#include <time_math.h>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <type_traits>
+
+namespace smalltime
+{
+	//Forward decl
+	template <typename T>
+	class DateTime;
+
+	//=====================================================================
+	// A utc moment held as whole milliseconds since R.D. 0 in one 64-bit
+	// value, calendar and time fields are decoded on each call. Meant for
+	// storing, sorting and hashing large numbers of timestamps, convert
+	// to DateTime for zone work
+	//=====================================================================
+	template <typename T = chrono::IsoChronology>
+	class PackedDateTime
+	{
+	public:
+		constexpr PackedDateTime() noexcept : ticks_(0) {}
+		constexpr explicit PackedDateTime(RDTicks utc_ticks) noexcept : ticks_(utc_ticks) {}
+
+		template <typename U>
+		PackedDateTime(const DateTime<U>& other) noexcept : ticks_(math::TicksFromFixed(other.GetFixed())) {}
+
+		static PackedDateTime FromFixed(RD utc_rd) noexcept { return PackedDateTime(math::TicksFromFixed(utc_rd)); }
+
+		std::array<int, 3> GetYmd() const;
+		std::array<int, 4> GetHms() const { return math::HmsFromTicks(ticks_); }
+
+		int GetYear() const { return GetYmd()[0]; }
+		int GetMonth() const { return GetYmd()[1]; }
+		int GetDay() const { return GetYmd()[2]; }
+
+		int GetHour() const { return GetHms()[0]; }
+		int GetMinute() const { return GetHms()[1]; }
+		int GetSecond() const { return GetHms()[2]; }
+		int GetMillisecond() const { return GetHms()[3]; }
+
+		RD GetFixed() const { return math::FixedFromTicks(ticks_); }
+		constexpr RDTicks GetTicks() const noexcept { return ticks_; }
+
+		constexpr bool operator==(const PackedDateTime& rhs) const noexcept { return ticks_ == rhs.ticks_; }
+		constexpr bool operator!=(const PackedDateTime& rhs) const noexcept { return ticks_ != rhs.ticks_; }
+		constexpr bool operator<(const PackedDateTime& rhs) const noexcept { return ticks_ < rhs.ticks_; }
+		constexpr bool operator<=(const PackedDateTime& rhs) const noexcept { return ticks_ <= rhs.ticks_; }
+		constexpr bool operator>(const PackedDateTime& rhs) const noexcept { return ticks_ > rhs.ticks_; }
+		constexpr bool operator>=(const PackedDateTime& rhs) const noexcept { return ticks_ >= rhs.ticks_; }
+
+	private:
+		RDTicks ticks_;
+
+		static T KCHRONOLOGY;
+	};
+
+	static_assert(sizeof(PackedDateTime<>) == sizeof(RDTicks), "PackedDateTime must stay one 64-bit value");
+	static_assert(std::is_trivially_copyable<PackedDateTime<>>::value, "PackedDateTime must be trivially copyable");
+
+	//==================================
+	// Init static member
+	//==================================
+	template <typename T>
+	T PackedDateTime<T>::KCHRONOLOGY;
+
+	//=====================================================
+	// Calendar fields, exact integer path for Iso
+	//=====================================================
+	template <typename T>
+	std::array<int, 3> PackedDateTime<T>::GetYmd() const
+	{
+		if constexpr (std::is_same<T, chrono::IsoChronology>::value)
+			return KCHRONOLOGY.YmdFromTicks(ticks_);
+		else
+			return KCHRONOLOGY.YmdFromFixed(math::FixedFromTicks(ticks_));
+	}
+
+	//=============================================
+	// Stream operator overload
+	//==============================================
+	template <typename T>
+	std::ostream& operator<< (std::ostream& stream, const PackedDateTime<T> rhs)
+	{
+		const auto ymd = rhs.GetYmd();
+		const auto hms = rhs.GetHms();
+		return stream << ymd[0] << '/' << ymd[1] << '/' << ymd[2] << 'T' << hms[0] << ':' << hms[1]
+			<< ':' << hms[2] << ':' << hms[3];
+	}
+
+}
+
+namespace std
+{
+	//=====================================================
+	// Hash of the packed value
+	//=====================================================
+	template <typename T>
+	struct hash<smalltime::PackedDateTime<T> >
+	{
+		std::size_t operator()(const smalltime::PackedDateTime<T>& packed) const noexcept
+		{
+			return std::hash<smalltime::RDTicks>()(packed.GetTicks());
+		}
+	};
+}
+
+#endif
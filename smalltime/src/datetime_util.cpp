@@ -12,4 +12,14 @@ namespace smalltime
 
 	}
 
+	//==========================================================
+	// Sets whether the tzdb.bin is memory-mapped, streamed or
+	// the compiled in tables are used
+	//==========================================================
+	void SetTimeZoneLoadMode(tz::LoadMode load_mode)
+	{
+		tz::TimeZoneDB::SetLoadMode(load_mode);
+
+	}
+
 }
\ No newline at end of file
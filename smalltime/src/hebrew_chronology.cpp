@@ -5,6 +5,16 @@
 
 #include <float_util.h>
 
+#include <vector>
+
+// Hebrew years held in the year table, years outside it are computed
+#ifndef SMALLTIME_HEBREW_TABLE_FIRST_YEAR
+#define SMALLTIME_HEBREW_TABLE_FIRST_YEAR 5000
+#endif
+#ifndef SMALLTIME_HEBREW_TABLE_LAST_YEAR
+#define SMALLTIME_HEBREW_TABLE_LAST_YEAR 6500
+#endif
+
 namespace smalltime
 {
 	namespace chrono
@@ -17,6 +27,27 @@ namespace smalltime
 
 		static const RD KHEBREW_EPOCH = -1373427.0;
 
+		static const int KHEBREW_TABLE_FIRST_YEAR = SMALLTIME_HEBREW_TABLE_FIRST_YEAR;
+		static const int KHEBREW_TABLE_LAST_YEAR = SMALLTIME_HEBREW_TABLE_LAST_YEAR;
+
+		// Days from 1 Tishri to the first of each month, by year kind: deficient,
+		// regular and complete common years then leap years. Month 13 of a common
+		// year starts with Nisan
+		static const int KHEBREW_MONTH_START[6][14] = {
+			{ 0, 176, 206, 235, 265, 294, 324, 0, 30, 59, 88, 117, 147, 176 },
+			{ 0, 177, 207, 236, 266, 295, 325, 0, 30, 59, 89, 118, 148, 177 },
+			{ 0, 178, 208, 237, 267, 296, 326, 0, 30, 60, 90, 119, 149, 178 },
+			{ 0, 206, 236, 265, 295, 324, 354, 0, 30, 59, 88, 117, 147, 177 },
+			{ 0, 207, 237, 266, 296, 325, 355, 0, 30, 59, 89, 118, 148, 178 },
+			{ 0, 208, 238, 267, 297, 326, 356, 0, 30, 60, 90, 119, 149, 179 }
+		};
+
+		// Months in the order they fall in the year
+		static const int KHEBREW_MONTH_ORDER[13] = { 7, 8, 9, 10, 11, 12, 13, 1, 2, 3, 4, 5, 6 };
+
+		// First year kind of leap years
+		static const int KHEBREW_LEAP_KIND = 3;
+
 		enum HebrewMonthDays
 		{
 			KHebrewMonth_Nisan = 1,
@@ -38,6 +69,19 @@ namespace smalltime
 		// Calculate the RD format from the year, month, day format
 		//============================================================
 		RD HebrewChronology::FixedFromYmd(int year, int month, int day) const
+		{
+			if (month < KHebrewMonth_Nisan || month > KHebrewMonth_Adarii)
+				return FixedFromMonthDays(year, month, day);
+
+			const HebrewYear hebrew_year = FindHebrewYear(year);
+			return static_cast<RD>(hebrew_year.new_year + KHEBREW_MONTH_START[hebrew_year.kind][month] + day - 1);
+		}
+
+		//============================================================
+		// Calculate the RD format by summing month lengths, used for
+		// months outside the year
+		//============================================================
+		RD HebrewChronology::FixedFromMonthDays(int year, int month, int day) const
 		{
 			RD rd = 0.0;
 			int mon = 0;
@@ -74,28 +118,33 @@ namespace smalltime
 		//=====================================================
 		YMD HebrewChronology::YmdFromFixed(RD rd) const
 		{
-			RD date_only = math::ExtractDate(rd);
-			int count = std::floor(((date_only - KHEBREW_EPOCH) * 98496.0) / 35975351.0) + 1.0;
-
-			int year = count - 1;
-			for (int i = count; date_only >= HebrewNewYear(i); ++i) 
+			const int date_only = static_cast<int>(math::ExtractDate(rd));
+
+			// the estimate is never past the year holding the date
+			int year = static_cast<int>(std::floor(((date_only - KHEBREW_EPOCH) * 98496.0) / 35975351.0));
+			HebrewYear hebrew_year = FindHebrewYear(year);
+			while (date_only < hebrew_year.new_year)
+				hebrew_year = FindHebrewYear(--year);
+			while (date_only >= hebrew_year.new_year + hebrew_year.days)
+				hebrew_year = FindHebrewYear(++year);
+
+			const int* month_start = KHEBREW_MONTH_START[hebrew_year.kind];
+			const bool leap = hebrew_year.kind >= KHEBREW_LEAP_KIND;
+			const int year_day = date_only - hebrew_year.new_year;
+
+			int month = KHebrewMonth_Tishri;
+			for (int i = 1; i < 13; ++i)
 			{
-				++year;
-			}
-
-			int first = (date_only < FixedFromYmd(year, 1, 1)) ? KHebrewMonth_Tishri : KHebrewMonth_Nisan;
+				const int next = KHEBREW_MONTH_ORDER[i];
+				if (next == KHebrewMonth_Adarii && !leap)
+					continue;
+				if (year_day < month_start[next])
+					break;
 
-			int month = first;
-			
-			for (int i = first; date_only > FixedFromYmd(year, i, HebrewMonthDays(i, year)); ++i) 
-			{
-				++month;
+				month = next;
 			}
-			
 
-			int day = 1 + static_cast<int>(date_only) - static_cast<int>(FixedFromYmd(year, month, 1));
-			
-			return{ year, month, day };
+			return{ year, month, year_day - month_start[month] + 1 };
 
 		}
 
@@ -219,14 +268,11 @@ namespace smalltime
 			case KHebrewMonth_Adarii:
 				return 29;
 			case KHebrewMonth_Adar:
-				if (!IsLeapYear(year))
-					return 29;
+				return IsLeapYear(year) ? 30 : 29;
 			case KHebrewMonth_Marheshvan:
-				if (!IsLongMarheshvan(year))
-					return 29;
+				return IsLongMarheshvan(year) ? 30 : 29;
 			case KHebrewMonth_Kislev:
-				if (IsShortKislev(year))
-					return 29;
+				return IsShortKislev(year) ? 29 : 30;
 			default:
 				return 30;
 			}
@@ -246,7 +292,44 @@ namespace smalltime
 		//=============================================
 		RD HebrewChronology::HebrewYearDays(int year) const
 		{
-			return HebrewNewYear(year + 1) - HebrewNewYear(year);
+			return static_cast<RD>(FindHebrewYear(year).days);
+		}
+
+		//=====================================================
+		// Find a hebrew year in the year table, computing it
+		// when outside the table
+		//=====================================================
+		HebrewChronology::HebrewYear HebrewChronology::FindHebrewYear(int year) const
+		{
+			// built once, the chronology has no state so any instance computes the same table
+			static const std::vector<HebrewYear> year_table = []()
+			{
+				HebrewChronology chronology;
+				std::vector<HebrewYear> table;
+				table.reserve(KHEBREW_TABLE_LAST_YEAR - KHEBREW_TABLE_FIRST_YEAR + 1);
+				for (int year = KHEBREW_TABLE_FIRST_YEAR; year <= KHEBREW_TABLE_LAST_YEAR; ++year)
+					table.push_back(chronology.ComputeHebrewYear(year));
+
+				return table;
+			}();
+
+			if (year < KHEBREW_TABLE_FIRST_YEAR || year > KHEBREW_TABLE_LAST_YEAR)
+				return ComputeHebrewYear(year);
+
+			return year_table[year - KHEBREW_TABLE_FIRST_YEAR];
+		}
+
+		//=====================================================
+		// Compute a hebrew year from the molad arithmetic
+		//=====================================================
+		HebrewChronology::HebrewYear HebrewChronology::ComputeHebrewYear(int year) const
+		{
+			const RD new_year = HebrewNewYear(year);
+			const int days = static_cast<int>(HebrewNewYear(year + 1) - new_year);
+			// 353, 354 and 355 days are deficient, regular and complete, leap years add 30
+			const int kind = (IsLeapYear(year) ? KHEBREW_LEAP_KIND : 0) + days % 10 - 3;
+
+			return{ static_cast<int32_t>(new_year), static_cast<int16_t>(days), static_cast<int16_t>(kind) };
 		}
 
 		//============================================
@@ -13,70 +13,6 @@ namespace smalltime
 		using YD = std::array<int, 2>;
 		using HMS = std::array<int, 4>;
 
-		static const RD KJULIAN_EPOCH = -1.0;
-
-		//============================================================
-		// Calculate the RD format from the year, month, day format
-		//============================================================
-		RD JulianChronology::FixedFromYmd(int year, int month, int day) const
-		{
-			RD d_year = static_cast<RD>(year);
-			RD d_month = static_cast<RD>(month);
-			RD d_day = static_cast<RD>(day);
-
-			RD y = 0.0;
-			if (d_year < 0.0)
-				y = d_year + 1.0;
-			else
-				y = d_year;
-
-			RD lp = 0.0;
-			if (month <= 2)
-				lp = 0.0;
-			else if (IsLeapYear(year))
-				lp = -1.0;
-			else
-				lp = -2.0;
-
-			return KJULIAN_EPOCH - 1.0 + 365.0 * (y - 1.0) + std::floor((y - 1.0) / 4.0) +
-				std::floor((1.0 / 12.0) * (367.0 * d_month - 362.0)) + lp + d_day;
-		}
-
-		//=====================================================
-		// Calculate the YMD format from RD format
-		//=====================================================
-		YMD JulianChronology::YmdFromFixed(RD rd) const
-		{
-			RD dt_only = math::ExtractDate(rd);
-
-			RD d_approx = std::floor((1.0 / 1461.0) * (4.0 * (dt_only - KJULIAN_EPOCH) + 1464.0));
-			int  approx = static_cast<int>(d_approx);
-
-			int year = 0, month = 0, day = 0;
-			if (d_approx <= 0.0)
-				year = approx - 1;
-			else
-				year = approx;
-
-			double prior_days = dt_only - FixedFromYmd(year, 1, 1);
-			double correction = 0.0;
-
-			if (dt_only < FixedFromYmd(year, 3, 1))
-				correction = 0.0;
-			else if (IsLeapYear(year))
-				correction = 1.0;
-			else
-				correction = 2.0;
-
-			double d_month = std::floor((1.0 / 367.0) * (12.0 * (prior_days + correction) + 373.0));
-			month = static_cast<int>(d_month);
-
-			double d_day = dt_only - FixedFromYmd(year, month, 1) + 1.0;
-			day = static_cast<int>(d_day);
-
-			return{ year, month, day };
-		}
-
 		//==========================================================
 		// Find the year a given FixedDateTime falls in
 		//==========================================================
@@ -211,14 +147,6 @@ namespace smalltime
 			return relative_rd;
 		}
 
-		//=====================================================
-		// Calculate RD format from time fields
-		//=====================================================
-		RD JulianChronology::FixedFromTime(int hour, int min, int sec, int milli) const
-		{
-			return math::FixedFromTime(hour, min, sec, milli);
-		}
-
 		//====================================================
 		// calculate time fields from RD format
 		//====================================================
@@ -227,24 +155,5 @@ namespace smalltime
 			return math::HmsFromFixed(rd);
 		}
 
-		//=====================================================
-		// Find if the given year is a leap year
-		//=====================================================
-		bool JulianChronology::IsLeapYear(int year) const
-		{
-			if (year > 0)
-			{
-				if (math::FlMod(year, 4.0) == 0.0)
-					return true;
-			}
-			else
-			{
-				if (math::FlMod(year, 4.0) == 3.0)
-					return true;
-			}
-
-			return false;
-		}
-
 	}
 }
\ No newline at end of file
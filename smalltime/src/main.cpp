@@ -1,6 +1,8 @@
 #include <iostream>		
 #include <vector>
 #include <array>
+#include <cstdlib>
+#include <cstring>
 
 #include <util/stl_perf_counter.h>
 
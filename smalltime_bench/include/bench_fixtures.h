@@ -0,0 +1,44 @@
+#pragma once
+#ifndef _BENCH_FIXTURES_
+#define _BENCH_FIXTURES_
+
+#include <core_decls.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace smalltime
+{
+	namespace bench
+	{
+		// Directory holding the tzdb.bin every benchmark runs against
+		extern std::string tzdb_dir;
+
+		//=====================================================================
+		// Zones by how their offsets are found, benchmarks take the index
+		// as argument
+		//=====================================================================
+		struct ZoneClass
+		{
+			const char* label;
+			const char* zone_name;
+		};
+
+		static const std::array<ZoneClass, 6> KZONE_CLASSES = { {
+			{ "fixed", "UTC" },
+			{ "fixed_history", "Asia/Kolkata" },
+			{ "rules_north", "America/New_York" },
+			{ "rules_south", "Australia/Sydney" },
+			{ "rules_south_america", "America/Santiago" },
+			{ "many_history", "Africa/Casablanca" }
+		} };
+
+		// Moments spread over 1900 - 2040, off the hour so few land on a transition
+		std::vector<RD> SampleMoments(std::size_t count);
+		// Years, months and days spread over 1900 - 2040
+		std::vector<std::array<int, 3> > SampleYmds(std::size_t count);
+	}
+}
+
+#endif
@@ -0,0 +1,233 @@
+#include "../include/bench_fixtures.h"
+
+#include <iso_chronology.h>
+#include <iso_chronology_batch.h>
+#include <cpu_features.h>
+#include <datetime.h>
+#include <local_datetime.h>
+#include <packed_datetime.h>
+#include <julian_chronology.h>
+#include <islamic_chronology.h>
+#include <hebrew_chronology.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace smalltime;
+
+namespace
+{
+	static const std::size_t KSAMPLE_COUNT = 4096;
+
+	//=====================================================================
+	// Calendar fields of a moment
+	//=====================================================================
+	template <typename T>
+	void BM_YmdFromFixed(benchmark::State& state)
+	{
+		const auto moments = bench::SampleMoments(KSAMPLE_COUNT);
+		T chronology;
+
+		std::size_t i = 0;
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(chronology.YmdFromFixed(moments[i]));
+			i = (i + 1) % KSAMPLE_COUNT;
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	//=====================================================================
+	// Moment of calendar fields
+	//=====================================================================
+	template <typename T>
+	void BM_FixedFromYmd(benchmark::State& state)
+	{
+		const auto ymds = bench::SampleYmds(KSAMPLE_COUNT);
+		T chronology;
+
+		std::size_t i = 0;
+		for (auto _ : state)
+		{
+			const auto& ymd = ymds[i];
+			benchmark::DoNotOptimize(chronology.FixedFromYmd(ymd[0], ymd[1], ymd[2]));
+			i = (i + 1) % KSAMPLE_COUNT;
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	//=====================================================================
+	// DateTime from fields, converts through the zone to utc
+	//=====================================================================
+	template <typename T>
+	void BM_DateTimeCtor(benchmark::State& state)
+	{
+		const auto ymds = bench::SampleYmds(KSAMPLE_COUNT);
+		const std::string zone_name = "America/New_York";
+
+		std::size_t i = 0;
+		for (auto _ : state)
+		{
+			const auto& ymd = ymds[i];
+			DateTime<T> dt(ymd[0], ymd[1], ymd[2], 12, 30, 0, 0, zone_name);
+			benchmark::DoNotOptimize(dt.GetFixed());
+			i = (i + 1) % KSAMPLE_COUNT;
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	//=====================================================================
+	// DateTime from fields through a resolved zone handle
+	//=====================================================================
+	template <typename T>
+	void BM_DateTimeCtorHandle(benchmark::State& state)
+	{
+		const auto ymds = bench::SampleYmds(KSAMPLE_COUNT);
+		const tz::ZoneHandle zone_handle("America/New_York");
+
+		std::size_t i = 0;
+		for (auto _ : state)
+		{
+			const auto& ymd = ymds[i];
+			DateTime<T> dt(ymd[0], ymd[1], ymd[2], 12, 30, 0, 0, zone_handle);
+			benchmark::DoNotOptimize(dt.GetFixed());
+			i = (i + 1) % KSAMPLE_COUNT;
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	//=====================================================================
+	// LocalDateTime from fields, no zone involved
+	//=====================================================================
+	template <typename T>
+	void BM_LocalDateTimeCtor(benchmark::State& state)
+	{
+		const auto ymds = bench::SampleYmds(KSAMPLE_COUNT);
+
+		std::size_t i = 0;
+		for (auto _ : state)
+		{
+			const auto& ymd = ymds[i];
+			LocalDateTime<T> dt(ymd[0], ymd[1], ymd[2], 12, 30, 0, 0);
+			benchmark::DoNotOptimize(dt.GetFixed());
+			i = (i + 1) % KSAMPLE_COUNT;
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	//=====================================================================
+	// LocalDateTime of a utc moment in a zone
+	//=====================================================================
+	template <typename T>
+	void BM_LocalDateTimeFromUtc(benchmark::State& state)
+	{
+		const auto moments = bench::SampleMoments(KSAMPLE_COUNT);
+		const std::string zone_name = "America/New_York";
+
+		std::size_t i = 0;
+		for (auto _ : state)
+		{
+			LocalDateTime<T> dt(moments[i], zone_name);
+			benchmark::DoNotOptimize(dt.GetFixed());
+			i = (i + 1) % KSAMPLE_COUNT;
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	//=====================================================================
+	// Calendar fields decoded from a packed utc moment
+	//=====================================================================
+	template <typename T>
+	void BM_PackedDateTimeYmd(benchmark::State& state)
+	{
+		const auto moments = bench::SampleMoments(KSAMPLE_COUNT);
+		std::vector<PackedDateTime<T> > packed;
+		for (const auto moment : moments)
+			packed.push_back(PackedDateTime<T>::FromFixed(moment));
+
+		std::size_t i = 0;
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(packed[i].GetYmd());
+			i = (i + 1) % KSAMPLE_COUNT;
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	using YmdKernel = void(*)(const RD*, int32_t*, int32_t*, int32_t*, std::size_t);
+
+	//=====================================================================
+	// Iso calendar fields of a whole array, one call per value
+	//=====================================================================
+	void BM_IsoYmdFromFixedLoop(benchmark::State& state)
+	{
+		const auto moments = bench::SampleMoments(KSAMPLE_COUNT);
+		std::vector<int32_t> years(KSAMPLE_COUNT), months(KSAMPLE_COUNT), days(KSAMPLE_COUNT);
+		chrono::IsoChronology iso;
+
+		for (auto _ : state)
+		{
+			for (std::size_t i = 0; i < KSAMPLE_COUNT; ++i)
+			{
+				auto ymd = iso.YmdFromFixed(moments[i]);
+				years[i] = ymd[0];
+				months[i] = ymd[1];
+				days[i] = ymd[2];
+			}
+			benchmark::DoNotOptimize(days.data());
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * KSAMPLE_COUNT);
+	}
+
+	//=====================================================================
+	// Iso calendar fields of a whole array through one batch kernel,
+	// skipped when the cpu lacks the instructions
+	//=====================================================================
+	void BM_IsoYmdFromFixedBatch(benchmark::State& state, YmdKernel kernel, bool (*supported)())
+	{
+		if (supported && !supported())
+		{
+			state.SkipWithError("instructions not supported by this cpu");
+			return;
+		}
+
+		const auto moments = bench::SampleMoments(KSAMPLE_COUNT);
+		std::vector<int32_t> years(KSAMPLE_COUNT), months(KSAMPLE_COUNT), days(KSAMPLE_COUNT);
+
+		for (auto _ : state)
+		{
+			kernel(moments.data(), years.data(), months.data(), days.data(), KSAMPLE_COUNT);
+			benchmark::DoNotOptimize(days.data());
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * KSAMPLE_COUNT);
+	}
+}
+
+#define SMALLTIME_BENCH_CHRONOLOGIES(bench_fn) \
+	BENCHMARK_TEMPLATE(bench_fn, chrono::IsoChronology); \
+	BENCHMARK_TEMPLATE(bench_fn, chrono::JulianChronology); \
+	BENCHMARK_TEMPLATE(bench_fn, chrono::IslamicChronology); \
+	BENCHMARK_TEMPLATE(bench_fn, chrono::HebrewChronology)
+
+SMALLTIME_BENCH_CHRONOLOGIES(BM_YmdFromFixed);
+SMALLTIME_BENCH_CHRONOLOGIES(BM_FixedFromYmd);
+SMALLTIME_BENCH_CHRONOLOGIES(BM_DateTimeCtor);
+SMALLTIME_BENCH_CHRONOLOGIES(BM_DateTimeCtorHandle);
+SMALLTIME_BENCH_CHRONOLOGIES(BM_LocalDateTimeCtor);
+SMALLTIME_BENCH_CHRONOLOGIES(BM_LocalDateTimeFromUtc);
+SMALLTIME_BENCH_CHRONOLOGIES(BM_PackedDateTimeYmd);
+
+BENCHMARK(BM_IsoYmdFromFixedLoop);
+BENCHMARK_CAPTURE(BM_IsoYmdFromFixedBatch, scalar, chrono::batch::YmdFromFixedScalar, nullptr);
+BENCHMARK_CAPTURE(BM_IsoYmdFromFixedBatch, sse41, chrono::batch::YmdFromFixedSse41, cpu::HasSse41);
+BENCHMARK_CAPTURE(BM_IsoYmdFromFixedBatch, avx2, chrono::batch::YmdFromFixedAvx2, cpu::HasAvx2);
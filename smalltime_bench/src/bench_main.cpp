@@ -0,0 +1,96 @@
+#include "../include/bench_fixtures.h"
+
+#include <iso_chronology.h>
+#include <time_math.h>
+#include <timezone_db.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace smalltime
+{
+	namespace bench
+	{
+		std::string tzdb_dir = SMALLTIME_BENCH_TZDB_DIR;
+
+		//==================================================
+		// Moments spread over 1900 - 2040
+		//==================================================
+		std::vector<RD> SampleMoments(std::size_t count)
+		{
+			chrono::IsoChronology iso;
+			const RD first = iso.FixedFromYmd(1900, 1, 1);
+			const RD last = iso.FixedFromYmd(2040, 1, 1);
+			// whole days so every moment is a valid wall time
+			const RD step = std::floor((last - first) / count);
+
+			std::vector<RD> moments(count);
+			for (std::size_t i = 0; i < count; ++i)
+				moments[i] = first + i * step + math::FixedFromTime(static_cast<int>(i % 24), 17, 0, 0);
+
+			return moments;
+		}
+
+		//==================================================
+		// Years, months and days spread over 1900 - 2040
+		//==================================================
+		std::vector<std::array<int, 3> > SampleYmds(std::size_t count)
+		{
+			std::vector<std::array<int, 3> > ymds(count);
+			for (std::size_t i = 0; i < count; ++i)
+				ymds[i] = { 1900 + static_cast<int>(i % 140), 1 + static_cast<int>(i % 12), 1 + static_cast<int>(i % 28) };
+
+			return ymds;
+		}
+	}
+}
+
+//=====================================================================
+// Google Benchmark main that writes JSON results unless told otherwise,
+// --tzdb_dir=<dir/> picks the tzdb.bin to run against
+//=====================================================================
+int main(int argc, char** argv)
+{
+	static const char* const KTZDB_DIR_FLAG = "--tzdb_dir=";
+
+	std::vector<char*> args;
+	bool has_out = false;
+	for (int i = 0; i < argc; ++i)
+	{
+		if (std::strncmp(argv[i], KTZDB_DIR_FLAG, std::strlen(KTZDB_DIR_FLAG)) == 0)
+		{
+			smalltime::bench::tzdb_dir = argv[i] + std::strlen(KTZDB_DIR_FLAG);
+			continue;
+		}
+
+		if (std::strncmp(argv[i], "--benchmark_out=", 16) == 0)
+			has_out = true;
+
+		args.push_back(argv[i]);
+	}
+
+	// results are kept release to release, so write them by default
+	std::string default_out = "--benchmark_out=smalltime_bench.json";
+	std::string default_format = "--benchmark_out_format=json";
+	if (!has_out)
+	{
+		args.push_back(&default_out[0]);
+		args.push_back(&default_format[0]);
+	}
+
+	smalltime::tz::TimeZoneDB::SetPath(smalltime::bench::tzdb_dir);
+
+	int arg_count = static_cast<int>(args.size());
+	benchmark::Initialize(&arg_count, args.data());
+	if (benchmark::ReportUnrecognizedArguments(arg_count, args.data()))
+		return 1;
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
@@ -0,0 +1,188 @@
+#include "../include/bench_fixtures.h"
+
+#include <timezone.h>
+#include <iso_chronology.h>
+#include <zone_handle.h>
+#include <smalltime_exceptions.h>
+
+#if defined(SMALLTIME_EMBEDDED_TZDB)
+#include <tzdb_literals.h>
+#include <embedded_timezone.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+using namespace smalltime;
+
+namespace
+{
+	static const std::size_t KMOMENT_COUNT = 4096;
+
+	//=====================================================================
+	// Offsets from utc looked up by zone name
+	//=====================================================================
+	void BM_FixedOffsetFromUtc(benchmark::State& state)
+	{
+		const auto& zone_class = bench::KZONE_CLASSES[state.range(0)];
+		const std::string zone_name = zone_class.zone_name;
+		const auto moments = bench::SampleMoments(KMOMENT_COUNT);
+		tz::TimeZone time_zone;
+
+		std::size_t i = 0;
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(time_zone.FixedOffsetFromUtc(moments[i], zone_name));
+			i = (i + 1) % KMOMENT_COUNT;
+		}
+
+		state.SetLabel(zone_class.label);
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	//=====================================================================
+	// Offsets from local time looked up by zone name
+	//=====================================================================
+	void BM_FixedOffsetFromLocal(benchmark::State& state)
+	{
+		const auto& zone_class = bench::KZONE_CLASSES[state.range(0)];
+		const std::string zone_name = zone_class.zone_name;
+		const auto moments = bench::SampleMoments(KMOMENT_COUNT);
+		tz::TimeZone time_zone;
+
+		std::size_t i = 0;
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(time_zone.FixedOffsetFromLocal(moments[i], zone_name, Choose::KEarliest));
+			i = (i + 1) % KMOMENT_COUNT;
+		}
+
+		state.SetLabel(zone_class.label);
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	//=====================================================================
+	// Offsets from utc through a resolved zone handle
+	//=====================================================================
+	void BM_FixedOffsetFromUtcHandle(benchmark::State& state)
+	{
+		const auto& zone_class = bench::KZONE_CLASSES[state.range(0)];
+		const tz::ZoneHandle zone_handle(zone_class.zone_name);
+		const auto moments = bench::SampleMoments(KMOMENT_COUNT);
+		tz::TimeZone time_zone;
+
+		std::size_t i = 0;
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(time_zone.FixedOffsetFromUtc(moments[i], zone_handle));
+			i = (i + 1) % KMOMENT_COUNT;
+		}
+
+		state.SetLabel(zone_class.label);
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	//=====================================================================
+	// Offsets from local time through a resolved zone handle
+	//=====================================================================
+	void BM_FixedOffsetFromLocalHandle(benchmark::State& state)
+	{
+		const auto& zone_class = bench::KZONE_CLASSES[state.range(0)];
+		const tz::ZoneHandle zone_handle(zone_class.zone_name);
+		const auto moments = bench::SampleMoments(KMOMENT_COUNT);
+		tz::TimeZone time_zone;
+
+		std::size_t i = 0;
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(time_zone.FixedOffsetFromLocal(moments[i], zone_handle, Choose::KEarliest));
+			i = (i + 1) % KMOMENT_COUNT;
+		}
+
+		state.SetLabel(zone_class.label);
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	//=====================================================================
+	// Resolving a zone handle by name
+	//=====================================================================
+	void BM_ZoneHandleCtor(benchmark::State& state)
+	{
+		const std::string zone_name = "America/New_York";
+
+		for (auto _ : state)
+		{
+			tz::ZoneHandle zone_handle(zone_name);
+			benchmark::DoNotOptimize(zone_handle.GetZones());
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+#if defined(SMALLTIME_EMBEDDED_TZDB)
+	//=====================================================================
+	// Resolving a zone handle from a compile time zone literal
+	//=====================================================================
+	void BM_ZoneHandleCtorLiteral(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			tz::ZoneHandle zone_handle(SMALLTIME_ZONE("America/New_York"));
+			benchmark::DoNotOptimize(zone_handle.GetZones());
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+#endif
+
+	//=====================================================================
+	// Utc ticks of a local market open through a resolved zone handle
+	//=====================================================================
+	void BM_MarketOpenUtc(benchmark::State& state)
+	{
+		const tz::ZoneHandle zone_handle("America/New_York");
+		const chrono::IsoChronology iso;
+		const RDTicks local_ticks = iso.TicksFromYmd(2024, 3, 11) + iso.TicksFromTime(9, 30, 0, 0);
+		tz::TimeZone time_zone;
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(local_ticks - time_zone.TicksOffsetFromLocal(local_ticks, zone_handle, Choose::KError));
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+#if defined(SMALLTIME_EMBEDDED_TZDB)
+	//=====================================================================
+	// Utc ticks of a local market open folded at compile time
+	//=====================================================================
+	void BM_MarketOpenUtcLiteral(benchmark::State& state)
+	{
+		static constexpr RDTicks KMARKET_OPEN = tz::UtcTicksFromLocal(SMALLTIME_ZONE("America/New_York"), 2024, 3, 11, 9, 30, 0, 0, Choose::KError);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(KMARKET_OPEN);
+
+		state.SetItemsProcessed(state.iterations());
+	}
+#endif
+
+	//=====================================================================
+	// One argument per zone class
+	//=====================================================================
+	void ZoneClassArgs(benchmark::internal::Benchmark* benchmark)
+	{
+		for (int i = 0; i < static_cast<int>(bench::KZONE_CLASSES.size()); ++i)
+			benchmark->Arg(i);
+	}
+}
+
+BENCHMARK(BM_FixedOffsetFromUtc)->Apply(ZoneClassArgs);
+BENCHMARK(BM_FixedOffsetFromLocal)->Apply(ZoneClassArgs);
+BENCHMARK(BM_FixedOffsetFromUtcHandle)->Apply(ZoneClassArgs);
+BENCHMARK(BM_FixedOffsetFromLocalHandle)->Apply(ZoneClassArgs);
+BENCHMARK(BM_ZoneHandleCtor);
+BENCHMARK(BM_MarketOpenUtc);
+
+#if defined(SMALLTIME_EMBEDDED_TZDB)
+BENCHMARK(BM_ZoneHandleCtorLiteral);
+BENCHMARK(BM_MarketOpenUtcLiteral);
+#endif
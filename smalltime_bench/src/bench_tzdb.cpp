@@ -0,0 +1,46 @@
+#include "../include/bench_fixtures.h"
+
+#include <timezone_db.h>
+#include <tzdb_snapshot.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace smalltime;
+
+namespace
+{
+	static const char* const KLOAD_MODE_LABELS[] = { "stream", "mapped", "embedded" };
+
+	//=====================================================================
+	// Cold TimeZoneDB::Init, SetPath drops the loaded tzdb so each
+	// iteration loads the file or wraps the embedded tables again
+	//=====================================================================
+	void BM_TimeZoneDBInit(benchmark::State& state)
+	{
+		const auto default_load_mode = tz::TimeZoneDB::GetLoadMode();
+		const auto load_mode = static_cast<tz::LoadMode>(state.range(0));
+		state.SetLabel(KLOAD_MODE_LABELS[state.range(0)]);
+
+#if !defined(SMALLTIME_EMBEDDED_TZDB)
+		if (load_mode == tz::LoadMode::KEmbedded)
+		{
+			state.SkipWithError("built without SMALLTIME_EMBEDDED_TZDB");
+			return;
+		}
+#endif
+
+		tz::TimeZoneDB::SetLoadMode(load_mode);
+
+		for (auto _ : state)
+		{
+			tz::TimeZoneDB::SetPath(bench::tzdb_dir);
+			tz::TimeZoneDB::Init();
+		}
+
+		// later benchmarks run on the load mode of the build
+		tz::TimeZoneDB::SetLoadMode(default_load_mode);
+		tz::TimeZoneDB::Init();
+	}
+}
+
+BENCHMARK(BM_TimeZoneDBInit)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMicrosecond);
@@ -22,7 +22,10 @@ namespace smalltime
 			bool ProcessLinks(std::vector<tz::Link>& vec_link, const std::vector<LinkData>& vec_linkdata);
 
 			bool ProcessZoneLookup(std::vector<tz::Zones>& vec_zone_lookup, const std::vector<tz::Zone>& vec_zone, const std::vector<tz::Link>& vec_link);
-			bool ProcessRuleLookup(std::vector<tz::Rules>& vec_rule_lookup, const std::vector<tz::Rule>& vec_rule);
+			bool ProcessRuleLookup(std::vector<tz::Rules>& vec_rule_lookup, std::vector<tz::RuleYearRange>& vec_year_range,
+				std::vector<tz::RuleYearRanges>& vec_year_range_lookup, std::vector<tz::Rule>& vec_rule);
+			bool ProcessZoneIndex(std::vector<uint32_t>& vec_displacement, std::vector<tz::ZoneIndexSlot>& vec_slot, std::vector<char>& vec_name,
+				const std::vector<tz::Zones>& vec_zone_lookup, const std::vector<ZoneData>& vec_zonedata, const std::vector<LinkData>& vec_linkdata);
 			bool ProcessMeta(MetaData& tzdb_meta, const std::vector<tz::Zone>& vec_zone, const std::vector<tz::Rule>& vec_rule,
 				const std::vector<tz::Zones>& vec_zone_lookup, const std::vector<tz::Rules>& vec_rule_lookup);
 
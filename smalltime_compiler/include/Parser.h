@@ -5,7 +5,11 @@
 #include <core_decls.h>
 #include "comp_decls.h"
 
+#include <cstddef>
 #include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace smalltime
 {
@@ -18,6 +22,15 @@ namespace smalltime
 			bool ParseZones(std::vector<ZoneData>& vec_zonedata, std::ifstream& src);
 			bool ParseLinks(std::vector<LinkData>& vec_linkdata, std::ifstream& src);
 
+			// Parse every source in one pass each, sources are read concurrently and
+			// results are appended in source order. failed_source names the first
+			// source that could not be read
+			bool ParseSources(const std::vector<std::string>& sources, std::vector<ZoneData>& vec_zonedata, std::vector<RuleData>& vec_ruledata,
+				std::vector<LinkData>& vec_linkdata, std::string& failed_source);
+			// Parse one source already in memory in a single pass
+			bool ParseBuffer(const char* data, std::size_t size, std::vector<ZoneData>& vec_zonedata, std::vector<RuleData>& vec_ruledata,
+				std::vector<LinkData>& vec_linkdata);
+
 		private:
 			enum class LineType : char
 			{
@@ -28,12 +41,13 @@ namespace smalltime
 				KComment
 			};
 
-			bool ExtractRule(std::vector<RuleData>& vec_ruledata, const std::string& line_str);
-			bool ExtractZone(std::vector<ZoneData>& vec_zonedata, const std::string& line_str);
-			bool ExtractLink(std::vector<LinkData>& vec_linkdata, const std::string& line_str);
+			bool ExtractRule(std::vector<RuleData>& vec_ruledata, std::string_view line_str);
+			// cur_zone_name carries the zone of a head line over to its body lines
+			bool ExtractZone(std::vector<ZoneData>& vec_zonedata, std::string_view line_str, LineType line_type, std::string& cur_zone_name);
+			bool ExtractLink(std::vector<LinkData>& vec_linkdata, std::string_view line_str);
 
-			LineType GetLineType(const std::string& line_str);
-			std::string FormatZoneLine(const std::string line_str);
+			LineType GetLineType(std::string_view line_str);
+			std::string_view FormatZoneLine(std::string_view line_str);
 
 		};
 	}
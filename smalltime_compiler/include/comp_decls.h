@@ -54,6 +54,9 @@ namespace smalltime
 			RD max_rule_offset;
 			int max_zone_size;
 			int max_rule_size;
+			int max_year_rule_size;
+			// last year the utc transitions are precompiled for
+			int transition_horizon;
 		};
 
 	}
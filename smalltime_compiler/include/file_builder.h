@@ -4,6 +4,7 @@
 
 #include <core_decls.h>
 #include <tz_decls.h>
+#include <tzdb_file.h>
 #include "comp_decls.h"
 
 #include <vector>
@@ -17,15 +18,16 @@ namespace smalltime
 		{
 		public:
 
+			// Version 2, aligned sections readable in place
 			bool Build(std::vector<tz::Rule>& vec_rule, std::vector<tz::Zone>& vec_zone, std::vector<tz::Zones>& vec_zone_lookup,
-				std::vector<tz::Rules>& vec_rule_lookup, std::ofstream& out_file);
+				std::vector<tz::Rules>& vec_rule_lookup, std::vector<tz::UtcTransition>& vec_transition, std::vector<tz::UtcTransitions>& vec_transition_lookup,
+				std::vector<uint64_t>& vec_abbrev, std::vector<uint32_t>& vec_displacement, std::vector<tz::ZoneIndexSlot>& vec_slot,
+				std::vector<char>& vec_name, std::vector<tz::RuleYearRange>& vec_year_range, std::vector<tz::RuleYearRanges>& vec_year_range_lookup,
+				const MetaData& tzdb_meta, std::ofstream& out_file);
 
 		private:
-			bool InsertRule(tz::Rule& rule, std::ofstream& out_file);
-			bool InsertZone(tz::Zone& zone, std::ofstream& out_file);
-
-			bool InsertRuleSearch(tz::Rules& rules, std::ofstream& out_file);
-			bool InsertZoneSearch(tz::Zones& zones, std::ofstream& out_file);
+			template <typename T>
+			void AppendSection(std::vector<char>& image, tz::TzdbHeader& header, tz::TzdbSectionType section_type, const std::vector<T>& vec_record);
 
 		};
 	}
@@ -0,0 +1,86 @@
+#pragma once
+#ifndef _SOURCE_CACHE_
+#define _SOURCE_CACHE_
+
+#include <core_decls.h>
+#include <tz_decls.h>
+#include <tzdb_connector_interface.h>
+#include "comp_decls.h"
+#include "Parser.h"
+#include "Generator.h"
+#include "zone_post_generator.h"
+
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace smalltime
+{
+	namespace comp
+	{
+		// Bump whenever parsing, generation or the entry layout changes so old entries are ignored
+		static const uint32_t KSOURCE_CACHE_VERSION = 1;
+
+		//=====================================================================
+		// Parsed and generated data of each source file, kept on disk keyed
+		// by a hash of the file contents. A source that did not change is
+		// loaded instead of parsed and generated, and its post processed
+		// zones are reused as long as the rules they use did not change
+		//=====================================================================
+		class SourceCache
+		{
+		public:
+			explicit SourceCache(std::string cache_dir);
+
+			// Load each source from the cache or parse and generate it, results are appended in source order
+			bool LoadSources(const std::vector<std::string>& sources, Parser& parser, Generator& generator, std::vector<ZoneData>& vec_zonedata,
+				std::vector<RuleData>& vec_ruledata, std::vector<LinkData>& vec_linkdata, std::vector<tz::Zone>& vec_zone, std::vector<tz::Rule>& vec_rule,
+				std::string& failed_source);
+
+			// Post process the zones of sources whose rules changed and reuse the rest, zones after the
+			// last source are always processed
+			bool PostProcessZones(ZonePostGenerator& zone_post_generator, std::shared_ptr<tz::TzdbConnectorInterface> tzdb_connector,
+				std::vector<tz::Zone>& vec_zone);
+
+			// Write entries that were created or changed, false if any could not be written
+			bool StoreSources();
+
+			int GetSourceCount() const { return static_cast<int>(entries_.size()); }
+			int GetLoadedCount() const { return loaded_count_; }
+			int GetPostReusedCount() const { return post_reused_count_; }
+
+		private:
+			struct SourceEntry
+			{
+				uint64_t content_hash[2];
+				uint64_t rule_hash[2];
+
+				std::vector<ZoneData> zonedata;
+				std::vector<RuleData> ruledata;
+				std::vector<LinkData> linkdata;
+
+				// as generated and after post processing
+				std::vector<tz::Zone> zones;
+				std::vector<tz::Zone> post_zones;
+				std::vector<tz::Rule> rules;
+
+				int zone_first;
+				bool dirty;
+			};
+
+			std::string GetEntryPath(const SourceEntry& entry) const;
+			bool ReadEntry(SourceEntry& entry) const;
+			bool WriteEntry(const SourceEntry& entry) const;
+
+			void HashRules(const SourceEntry& entry, tz::TzdbConnectorInterface& tzdb_connector, uint64_t (&rule_hash)[2]) const;
+
+			std::string cache_dir_;
+			std::vector<SourceEntry> entries_;
+			int loaded_count_;
+			int post_reused_count_;
+		};
+	}
+}
+
+#endif
@@ -21,6 +21,12 @@ namespace smalltime
 
 			bool BuildBody(const std::vector<tz::Rule>& vec_rule, const std::vector<tz::Zone>& vec_zone, const std::vector<tz::Zones>& vec_zone_lookup,
 				const std::vector<tz::Rules>& vec_rule_lookup, const MetaData& tzdb_meta, std::ofstream& out_file);
+			bool BuildTransitions(const std::vector<tz::UtcTransition>& vec_transition, const std::vector<tz::UtcTransitions>& vec_transition_lookup,
+				const std::vector<uint64_t>& vec_abbrev, std::ofstream& out_file);
+			bool BuildZoneIndex(const std::vector<uint32_t>& vec_displacement, const std::vector<tz::ZoneIndexSlot>& vec_slot,
+				const std::vector<char>& vec_name, std::ofstream& out_file);
+			bool BuildRuleYearRanges(const std::vector<tz::RuleYearRange>& vec_year_range, const std::vector<tz::RuleYearRanges>& vec_year_range_lookup,
+				std::ofstream& out_file);
 
 		private:
 			bool InsertRule(const tz::Rule& rule, std::ofstream& out_file);
@@ -29,6 +35,9 @@ namespace smalltime
 			bool InsertRuleSearch(const tz::Rules& rules, std::ofstream& out_file);
 			bool InsertZoneSearch(const tz::Zones& zones, std::ofstream& out_file);
 
+			bool InsertUtcTransition(const tz::UtcTransition& utc_transition, std::ofstream& out_file);
+			bool InsertUtcTransitionSearch(const tz::UtcTransitions& utc_transitions, std::ofstream& out_file);
+
 		};
 	}
 }
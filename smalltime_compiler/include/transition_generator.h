@@ -0,0 +1,71 @@
+#pragma once
+#ifndef _TRANSITION_GENERATOR_
+#define _TRANSITION_GENERATOR_
+
+#include <memory>
+#include <vector>
+#include <map>
+
+#include <core_decls.h>
+#include <tz_decls.h>
+#include <tzdb_connector_interface.h>
+#include <basic_datetime.h>
+#include "comp_decls.h"
+
+namespace smalltime
+{
+	namespace comp
+	{
+		// Transitions are precompiled up to the end of this year by default
+		static const int KTRANSITION_HORIZON = 2037;
+		// Transitions are checked against the zone rules from this year on
+		static const int KTRANSITION_VERIFY_FIRST_YEAR = 1800;
+		// Horizons a tzdb can be compiled with, the tail of the last one
+		// still has to fall before tz::DMAX
+		static const int KTRANSITION_HORIZON_MIN = KTRANSITION_VERIFY_FIRST_YEAR;
+		static const int KTRANSITION_HORIZON_MAX = tz::MAX - 2;
+
+		class TransitionGenerator
+		{
+		public:
+			TransitionGenerator(std::shared_ptr<tz::TzdbConnectorInterface> tzdb_connector);
+
+			// Expand post-processed zones into sorted utc transitions, fails
+			// when the transitions disagree with the zone rules at a sample
+			bool ProcessTransitions(std::vector<tz::UtcTransition>& vec_transition, std::vector<tz::UtcTransitions>& vec_transition_lookup, std::vector<uint64_t>& vec_abbrev,
+				const std::vector<tz::Zone>& vec_zone, const std::vector<tz::Zones>& vec_zone_lookup, const std::vector<ZoneData>& vec_zonedata,
+				const std::vector<RuleData>& vec_ruledata, int horizon_year);
+
+		private:
+			struct UtcOffset
+			{
+				RD offset;
+				uint32_t abbrev_index;
+			};
+
+			void ProcessZoneGroup(std::vector<tz::UtcTransition>& vec_transition, tz::Zones zones, RD tail_utc);
+			void AddCandidates(std::vector<RD>& candidates, const tz::Zone& zone, int first_year, int last_year);
+			bool VerifyZoneGroup(const std::vector<tz::UtcTransition>& vec_transition, const tz::UtcTransitions& utc_transitions, tz::Zones zones);
+
+			bool FindUtcOffset(RD rd, tz::Zones zones, UtcOffset& utc_offset);
+			RD FindTailUtc(tz::Zones zones);
+
+			uint32_t GetAbbrevIndex(const tz::Zone* zone, const tz::Rule* rule);
+			BasicDateTime<> CalcTransitionFast(const tz::Rule& rule, int year);
+
+			std::shared_ptr<tz::TzdbConnectorInterface> tzdb_connector_;
+
+			const std::vector<ZoneData>* vec_zonedata_;
+			const std::vector<RuleData>* vec_ruledata_;
+			std::vector<uint64_t>* vec_abbrev_;
+			std::map<std::string, uint32_t> abbrev_index_;
+
+			int horizon_year_;
+			RD horizon_utc_;
+
+		};
+
+	}
+}
+
+#endif
@@ -20,6 +20,8 @@ namespace smalltime
 			ZonePostGenerator(std::shared_ptr<tz::TzdbConnectorInterface> tzdb_connector);
 
 			bool ProcessZones(std::vector<tz::Zone>& vec_zone);
+			// Only the zones in [first, first + size), the range must hold whole zone groups
+			bool ProcessZones(std::vector<tz::Zone>& vec_zone, int first, int size);
 
 		//private:
 			tz::ZoneTransition CalcZoneData(int cur_zone_index, std::vector<tz::Zone>& vec_zone);
@@ -1,4 +1,4 @@
-#include "../include/generator.h"
+#include "../include/Generator.h"
 #include <basic_datetime.h>
 #include <core_math.h>
 #include <time_math.h>
@@ -7,6 +7,10 @@
 #include <iomanip>
 #include <iostream>
 #include <rule_group.h>
+#include <zone_index.h>
+#include <algorithm>
+#include <map>
+#include <set>
 
 namespace smalltime
 {
@@ -197,13 +201,22 @@ namespace smalltime
 		}
 
 		//====================================================================
-		// Process lookup vector from rule data
+		// Process lookup vector from rule data, with the merged active
+		// years of each rule set in the same order. Rules are grouped by
+		// name first, sources may interleave the lines of two rule sets
 		//====================================================================
-		bool Generator::ProcessRuleLookup(std::vector<tz::Rules>& vec_rule_lookup, const std::vector<tz::Rule>& vec_rule)
+		bool Generator::ProcessRuleLookup(std::vector<tz::Rules>& vec_rule_lookup, std::vector<tz::RuleYearRange>& vec_year_range,
+			std::vector<tz::RuleYearRanges>& vec_year_range_lookup, std::vector<tz::Rule>& vec_rule)
 		{
 			//add rules
 			if (!vec_rule.empty())
 			{
+				// one entry per rule set, lines keep their source order within it
+				std::stable_sort(vec_rule.begin(), vec_rule.end(), [](const tz::Rule& lhs, const tz::Rule& rhs)
+				{
+					return lhs.rule_id < rhs.rule_id;
+				});
+
 				uint32_t curRuleId = vec_rule[0].rule_id;
 				int firstRule = 0;
 				int lastRule = 0;
@@ -229,12 +242,166 @@ namespace smalltime
 				//sort rules by id
 				std::sort(vec_rule_lookup.begin(), vec_rule_lookup.end(), RULE_CMP);
 
+				// a rule set split over two entries would only be found in part
+				auto dup = std::adjacent_find(vec_rule_lookup.begin(), vec_rule_lookup.end(), [](const tz::Rules& lhs, const tz::Rules& rhs)
+				{
+					return lhs.rule_id == rhs.rule_id;
+				});
+				if (dup != vec_rule_lookup.end())
+				{
+					std::cout << "ERROR: rule set " << dup->rule_id << " split over lookup entries ..." << std::endl;
+					return false;
+				}
+
+				// merge overlapping and adjacent years so the ranges of a set are disjoint
+				for (const auto& rules : vec_rule_lookup)
+				{
+					std::vector<tz::RuleYearRange> rule_years;
+					for (int i = rules.first; i < rules.first + rules.size; ++i)
+						rule_years.push_back({ vec_rule[i].from_year, vec_rule[i].to_year });
+
+					std::sort(rule_years.begin(), rule_years.end(), [](const tz::RuleYearRange& lhs, const tz::RuleYearRange& rhs)
+					{
+						return lhs.from_year < rhs.from_year;
+					});
+
+					tz::RuleYearRanges year_ranges = { rules.rule_id, static_cast<int>(vec_year_range.size()), 0 };
+					for (const auto& rule_year : rule_years)
+					{
+						if (year_ranges.size > 0 && rule_year.from_year <= vec_year_range.back().to_year + 1)
+						{
+							vec_year_range.back().to_year = std::max(vec_year_range.back().to_year, rule_year.to_year);
+							continue;
+						}
+
+						vec_year_range.push_back(rule_year);
+						++year_ranges.size;
+					}
+
+					vec_year_range_lookup.push_back(year_ranges);
+				}
+
 				return true;
 			}
 
 			return false;
 		}
 
+		//====================================================================
+		// Build the perfect hash over zone and link names, fails when two
+		// names share an id or no displacement separates a bucket
+		//====================================================================
+		bool Generator::ProcessZoneIndex(std::vector<uint32_t>& vec_displacement, std::vector<tz::ZoneIndexSlot>& vec_slot, std::vector<char>& vec_name,
+			const std::vector<tz::Zones>& vec_zone_lookup, const std::vector<ZoneData>& vec_zonedata, const std::vector<LinkData>& vec_linkdata)
+		{
+			// UTC is not in the sources, ProccessUtc adds it
+			std::set<std::string> names = { "UTC" };
+			for (const auto& zone_data : vec_zonedata)
+				names.insert(zone_data.name);
+			for (const auto& link_data : vec_linkdata)
+				names.insert(link_data.ref_zone_name);
+
+			// keep names that made it into the lookup, two names on one id can not be told apart
+			std::map<uint32_t, std::string> id_names;
+			std::vector<std::pair<std::string, int> > keys;
+			for (const auto& name : names)
+			{
+				tz::Zones key = { math::GetUniqueID(name), 0, 0 };
+				auto it = std::lower_bound(vec_zone_lookup.begin(), vec_zone_lookup.end(), key, ZONE_CMP);
+				if (it == vec_zone_lookup.end() || it->zone_id != key.zone_id)
+					continue;
+
+				auto inserted = id_names.insert(std::make_pair(key.zone_id, name));
+				if (!inserted.second)
+				{
+					std::cout << "ERROR: " << inserted.first->second << " and " << name << " hash to the same zone id ..." << std::endl;
+					return false;
+				}
+
+				keys.push_back(std::make_pair(name, static_cast<int>(it - vec_zone_lookup.begin())));
+			}
+
+			if (keys.empty())
+				return false;
+
+			uint32_t slot_count = static_cast<uint32_t>(keys.size());
+			uint32_t bucket_count = (slot_count + tz::KZONE_INDEX_BUCKET_LOAD - 1) / tz::KZONE_INDEX_BUCKET_LOAD;
+
+			std::vector<tz::ZoneNameHash> hashes;
+			std::vector<std::vector<int> > buckets(bucket_count);
+			for (int i = 0; i < static_cast<int>(keys.size()); ++i)
+			{
+				hashes.push_back(tz::HashZoneName(keys[i].first.data(), keys[i].first.size()));
+				buckets[hashes[i].bucket % bucket_count].push_back(i);
+			}
+
+			// place the largest buckets first while most slots are free
+			std::vector<uint32_t> bucket_order(bucket_count);
+			for (uint32_t i = 0; i < bucket_count; ++i)
+				bucket_order[i] = i;
+			std::stable_sort(bucket_order.begin(), bucket_order.end(), [&buckets](uint32_t lhs, uint32_t rhs)
+			{
+				return buckets[lhs].size() > buckets[rhs].size();
+			});
+
+			vec_displacement.assign(bucket_count, 0);
+			std::vector<int> slot_key(slot_count, -1);
+			uint32_t max_displacement = std::min<uint32_t>(slot_count, 0x10000);
+
+			for (auto bucket : bucket_order)
+			{
+				const auto& bucket_keys = buckets[bucket];
+				if (bucket_keys.empty())
+					continue;
+
+				bool placed = false;
+				std::vector<uint32_t> bucket_slots;
+				for (uint32_t d0 = 0; d0 < max_displacement && !placed; ++d0)
+				{
+					for (uint32_t d1 = 0; d1 < max_displacement && !placed; ++d1)
+					{
+						uint32_t displacement = (d0 << 16) | d1;
+						bucket_slots.clear();
+
+						for (auto key : bucket_keys)
+						{
+							auto slot = tz::ZoneIndexSlotOf(hashes[key], displacement, slot_count);
+							if (slot_key[slot] != -1 || std::find(bucket_slots.begin(), bucket_slots.end(), slot) != bucket_slots.end())
+								break;
+
+							bucket_slots.push_back(slot);
+						}
+
+						if (bucket_slots.size() != bucket_keys.size())
+							continue;
+
+						for (std::size_t i = 0; i < bucket_keys.size(); ++i)
+							slot_key[bucket_slots[i]] = bucket_keys[i];
+
+						vec_displacement[bucket] = displacement;
+						placed = true;
+					}
+				}
+
+				if (!placed)
+					return false;
+			}
+
+			// slots point into one blob of names, in slot order
+			vec_slot.clear();
+			vec_name.clear();
+			for (auto key : slot_key)
+			{
+				const auto& name = keys[key].first;
+
+				tz::ZoneIndexSlot slot = { static_cast<uint32_t>(vec_name.size()), static_cast<uint32_t>(name.size()), keys[key].second };
+				vec_slot.push_back(slot);
+				vec_name.insert(vec_name.end(), name.begin(), name.end());
+			}
+
+			return true;
+		}
+
 		//====================================================================
 		// Process meta data from zone and rule data
 		//====================================================================
@@ -273,7 +440,9 @@ namespace smalltime
 					tzdb_meta.max_rule_size = rules.size;
 			}
 
-			return true;
+			// rule groups only have room for this many transitions in a year
+			tzdb_meta.max_year_rule_size = tz::RuleGroup::FindMaxYearRuleSize(vec_rule_lookup.data(), static_cast<int>(vec_rule_lookup.size()), vec_rule.data());
+			return tzdb_meta.max_year_rule_size <= tz::KMAX_YEAR_RULE_SIZE;
 		}
 
 		//============================================================
@@ -1,11 +1,48 @@
-#include "../include/parser.h"
-#include <sstream>
+#include "../include/Parser.h"
+#include <mapped_file.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
 
 namespace smalltime
 {
 	namespace comp
 	{
-		
+		// Same characters operator>> skips in the classic locale
+		static const char* const KTOKEN_WHITE_SPACE = " \t\n\v\f\r";
+
+		//============================================================================
+		// Split the next whitespace delimited token off the front of rest,
+		// empty once rest holds no more tokens
+		//============================================================================
+		static std::string_view NextToken(std::string_view& rest)
+		{
+			const auto begin_token = rest.find_first_not_of(KTOKEN_WHITE_SPACE);
+			if (begin_token == std::string_view::npos)
+			{
+				rest = std::string_view();
+				return std::string_view();
+			}
+
+			rest.remove_prefix(begin_token);
+			const auto end_token = std::min(rest.find_first_of(KTOKEN_WHITE_SPACE), rest.size());
+
+			std::string_view token = rest.substr(0, end_token);
+			rest.remove_prefix(end_token);
+
+			return token;
+		}
+
+		//============================================================================
+		// Token into a field, fields past the last token are left empty
+		//============================================================================
+		static void AssignToken(std::string& field, std::string_view& rest)
+		{
+			std::string_view token = NextToken(rest);
+			field.assign(token.data(), token.size());
+		}
+
 		//============================================================================
 		// return container of all rules in file
 		//===========================================================================
@@ -30,13 +67,14 @@ namespace smalltime
 		bool Parser::ParseZones(std::vector<ZoneData>& vec_zonedata, std::ifstream& src)
 		{
 			std::string line_str;
+			std::string cur_zone_name;
 			src.clear();
 			src.seekg(0, std::ios::beg);
 
 			while (std::getline(src, line_str))
 			{
 				//iterate line by line through file, searching for rules
-				ExtractZone(vec_zonedata, line_str);
+				ExtractZone(vec_zonedata, line_str, GetLineType(line_str), cur_zone_name);
 			}
 
 			return true;
@@ -62,40 +100,138 @@ namespace smalltime
 
 		}
 
+		//===============================================================================
+		// Map each source and parse it on a worker, then append the results in
+		// source order so the output does not depend on scheduling
+		//===============================================================================
+		bool Parser::ParseSources(const std::vector<std::string>& sources, std::vector<ZoneData>& vec_zonedata, std::vector<RuleData>& vec_ruledata,
+			std::vector<LinkData>& vec_linkdata, std::string& failed_source)
+		{
+			struct ParsedSource
+			{
+				std::vector<ZoneData> zones;
+				std::vector<RuleData> rules;
+				std::vector<LinkData> links;
+				bool parsed = false;
+			};
+
+			std::vector<ParsedSource> parsed_sources(sources.size());
+			std::atomic<std::size_t> next_source(0);
+
+			auto worker = [&]()
+			{
+				for (std::size_t i = next_source++; i < sources.size(); i = next_source++)
+				{
+					fileutil::MappedFile mapped_file;
+					if (!mapped_file.Open(sources[i]))
+						continue;
+
+					auto& parsed_source = parsed_sources[i];
+					parsed_source.parsed = ParseBuffer(mapped_file.GetData(), mapped_file.GetSize(), parsed_source.zones, parsed_source.rules, parsed_source.links);
+				}
+			};
+
+			std::size_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+			thread_count = std::min(thread_count, sources.size());
+
+			// the calling thread is one of the workers
+			std::vector<std::thread> threads;
+			for (std::size_t i = 1; i < thread_count; ++i)
+				threads.emplace_back(worker);
+
+			worker();
+			for (auto& thread : threads)
+				thread.join();
+
+			for (std::size_t i = 0; i < sources.size(); ++i)
+			{
+				auto& parsed_source = parsed_sources[i];
+				if (!parsed_source.parsed)
+				{
+					failed_source = sources[i];
+					return false;
+				}
+
+				vec_zonedata.insert(vec_zonedata.end(), parsed_source.zones.begin(), parsed_source.zones.end());
+				vec_ruledata.insert(vec_ruledata.end(), parsed_source.rules.begin(), parsed_source.rules.end());
+				vec_linkdata.insert(vec_linkdata.end(), parsed_source.links.begin(), parsed_source.links.end());
+			}
+
+			return true;
+		}
+
+		//===============================================================================
+		// Classify every line once and hand it to its extractor, lines are split
+		// the way std::getline splits them
+		//===============================================================================
+		bool Parser::ParseBuffer(const char* data, std::size_t size, std::vector<ZoneData>& vec_zonedata, std::vector<RuleData>& vec_ruledata,
+			std::vector<LinkData>& vec_linkdata)
+		{
+			std::string cur_zone_name;
+			const char* cur = data;
+			const char* end = data + size;
+
+			while (cur < end)
+			{
+				const char* line_end = static_cast<const char*>(std::memchr(cur, '\n', end - cur));
+				if (line_end == nullptr)
+					line_end = end;
+
+				std::string_view line_str(cur, line_end - cur);
+				cur = line_end + 1;
+
+				LineType line_type = GetLineType(line_str);
+				switch (line_type)
+				{
+				case LineType::KRule:
+					ExtractRule(vec_ruledata, line_str);
+					break;
+				case LineType::KLink:
+					ExtractLink(vec_linkdata, line_str);
+					break;
+				case LineType::KZoneHead:
+				case LineType::KZoneBody:
+					ExtractZone(vec_zonedata, line_str, line_type, cur_zone_name);
+					break;
+				default:
+					break;
+				}
+			}
+
+			return true;
+		}
+
 		//========================================================
 		// check if line contains rule and add if it does
 		//===========================================================
-		bool Parser::ExtractRule(std::vector<RuleData>& vec_ruledata, const std::string& line_str)
+		bool Parser::ExtractRule(std::vector<RuleData>& vec_ruledata, std::string_view line_str)
 		{
 			if (GetLineType(line_str) != LineType::KRule)
 				return false;
 
-			std::stringstream lineStream(line_str);
-
 			RuleData ir;
 			// extract label - we can jsut discard it
-			lineStream >> ir.name;
+			NextToken(line_str);
 			//extract name
-			lineStream >> ir.name;
+			AssignToken(ir.name, line_str);
 			// extract from
-			lineStream >> ir.from;
+			AssignToken(ir.from, line_str);
 			// extract to
-			lineStream >> ir.to;
-			// extract type
-			std::string type; //discard as unnecessary
-			lineStream >> type;
+			AssignToken(ir.to, line_str);
+			// extract type, discard as unnecessary
+			NextToken(line_str);
 			// extract in
-			lineStream >> ir.in;
+			AssignToken(ir.in, line_str);
 			// extract on
-			lineStream >> ir.on;
+			AssignToken(ir.on, line_str);
 			// extract at
-			lineStream >> ir.at;
+			AssignToken(ir.at, line_str);
 			// extract save
-			lineStream >> ir.save;
+			AssignToken(ir.save, line_str);
 			// extract letters
-			lineStream >> ir.letters;
+			AssignToken(ir.letters, line_str);
 
-			vec_ruledata.push_back(ir);
+			vec_ruledata.push_back(std::move(ir));
 			return true;
 
 		}
@@ -103,43 +239,37 @@ namespace smalltime
 		//========================================================
 		// check if line contains zone and add if it does
 		//===========================================================
-		bool Parser::ExtractZone(std::vector<ZoneData>& vec_zonedata, const std::string& line_str)
+		bool Parser::ExtractZone(std::vector<ZoneData>& vec_zonedata, std::string_view line_str, LineType line_type, std::string& cur_zone_name)
 		{
-			static std::string cur_zone_name = "";
-
-
-			LineType lt = GetLineType(line_str);
-			if (lt != LineType::KZoneHead && lt != LineType::KZoneBody)
+			if (line_type != LineType::KZoneHead && line_type != LineType::KZoneBody)
 				return false;
 
-			std::string fmt_line_str = FormatZoneLine(line_str);
-			std::stringstream line_stream(fmt_line_str);
-			std::string fw;
+			std::string_view rest = FormatZoneLine(line_str);
 
 			// extract the zone name from head line
-			if (lt == LineType::KZoneHead)
+			if (line_type == LineType::KZoneHead)
 			{
 				//discard label
-				line_stream >> fw;
+				NextToken(rest);
 				//get zone name
-				line_stream >> fw;
-				cur_zone_name = fw;
-
+				AssignToken(cur_zone_name, rest);
 			}
 
 			// zone name removed we can extract zone data
 			ZoneData iz;
 			iz.name = cur_zone_name;
 			// extract gmt offset
-			line_stream >> iz.gmt_offset;
+			AssignToken(iz.gmt_offset, rest);
 			// extract rules
-			line_stream >> iz.rule;
+			AssignToken(iz.rule, rest);
 			// extract format
-			line_stream >> iz.format;
-			// extract remaining line since "until" is a variable length
-			std::getline(line_stream, iz.until);
+			AssignToken(iz.format, rest);
+			// remaining line is "until" since it is variable length, it keeps the
+			// whitespace in front of it and is empty when format ended the line
+			if (!iz.format.empty())
+				iz.until.assign(rest.data(), rest.size());
 
-			vec_zonedata.push_back(iz);
+			vec_zonedata.push_back(std::move(iz));
 			return true;
 
 		}
@@ -147,21 +277,19 @@ namespace smalltime
 		//============================================================
 		// extract link data
 		//============================================================
-		bool Parser::ExtractLink(std::vector<LinkData>& vec_linkdata, const std::string& line_str)
+		bool Parser::ExtractLink(std::vector<LinkData>& vec_linkdata, std::string_view line_str)
 		{
 			if (GetLineType(line_str) != LineType::KLink)
 				return false;
 
-			std::stringstream line_stream(line_str);
-
 			LinkData il;
-			// extract label 
-			line_stream >> il.target_zone_name;
-			// extract link 
-			line_stream >> il.target_zone_name;
-			line_stream >> il.ref_zone_name;
+			// extract label
+			NextToken(line_str);
+			// extract link
+			AssignToken(il.target_zone_name, line_str);
+			AssignToken(il.ref_zone_name, line_str);
 
-			vec_linkdata.push_back(il);
+			vec_linkdata.push_back(std::move(il));
 			return true;
 
 		}
@@ -169,16 +297,14 @@ namespace smalltime
 		//================================================
 		// Determine the type of line
 		//=================================================
-		Parser::LineType Parser::GetLineType(const std::string& line_str)
+		Parser::LineType Parser::GetLineType(std::string_view line_str)
 		{
-			std::string fw;
-			std::stringstream line_stream(line_str);
 			// check first text to see line type
-			line_stream >> fw;
+			std::string_view fw = NextToken(line_str);
 
 			//check if comment line
 			//lines are commented by single start # or whole line delimeter ################
-			if (fw == "#" || fw.empty() || std::all_of(fw.begin(), fw.end(), [](char c) { if (c == '#') { return true; } else { return false; } }) == true)
+			if (fw.empty() || std::all_of(fw.begin(), fw.end(), [](char c) { return c == '#'; }))
 				return LineType::KComment;
 			//check if Rule Line
 			else if (fw == "Rule")
@@ -186,7 +312,7 @@ namespace smalltime
 			// check if Link line
 			else if (fw == "Link")
 				return LineType::KLink;
-			// check if start of Zone 
+			// check if start of Zone
 			else if (fw == "Zone")
 				return LineType::KZoneHead;
 			else
@@ -198,29 +324,24 @@ namespace smalltime
 		//========================================================
 		// removes any beginning whitespace or ending comments
 		//========================================================
-		std::string Parser::FormatZoneLine(const std::string line_str)
+		std::string_view Parser::FormatZoneLine(std::string_view line_str)
 		{
-			static const std::string white_space = " \t";
+			static const char* const white_space = " \t";
 
 			// remove whitespace padding
 			const auto begin_str = line_str.find_first_not_of(white_space);
-			if (begin_str == std::string::npos)
-				return "";
+			if (begin_str == std::string_view::npos)
+				return std::string_view();
 
 			const auto end_str = line_str.find_last_not_of(white_space);
-			const auto range_str = end_str - begin_str + 1;
-
-			std::string formatted_str = line_str.substr(begin_str, range_str);
+			std::string_view formatted_str = line_str.substr(begin_str, end_str - begin_str + 1);
 
 			// remove ending comments
-			bool cmtFound = false;
-			formatted_str.erase(std::remove_if(formatted_str.begin(), formatted_str.end(), [&](char c) {
-				if (c == '#') { cmtFound = true; return true; }
-				else if (cmtFound == true) { return true; }
-				else { return false; }
-			}), formatted_str.end());
+			const auto comment_str = formatted_str.find('#');
+			if (comment_str != std::string_view::npos)
+				formatted_str = formatted_str.substr(0, comment_str);
 
 			return formatted_str;
 		}
 	}
-}
\ No newline at end of file
+}
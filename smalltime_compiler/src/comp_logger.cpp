@@ -1,4 +1,4 @@
-#include "..\include\comp_logger.h"
+#include "../include/comp_logger.h"
 #include <string>
 #include <iomanip>
 #include <assert.h>
@@ -25,9 +25,9 @@ namespace smalltime
 
 				tz::ZoneTransition zt(vec_zone[i].mb_until_utc, vec_zone[i].zone_offset, vec_zone[i].next_zone_offset, vec_zone[i].mb_rule_offset, vec_zone[i].trans_rule_offset);
 
-				BasicDateTime<> mb_wall_dt(zt.mb_trans_wall_, tz::KTimeType_Wall);
-				BasicDateTime<> fi_wall_dt(zt.first_inst_wall_, tz::KTimeType_Wall);
-				BasicDateTime<> until_wall_dt(zt.trans_wall_, tz::KTimeType_Wall);
+				BasicDateTime<> mb_wall_dt(math::FixedFromTicks(zt.mb_trans_wall_), tz::KTimeType_Wall);
+				BasicDateTime<> fi_wall_dt(math::FixedFromTicks(zt.first_inst_wall_), tz::KTimeType_Wall);
+				BasicDateTime<> until_wall_dt(math::FixedFromTicks(zt.trans_wall_), tz::KTimeType_Wall);
 
 
 				std::string zone_name = "";
@@ -58,9 +58,9 @@ namespace smalltime
 				{
 					tz::ZoneTransition zt(vec_zone[i].mb_until_utc, vec_zone[i].zone_offset, vec_zone[i].next_zone_offset, vec_zone[i].mb_rule_offset, vec_zone[i].trans_rule_offset);
 
-					BasicDateTime<> mb_wall_dt(zt.mb_trans_wall_, tz::KTimeType_Wall);
-					BasicDateTime<> fi_wall_dt(zt.first_inst_wall_, tz::KTimeType_Wall);
-					BasicDateTime<> until_wall_dt(zt.trans_wall_, tz::KTimeType_Wall);
+					BasicDateTime<> mb_wall_dt(math::FixedFromTicks(zt.mb_trans_wall_), tz::KTimeType_Wall);
+					BasicDateTime<> fi_wall_dt(math::FixedFromTicks(zt.first_inst_wall_), tz::KTimeType_Wall);
+					BasicDateTime<> until_wall_dt(math::FixedFromTicks(zt.trans_wall_), tz::KTimeType_Wall);
 
 
 					std::string zone_name = "";
@@ -3,121 +3,176 @@
 #include <sstream>
 #include <iomanip>
 #include <iostream>
+#include <cstring>
 
 namespace smalltime
 {
 	namespace comp
 	{
-		//========================================
-		// Build binary file of tzdb data
-		//========================================
-		bool FileBuilder::Build(std::vector<tz::Rule>& vec_rule, std::vector<tz::Zone>& vec_zone, std::vector<tz::Zones>& vec_zone_lookup,
-			std::vector<tz::Rules>& vec_rule_lookup, std::ofstream& out_file)
+		//===================================================
+		// Copy record field by field, leaving padding alone
+		//===================================================
+		static void CopyRecord(tz::Zone& dst, const tz::Zone& src)
 		{
+			dst.zone_id = src.zone_id;
+			dst.rule_id = src.rule_id;
+			dst.mb_until_utc = src.mb_until_utc;
+			dst.until_type = src.until_type;
+			dst.zone_offset = src.zone_offset;
+			dst.next_zone_offset = src.next_zone_offset;
+			dst.mb_rule_offset = src.mb_rule_offset;
+			dst.trans_rule_offset = src.trans_rule_offset;
+			dst.abbrev = src.abbrev;
+		}
 
-			out_file.seekp(out_file.beg);
-			auto tzdb_id = math::GetUniqueID("TZDB_FILE");
-			//simple file corruption check
-			tz::Zone z;
-			int total_zone_size = (sizeof(z.abbrev) + sizeof(z.mb_rule_offset) + sizeof(z.mb_until_utc) + sizeof(z.next_zone_offset) +
-				sizeof(z.rule_id) + sizeof(z.trans_rule_offset) + sizeof(z.until_type) + sizeof(z.zone_id) + sizeof(z.zone_offset)) * vec_zone.size();
-
-			tz::Rule r;
-			int total_rule_size = (sizeof(r.at_time) + sizeof(r.at_type) + sizeof(r.day) + sizeof(r.day_type) +
-				sizeof(r.from_year) + sizeof(r.letter) + sizeof(r.month) + sizeof(r.offset) + sizeof(r.rule_id) + sizeof(r.to_year)) * vec_rule.size();
-
-			tz::Zones zs;
-			int total_zones_size = (sizeof(zs.first) + sizeof(zs.size) + sizeof(zs.zone_id)) * vec_zone_lookup.size();
-
-
-			tz::Zones rs;
-			int total_rules_size = (sizeof(rs.first) + sizeof(rs.size) + sizeof(rs.zone_id)) * vec_rule_lookup.size();
-
-			int tzdb_file_size = (sizeof(int) * 5) + sizeof(tzdb_id) + total_zone_size + total_rule_size + total_zones_size + total_rules_size;
-
-			out_file.write(reinterpret_cast<char*>(&tzdb_id), sizeof(tzdb_id));
-			out_file.write(reinterpret_cast<char*>(&tzdb_file_size), sizeof(tzdb_file_size));
-
-			// write zones
-			out_file.write(reinterpret_cast<char*>(&total_zone_size), sizeof(total_zone_size));
-			for (auto& z : vec_zone)
-				InsertZone(z, out_file);
-			// write rules
-			out_file.write(reinterpret_cast<char*>(&total_rule_size), sizeof(total_rule_size));
-			for (auto& r : vec_rule)
-				InsertRule(r, out_file);
-			// write zone lookup
-			out_file.write(reinterpret_cast<char*>(&total_zones_size), sizeof(total_zones_size));
-			for (auto& zs : vec_zone_lookup)
-				InsertZoneSearch(zs, out_file);
-			// write rule lookup
-			out_file.write(reinterpret_cast<char*>(&total_rules_size), sizeof(total_rules_size));
-			for (auto& rs : vec_rule_lookup)
-				InsertRuleSearch(rs, out_file);
-
-			return true;
+		static void CopyRecord(tz::Rule& dst, const tz::Rule& src)
+		{
+			dst.rule_id = src.rule_id;
+			dst.from_year = src.from_year;
+			dst.to_year = src.to_year;
+			dst.month = src.month;
+			dst.day = src.day;
+			dst.day_type = src.day_type;
+			dst.at_time = src.at_time;
+			dst.at_type = src.at_type;
+			dst.offset = src.offset;
+			dst.letter = src.letter;
 		}
 
-		//==================================================
-		// Convert and insert zone as binary format
-		//===================================================
-		bool FileBuilder::InsertZone(tz::Zone& zone, std::ofstream& out_file)
+		static void CopyRecord(tz::Zones& dst, const tz::Zones& src)
 		{
-			out_file.write(reinterpret_cast<char*>(&zone.zone_id), sizeof(zone.zone_id));
-			out_file.write(reinterpret_cast<char*>(&zone.rule_id), sizeof(zone.rule_id));
-			out_file.write(reinterpret_cast<char*>(&zone.mb_until_utc), sizeof(zone.mb_until_utc));
-			out_file.write(reinterpret_cast<char*>(&zone.until_type), sizeof(zone.until_type));
-			out_file.write(reinterpret_cast<char*>(&zone.zone_offset), sizeof(zone.zone_offset));
-			out_file.write(reinterpret_cast<char*>(&zone.next_zone_offset), sizeof(zone.next_zone_offset));
-			out_file.write(reinterpret_cast<char*>(&zone.mb_rule_offset), sizeof(zone.mb_rule_offset));
-			out_file.write(reinterpret_cast<char*>(&zone.trans_rule_offset), sizeof(zone.trans_rule_offset));
-			out_file.write(reinterpret_cast<char*>(&zone.abbrev), sizeof(zone.abbrev));
-
-			return true;
+			dst.zone_id = src.zone_id;
+			dst.first = src.first;
+			dst.size = src.size;
 		}
 
-		//=========================================================
-		// convert and insert rule as binary format
-		//========================================================
-		bool FileBuilder::InsertRule(tz::Rule& rule, std::ofstream& out_file)
+		static void CopyRecord(tz::Rules& dst, const tz::Rules& src)
 		{
-			out_file.write(reinterpret_cast<char*>(&rule.rule_id), sizeof(rule.rule_id));
-			out_file.write(reinterpret_cast<char*>(&rule.from_year), sizeof(rule.from_year));
-			out_file.write(reinterpret_cast<char*>(&rule.to_year), sizeof(rule.to_year));
-			out_file.write(reinterpret_cast<char*>(&rule.month), sizeof(rule.month));
-			out_file.write(reinterpret_cast<char*>(&rule.day), sizeof(rule.day));
-			out_file.write(reinterpret_cast<char*>(&rule.day_type), sizeof(rule.day_type));
-			out_file.write(reinterpret_cast<char*>(&rule.at_time), sizeof(rule.at_time));
-			out_file.write(reinterpret_cast<char*>(&rule.at_type), sizeof(rule.at_type));
-			out_file.write(reinterpret_cast<char*>(&rule.offset), sizeof(rule.offset));
-			out_file.write(reinterpret_cast<char*>(&rule.letter), sizeof(rule.letter));
-
-			return true;
+			dst.rule_id = src.rule_id;
+			dst.first = src.first;
+			dst.size = src.size;
 		}
 
-		//==================================================
-		// Convert and insert zone lookup as binary format
-		//===================================================
-		bool FileBuilder::InsertZoneSearch(tz::Zones& zones, std::ofstream& out_file)
+		static void CopyRecord(tz::UtcTransition& dst, const tz::UtcTransition& src)
 		{
-			out_file.write(reinterpret_cast<char*>(&zones.zone_id), sizeof(zones.zone_id));
-			out_file.write(reinterpret_cast<char*>(&zones.first), sizeof(zones.first));
-			out_file.write(reinterpret_cast<char*>(&zones.size), sizeof(zones.size));
-			
-			return true;
+			dst.utc = src.utc;
+			dst.offset = src.offset;
+			dst.abbrev_index = src.abbrev_index;
 		}
 
-		//==================================================
-		// Convert and insert rule lookup as binary format
-		//===================================================
-		bool FileBuilder::InsertRuleSearch(tz::Rules& rules, std::ofstream& out_file)
+		static void CopyRecord(tz::UtcTransitions& dst, const tz::UtcTransitions& src)
 		{
-			out_file.write(reinterpret_cast<char*>(&rules.rule_id), sizeof(rules.rule_id));
-			out_file.write(reinterpret_cast<char*>(&rules.first), sizeof(rules.first));
-			out_file.write(reinterpret_cast<char*>(&rules.size), sizeof(rules.size));
+			dst.zone_id = src.zone_id;
+			dst.first = src.first;
+			dst.size = src.size;
+			dst.tail_utc = src.tail_utc;
+		}
 
-			return true;
+		static void CopyRecord(tz::ZoneIndexSlot& dst, const tz::ZoneIndexSlot& src)
+		{
+			dst.name_offset = src.name_offset;
+			dst.name_size = src.name_size;
+			dst.lookup_index = src.lookup_index;
+		}
+
+		static void CopyRecord(tz::RuleYearRange& dst, const tz::RuleYearRange& src)
+		{
+			dst.from_year = src.from_year;
+			dst.to_year = src.to_year;
 		}
 
+		static void CopyRecord(tz::RuleYearRanges& dst, const tz::RuleYearRanges& src)
+		{
+			dst.rule_id = src.rule_id;
+			dst.first = src.first;
+			dst.size = src.size;
+		}
+
+		static void CopyRecord(uint64_t& dst, const uint64_t& src)
+		{
+			dst = src;
+		}
+
+		static void CopyRecord(uint32_t& dst, const uint32_t& src)
+		{
+			dst = src;
+		}
+
+		static void CopyRecord(char& dst, const char& src)
+		{
+			dst = src;
+		}
+
+		//==================================================================
+		// Build version 2 binary file of tzdb data, every section is an
+		// aligned array of the in memory struct
+		//==================================================================
+		bool FileBuilder::Build(std::vector<tz::Rule>& vec_rule, std::vector<tz::Zone>& vec_zone, std::vector<tz::Zones>& vec_zone_lookup,
+			std::vector<tz::Rules>& vec_rule_lookup, std::vector<tz::UtcTransition>& vec_transition, std::vector<tz::UtcTransitions>& vec_transition_lookup,
+			std::vector<uint64_t>& vec_abbrev, std::vector<uint32_t>& vec_displacement, std::vector<tz::ZoneIndexSlot>& vec_slot,
+			std::vector<char>& vec_name, std::vector<tz::RuleYearRange>& vec_year_range, std::vector<tz::RuleYearRanges>& vec_year_range_lookup,
+			const MetaData& tzdb_meta, std::ofstream& out_file)
+		{
+			if (!out_file)
+				return false;
+
+			tz::TzdbHeader header;
+			std::memset(&header, 0, sizeof(header));
+
+			header.magic = tz::KTZDB_MAGIC;
+			header.version = tz::KTZDB_VERSION;
+			header.header_size = sizeof(header);
+			header.section_count = tz::KTzdbSection_Count;
+			header.max_year_rule_size = tzdb_meta.max_year_rule_size;
+			header.transition_horizon = tzdb_meta.transition_horizon;
+
+			std::vector<char> image(sizeof(header), 0);
+			AppendSection(image, header, tz::KTzdbSection_Zone, vec_zone);
+			AppendSection(image, header, tz::KTzdbSection_Rule, vec_rule);
+			AppendSection(image, header, tz::KTzdbSection_ZoneLookup, vec_zone_lookup);
+			AppendSection(image, header, tz::KTzdbSection_RuleLookup, vec_rule_lookup);
+			AppendSection(image, header, tz::KTzdbSection_UtcTransition, vec_transition);
+			AppendSection(image, header, tz::KTzdbSection_UtcTransitionLookup, vec_transition_lookup);
+			AppendSection(image, header, tz::KTzdbSection_Abbrev, vec_abbrev);
+			AppendSection(image, header, tz::KTzdbSection_ZoneIndexDisplacement, vec_displacement);
+			AppendSection(image, header, tz::KTzdbSection_ZoneIndexSlot, vec_slot);
+			AppendSection(image, header, tz::KTzdbSection_ZoneIndexName, vec_name);
+			AppendSection(image, header, tz::KTzdbSection_RuleYearRange, vec_year_range);
+			AppendSection(image, header, tz::KTzdbSection_RuleYearRangeLookup, vec_year_range_lookup);
+
+			header.file_size = image.size();
+			header.crc = math::Crc32(image.data() + sizeof(header), image.size() - sizeof(header));
+			std::memcpy(image.data(), &header, sizeof(header));
+
+			out_file.seekp(out_file.beg);
+			out_file.write(image.data(), image.size());
+
+			return static_cast<bool>(out_file);
+		}
+
+		//===================================================================
+		// Pad image to the section alignment and append records in place
+		//===================================================================
+		template <typename T>
+		void FileBuilder::AppendSection(std::vector<char>& image, tz::TzdbHeader& header, tz::TzdbSectionType section_type, const std::vector<T>& vec_record)
+		{
+			image.resize(static_cast<std::size_t>(tz::AlignTzdbOffset(image.size())), 0);
+
+			auto& section = header.sections[section_type];
+			section.offset = image.size();
+			section.count = static_cast<uint32_t>(vec_record.size());
+			section.record_size = sizeof(T);
+
+			for (const auto& record : vec_record)
+			{
+				// struct padding is left zeroed so the output is reproducible
+				T padded;
+				std::memset(&padded, 0, sizeof(padded));
+				CopyRecord(padded, record);
+
+				const char* bytes = reinterpret_cast<const char*>(&padded);
+				image.insert(image.end(), bytes, bytes + sizeof(padded));
+			}
+		}
 	}
 }
\ No newline at end of file
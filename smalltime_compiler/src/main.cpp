@@ -1,29 +1,129 @@
 #include <iostream>
 #include <fstream>
-#include <Windows.h>
 #include <vector>
 #include <memory>
+#include <string>
+#include <cstring>
+#include <cstdlib>
 
-#include "..\include\comp_decls.h"
-#include "..\include\Parser.h"
-#include "..\include\generator.h"
-#include "..\include\src_builder.h"
-#include "..\include\file_builder.h"
-#include "..\include\zone_post_generator.h"
-#include "..\include\comp_logger.h"
+#include "../include/comp_decls.h"
+#include "../include/Parser.h"
+#include "../include/Generator.h"
+#include "../include/src_builder.h"
+#include "../include/file_builder.h"
+#include "../include/zone_post_generator.h"
+#include "../include/transition_generator.h"
+#include "../include/comp_logger.h"
+#include "../include/source_cache.h"
 
 #include <basic_datetime.h>
 #include <tzdb_connector_interface.h>
-#include "..\include\tzdb_raw_connector.h"
+#include "../include/tzdb_raw_connector.h"
 
 using namespace smalltime;
 
-static bool log_transition_data = false;
+// What the compiler writes
+enum class OutputFormat
+{
+	KBin,
+	KHeader
+};
 
-int main()
+struct Options
 {
-	
-	std::vector<std::string> vSrc = { "iana\\northamerica", "iana\\southamerica", "iana\\asia", "iana\\africa", "iana\\australasia", "iana\\antarctica", "iana\\europe" };
+	std::vector<std::string> inputs;
+	std::string output;
+	std::string cache_dir;
+	OutputFormat format = OutputFormat::KBin;
+	int horizon_year = comp::KTRANSITION_HORIZON;
+	bool log_zones = false;
+};
+
+// Sources read when none are given, relative to the working directory
+static const std::vector<std::string> KDEFAULT_SOURCES = { "iana/northamerica", "iana/southamerica", "iana/asia", "iana/africa", "iana/australasia", "iana/antarctica", "iana/europe" };
+
+//=================================================
+// Print command line usage
+//=================================================
+static void PrintUsage(std::ostream& stream)
+{
+	stream << "usage: smalltime_compiler [-o output] [-f bin|header] [-y year] [-c cache_dir] [-l] [input ...]\n"
+		<< "  -o output   file to write, defaults to tzdb.bin or Tzdb.h\n"
+		<< "  -f format   bin writes a tzdb file, header writes a C++ header (default bin)\n"
+		<< "  -y year     precompile utc transitions up to the end of year, " << comp::KTRANSITION_HORIZON_MIN << " to " << comp::KTRANSITION_HORIZON_MAX
+		<< " (default " << comp::KTRANSITION_HORIZON << ")\n"
+		<< "  -c dir      reuse parsed and generated sources that did not change since the last run\n"
+		<< "  -l          log every compiled zone\n"
+		<< "  input       iana source files, defaults to iana/<region> for each region\n";
+}
+
+//=================================================
+// Parse command line, false on bad arguments
+//=================================================
+static bool ParseOptions(int argc, char** argv, Options& options)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+		{
+			options.output = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+		{
+			std::string format = argv[++i];
+			if (format == "bin")
+				options.format = OutputFormat::KBin;
+			else if (format == "header")
+				options.format = OutputFormat::KHeader;
+			else
+				return false;
+		}
+		else if (std::strcmp(argv[i], "-y") == 0 && i + 1 < argc)
+		{
+			const char* year = argv[++i];
+			char* year_end = nullptr;
+			long horizon_year = std::strtol(year, &year_end, 10);
+			if (year_end == year || *year_end != '\0' || horizon_year < comp::KTRANSITION_HORIZON_MIN || horizon_year > comp::KTRANSITION_HORIZON_MAX)
+				return false;
+
+			options.horizon_year = static_cast<int>(horizon_year);
+		}
+		else if (std::strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+		{
+			options.cache_dir = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "-l") == 0)
+		{
+			options.log_zones = true;
+		}
+		else if (argv[i][0] == '-')
+		{
+			return false;
+		}
+		else
+		{
+			options.inputs.push_back(argv[i]);
+		}
+	}
+
+	if (options.inputs.empty())
+		options.inputs = KDEFAULT_SOURCES;
+
+	if (options.output.empty())
+		options.output = options.format == OutputFormat::KBin ? "tzdb.bin" : "Tzdb.h";
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage(std::cerr);
+		return 1;
+	}
+
 	std::vector<comp::ZoneData> vec_zonedata = {};
 	std::vector<comp::RuleData> vec_ruledata = {};
 	std::vector<comp::LinkData> vec_linkdata = {};
@@ -34,6 +134,16 @@ int main()
 
 	std::vector<tz::Zones> vec_zone_lookup;
 	std::vector<tz::Rules> vec_rule_lookup;
+	std::vector<tz::RuleYearRange> vec_rule_year_range;
+	std::vector<tz::RuleYearRanges> vec_rule_year_range_lookup;
+
+	std::vector<tz::UtcTransition> vec_transition;
+	std::vector<tz::UtcTransitions> vec_transition_lookup;
+	std::vector<uint64_t> vec_abbrev;
+
+	std::vector<uint32_t> vec_zone_index_displacement;
+	std::vector<tz::ZoneIndexSlot> vec_zone_index_slot;
+	std::vector<char> vec_zone_index_name;
 	comp::MetaData tzdb_meta;
 
 	comp::Parser parser;
@@ -41,31 +151,37 @@ int main()
 	comp::SrcBuilder src_builder;
 	comp::FileBuilder file_builder;
 
-	std::ifstream inf;
-	for (const auto& src : vSrc)
+	comp::SourceCache source_cache(options.cache_dir);
+	bool incremental = !options.cache_dir.empty();
+
+	std::string failed_source;
+	if (incremental)
 	{
-		inf.open(src, std::ios::in);
-		if (inf)
+		if (!source_cache.LoadSources(options.inputs, parser, generator, vec_zonedata, vec_ruledata, vec_linkdata, vec_zone, vec_rule, failed_source))
 		{
-			parser.ParseZones(vec_zonedata, inf);
-			parser.ParseRules(vec_ruledata, inf);
-			parser.ParseLinks(vec_linkdata, inf);
-			std::cout << src << " parsed ..." << std::endl;
+			std::cout << "ERROR: " << failed_source << " not parsed ..." << std::endl;
+			return 1;
 		}
-		else
-		{
-			std::cout << "ERROR: " << src << " not parsed ..." << std::endl;
 
-		}
-		inf.close();
+		std::cout << source_cache.GetLoadedCount() << " of " << source_cache.GetSourceCount() << " sources loaded from cache ..." << std::endl;
 	}
-	
+	else
+	{
+		if (!parser.ParseSources(options.inputs, vec_zonedata, vec_ruledata, vec_linkdata, failed_source))
+		{
+			std::cout << "ERROR: " << failed_source << " not parsed ..." << std::endl;
+			return 1;
+		}
 
-	generator.ProcessZones(vec_zone, vec_zonedata);
-	std::cout << "Zones processed ..." << std::endl;
+		for (const auto& src : options.inputs)
+			std::cout << src << " parsed ..." << std::endl;
+
+		generator.ProcessZones(vec_zone, vec_zonedata);
+		std::cout << "Zones processed ..." << std::endl;
 
-	generator.ProcessRules(vec_rule, vec_ruledata);
-	std::cout << "Rules processed ..." << std::endl;
+		generator.ProcessRules(vec_rule, vec_ruledata);
+		std::cout << "Rules processed ..." << std::endl;
+	}
 
 	generator.ProcessLinks(vec_link, vec_linkdata);
 	std::cout << "Links processed ..." << std::endl;
@@ -76,36 +192,88 @@ int main()
 	generator.ProcessZoneLookup(vec_zone_lookup, vec_zone, vec_link);
 	std::cout << "Zone lookup processed ..." << std::endl;
 
-	generator.ProcessRuleLookup(vec_rule_lookup, vec_rule);
+	if (!generator.ProcessRuleLookup(vec_rule_lookup, vec_rule_year_range, vec_rule_year_range_lookup, vec_rule))
+	{
+		std::cout << "ERROR: rule lookup not built ..." << std::endl;
+		return 1;
+	}
 	std::cout << "Rule lookup processed ..." << std::endl;
 
-	generator.ProcessMeta(tzdb_meta, vec_zone, vec_rule, vec_zone_lookup, vec_rule_lookup);
+	if (!generator.ProcessZoneIndex(vec_zone_index_displacement, vec_zone_index_slot, vec_zone_index_name, vec_zone_lookup, vec_zonedata, vec_linkdata))
+	{
+		std::cout << "ERROR: zone index not built ..." << std::endl;
+		return 1;
+	}
+	std::cout << "Zone index processed ..." << std::endl;
+
+	if (!generator.ProcessMeta(tzdb_meta, vec_zone, vec_rule, vec_zone_lookup, vec_rule_lookup))
+	{
+		std::cout << "ERROR: " << tzdb_meta.max_year_rule_size << " rules of one name are in effect in a year, at most " << tz::KMAX_YEAR_RULE_SIZE << " are supported ..." << std::endl;
+		return 1;
+	}
 	std::cout << "Metadata processed ..." << std::endl;
 
 	std::shared_ptr<comp::TzdbRawConnector> tzdb_connector = std::make_shared<comp::TzdbRawConnector>(tzdb_meta, vec_zone, vec_rule, vec_zone_lookup, vec_rule_lookup);
 	comp::ZonePostGenerator zone_post_generator(tzdb_connector);
 
 
-	zone_post_generator.ProcessZones(vec_zone);
-	std::cout << "Zone post-processed ..." << std::endl;
+	if (incremental)
+	{
+		source_cache.PostProcessZones(zone_post_generator, tzdb_connector, vec_zone);
+		std::cout << "Zone post-processed, " << source_cache.GetPostReusedCount() << " of " << source_cache.GetSourceCount() << " sources reused ..." << std::endl;
 
-	std::ofstream outf("Tzdb.h", std::ofstream::trunc);
-	src_builder.BuildHead(outf);
-	src_builder.BuildBody(vec_rule, vec_zone, vec_zone_lookup, vec_rule_lookup, tzdb_meta, outf);
-	src_builder.BuildTail(outf);
+		if (!source_cache.StoreSources())
+			std::cout << "WARNING: " << options.cache_dir << " not updated ..." << std::endl;
+	}
+	else
+	{
+		zone_post_generator.ProcessZones(vec_zone);
+		std::cout << "Zone post-processed ..." << std::endl;
+	}
 
-	//std::ofstream outf("tzdb.bin", std::ios::out | std::ios::binary);
-	//file_builder.Build(vec_rule, vec_zone, vec_zone_lookup, vec_rule_lookup, outf);
+	comp::TransitionGenerator transition_generator(tzdb_connector);
+	if (!transition_generator.ProcessTransitions(vec_transition, vec_transition_lookup, vec_abbrev, vec_zone, vec_zone_lookup, vec_zonedata, vec_ruledata, options.horizon_year))
+	{
+		std::cout << "ERROR: transitions not built ..." << std::endl;
+		return 1;
+	}
+	tzdb_meta.transition_horizon = options.horizon_year;
+	std::cout << "Transitions processed up to " << options.horizon_year << " ..." << std::endl;
 
-	outf.close();
-	std::cout << "Source compiled ..." << std::endl;
+	bool built = false;
+	if (options.format == OutputFormat::KHeader)
+	{
+		std::ofstream outf(options.output, std::ofstream::trunc);
+		built = src_builder.BuildHead(outf) &&
+			src_builder.BuildBody(vec_rule, vec_zone, vec_zone_lookup, vec_rule_lookup, tzdb_meta, outf) &&
+			src_builder.BuildTransitions(vec_transition, vec_transition_lookup, vec_abbrev, outf) &&
+			src_builder.BuildZoneIndex(vec_zone_index_displacement, vec_zone_index_slot, vec_zone_index_name, outf) &&
+			src_builder.BuildRuleYearRanges(vec_rule_year_range, vec_rule_year_range_lookup, outf) &&
+			src_builder.BuildTail(outf);
+		outf.close();
+		built = built && static_cast<bool>(outf);
+	}
+	else
+	{
+		std::ofstream outf(options.output, std::ios::out | std::ios::binary | std::ios::trunc);
+		built = file_builder.Build(vec_rule, vec_zone, vec_zone_lookup, vec_rule_lookup, vec_transition, vec_transition_lookup, vec_abbrev,
+			vec_zone_index_displacement, vec_zone_index_slot, vec_zone_index_name, vec_rule_year_range, vec_rule_year_range_lookup, tzdb_meta, outf);
+		outf.close();
+		built = built && static_cast<bool>(outf);
+	}
 
-	comp::CompLogger comp_logger;
-	comp_logger.LogAllZones(std::cout, vec_zone, vec_zonedata);
-	//comp_logger.LogZoneData(std::cout, vec_zone, vec_zonedata, "Australia/Perth");
+	if (!built)
+	{
+		std::cout << "ERROR: " << options.output << " not written ..." << std::endl;
+		return 1;
+	}
+	std::cout << options.output << " compiled ..." << std::endl;
 
-	
+	if (options.log_zones)
+	{
+		comp::CompLogger comp_logger;
+		comp_logger.LogAllZones(std::cout, vec_zone, vec_zonedata);
+	}
 
-	std::cin.get();
 	return 0;
-}
\ No newline at end of file
+}
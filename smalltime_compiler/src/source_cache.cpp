@@ -0,0 +1,381 @@
+#include "../include/source_cache.h"
+
+#include <mapped_file.h>
+#include <murmur_hash3.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <type_traits>
+
+namespace smalltime
+{
+	namespace comp
+	{
+		// "STSC" little endian
+		static const uint32_t KSOURCE_CACHE_MAGIC = 0x43535453;
+
+		//===================================================
+		// Append the bytes of a trivially copyable value
+		//===================================================
+		template <typename T>
+		static void WriteValue(std::vector<char>& buffer, const T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "only plain records are written");
+
+			const char* bytes = reinterpret_cast<const char*>(&value);
+			buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+		}
+
+		//===================================================
+		// Append a string prefixed with its size
+		//===================================================
+		static void WriteString(std::vector<char>& buffer, const std::string& str)
+		{
+			WriteValue(buffer, static_cast<uint32_t>(str.size()));
+			buffer.insert(buffer.end(), str.begin(), str.end());
+		}
+
+		//===================================================
+		// Append records prefixed with their count
+		//===================================================
+		template <typename T>
+		static void WriteRecords(std::vector<char>& buffer, const std::vector<T>& vec_record)
+		{
+			WriteValue(buffer, static_cast<uint32_t>(vec_record.size()));
+			for (const auto& record : vec_record)
+				WriteValue(buffer, record);
+		}
+
+		//===================================================
+		// Copy a value out of the entry, false past the end
+		//===================================================
+		template <typename T>
+		static bool ReadValue(const char*& cur, const char* end, T& value)
+		{
+			if (static_cast<std::size_t>(end - cur) < sizeof(T))
+				return false;
+
+			std::memcpy(&value, cur, sizeof(T));
+			cur += sizeof(T);
+
+			return true;
+		}
+
+		//===================================================
+		// Copy a size prefixed string out of the entry
+		//===================================================
+		static bool ReadString(const char*& cur, const char* end, std::string& str)
+		{
+			uint32_t size = 0;
+			if (!ReadValue(cur, end, size) || static_cast<std::size_t>(end - cur) < size)
+				return false;
+
+			str.assign(cur, size);
+			cur += size;
+
+			return true;
+		}
+
+		//===================================================
+		// Copy count prefixed records out of the entry
+		//===================================================
+		template <typename T>
+		static bool ReadRecords(const char*& cur, const char* end, std::vector<T>& vec_record)
+		{
+			uint32_t count = 0;
+			if (!ReadValue(cur, end, count) || static_cast<std::size_t>(end - cur) / sizeof(T) < count)
+				return false;
+
+			vec_record.resize(count);
+			for (auto& record : vec_record)
+				ReadValue(cur, end, record);
+
+			return true;
+		}
+
+		//=============================================
+		// Ctor
+		//=============================================
+		SourceCache::SourceCache(std::string cache_dir) : cache_dir_(std::move(cache_dir)), loaded_count_(0), post_reused_count_(0)
+		{
+
+		}
+
+		//=======================================================================
+		// Hash each source and load its entry, sources without an entry are
+		// parsed and generated and stored later
+		//=======================================================================
+		bool SourceCache::LoadSources(const std::vector<std::string>& sources, Parser& parser, Generator& generator, std::vector<ZoneData>& vec_zonedata,
+			std::vector<RuleData>& vec_ruledata, std::vector<LinkData>& vec_linkdata, std::vector<tz::Zone>& vec_zone, std::vector<tz::Rule>& vec_rule,
+			std::string& failed_source)
+		{
+			entries_.clear();
+			entries_.resize(sources.size());
+			loaded_count_ = 0;
+
+			for (std::size_t i = 0; i < sources.size(); ++i)
+			{
+				auto& entry = entries_[i];
+
+				fileutil::MappedFile mapped_file;
+				if (!mapped_file.Open(sources[i]))
+				{
+					failed_source = sources[i];
+					return false;
+				}
+
+				MurmurHash3_x64_128(mapped_file.GetData(), static_cast<int>(mapped_file.GetSize()), KSOURCE_CACHE_VERSION, entry.content_hash);
+
+				if (ReadEntry(entry))
+				{
+					entry.dirty = false;
+					++loaded_count_;
+				}
+				else
+				{
+					parser.ParseBuffer(mapped_file.GetData(), mapped_file.GetSize(), entry.zonedata, entry.ruledata, entry.linkdata);
+					generator.ProcessZones(entry.zones, entry.zonedata);
+					generator.ProcessRules(entry.rules, entry.ruledata);
+
+					entry.rule_hash[0] = 0;
+					entry.rule_hash[1] = 0;
+					entry.post_zones.clear();
+					entry.dirty = true;
+				}
+
+				entry.zone_first = static_cast<int>(vec_zone.size());
+
+				vec_zonedata.insert(vec_zonedata.end(), entry.zonedata.begin(), entry.zonedata.end());
+				vec_ruledata.insert(vec_ruledata.end(), entry.ruledata.begin(), entry.ruledata.end());
+				vec_linkdata.insert(vec_linkdata.end(), entry.linkdata.begin(), entry.linkdata.end());
+				vec_zone.insert(vec_zone.end(), entry.zones.begin(), entry.zones.end());
+				vec_rule.insert(vec_rule.end(), entry.rules.begin(), entry.rules.end());
+			}
+
+			return true;
+		}
+
+		//=======================================================================
+		// Zone groups never span sources, so each source's zones can be post
+		// processed on their own
+		//=======================================================================
+		bool SourceCache::PostProcessZones(ZonePostGenerator& zone_post_generator, std::shared_ptr<tz::TzdbConnectorInterface> tzdb_connector,
+			std::vector<tz::Zone>& vec_zone)
+		{
+			post_reused_count_ = 0;
+			int zone_last = 0;
+
+			for (auto& entry : entries_)
+			{
+				int zone_size = static_cast<int>(entry.zones.size());
+				zone_last = entry.zone_first + zone_size;
+
+				uint64_t rule_hash[2];
+				HashRules(entry, *tzdb_connector, rule_hash);
+
+				if (entry.post_zones.size() == entry.zones.size() && rule_hash[0] == entry.rule_hash[0] && rule_hash[1] == entry.rule_hash[1])
+				{
+					std::copy(entry.post_zones.begin(), entry.post_zones.end(), vec_zone.begin() + entry.zone_first);
+					++post_reused_count_;
+					continue;
+				}
+
+				if (!zone_post_generator.ProcessZones(vec_zone, entry.zone_first, zone_size))
+					return false;
+
+				entry.post_zones.assign(vec_zone.begin() + entry.zone_first, vec_zone.begin() + zone_last);
+				entry.rule_hash[0] = rule_hash[0];
+				entry.rule_hash[1] = rule_hash[1];
+				entry.dirty = true;
+			}
+
+			// generated zones such as UTC
+			return zone_post_generator.ProcessZones(vec_zone, zone_last, static_cast<int>(vec_zone.size()) - zone_last);
+		}
+
+		//=======================================================================
+		// Write every entry that changed, each is written to a temporary file
+		// and renamed so a failed run never leaves a partial entry
+		//=======================================================================
+		bool SourceCache::StoreSources()
+		{
+			std::error_code error;
+			std::filesystem::create_directories(cache_dir_, error);
+
+			bool stored = true;
+			for (const auto& entry : entries_)
+			{
+				if (entry.dirty)
+					stored = WriteEntry(entry) && stored;
+			}
+
+			return stored;
+		}
+
+		//=======================================================================
+		// Entries are named by the content hash of their source
+		//=======================================================================
+		std::string SourceCache::GetEntryPath(const SourceEntry& entry) const
+		{
+			std::ostringstream path;
+			path << cache_dir_ << "/" << std::hex << std::setfill('0') << std::setw(16) << entry.content_hash[0] << std::setw(16) << entry.content_hash[1] << ".stcache";
+
+			return path.str();
+		}
+
+		//=======================================================================
+		// Load the entry of a source, false when missing or unreadable
+		//=======================================================================
+		bool SourceCache::ReadEntry(SourceEntry& entry) const
+		{
+			fileutil::MappedFile mapped_file;
+			if (!mapped_file.Open(GetEntryPath(entry)))
+				return false;
+
+			const char* cur = mapped_file.GetData();
+			const char* end = cur + mapped_file.GetSize();
+
+			uint32_t magic = 0, version = 0;
+			uint64_t content_hash[2] = { 0, 0 };
+			if (!ReadValue(cur, end, magic) || !ReadValue(cur, end, version) || !ReadValue(cur, end, content_hash) ||
+				magic != KSOURCE_CACHE_MAGIC || version != KSOURCE_CACHE_VERSION ||
+				content_hash[0] != entry.content_hash[0] || content_hash[1] != entry.content_hash[1])
+				return false;
+
+			uint32_t count = 0;
+			if (!ReadValue(cur, end, count))
+				return false;
+			entry.zonedata.resize(count);
+			for (auto& zone_data : entry.zonedata)
+			{
+				if (!ReadString(cur, end, zone_data.name) || !ReadString(cur, end, zone_data.gmt_offset) || !ReadString(cur, end, zone_data.rule) ||
+					!ReadString(cur, end, zone_data.format) || !ReadString(cur, end, zone_data.until))
+					return false;
+			}
+
+			if (!ReadValue(cur, end, count))
+				return false;
+			entry.ruledata.resize(count);
+			for (auto& rule_data : entry.ruledata)
+			{
+				if (!ReadString(cur, end, rule_data.name) || !ReadString(cur, end, rule_data.from) || !ReadString(cur, end, rule_data.to) ||
+					!ReadString(cur, end, rule_data.in) || !ReadString(cur, end, rule_data.on) || !ReadString(cur, end, rule_data.at) ||
+					!ReadString(cur, end, rule_data.save) || !ReadString(cur, end, rule_data.letters))
+					return false;
+			}
+
+			if (!ReadValue(cur, end, count))
+				return false;
+			entry.linkdata.resize(count);
+			for (auto& link_data : entry.linkdata)
+			{
+				if (!ReadString(cur, end, link_data.ref_zone_name) || !ReadString(cur, end, link_data.target_zone_name))
+					return false;
+			}
+
+			return ReadRecords(cur, end, entry.zones) && ReadRecords(cur, end, entry.rules) &&
+				ReadValue(cur, end, entry.rule_hash) && ReadRecords(cur, end, entry.post_zones) && cur == end;
+		}
+
+		//=======================================================================
+		// Write the entry of a source
+		//=======================================================================
+		bool SourceCache::WriteEntry(const SourceEntry& entry) const
+		{
+			std::vector<char> buffer;
+			WriteValue(buffer, KSOURCE_CACHE_MAGIC);
+			WriteValue(buffer, KSOURCE_CACHE_VERSION);
+			WriteValue(buffer, entry.content_hash);
+
+			WriteValue(buffer, static_cast<uint32_t>(entry.zonedata.size()));
+			for (const auto& zone_data : entry.zonedata)
+			{
+				WriteString(buffer, zone_data.name);
+				WriteString(buffer, zone_data.gmt_offset);
+				WriteString(buffer, zone_data.rule);
+				WriteString(buffer, zone_data.format);
+				WriteString(buffer, zone_data.until);
+			}
+
+			WriteValue(buffer, static_cast<uint32_t>(entry.ruledata.size()));
+			for (const auto& rule_data : entry.ruledata)
+			{
+				WriteString(buffer, rule_data.name);
+				WriteString(buffer, rule_data.from);
+				WriteString(buffer, rule_data.to);
+				WriteString(buffer, rule_data.in);
+				WriteString(buffer, rule_data.on);
+				WriteString(buffer, rule_data.at);
+				WriteString(buffer, rule_data.save);
+				WriteString(buffer, rule_data.letters);
+			}
+
+			WriteValue(buffer, static_cast<uint32_t>(entry.linkdata.size()));
+			for (const auto& link_data : entry.linkdata)
+			{
+				WriteString(buffer, link_data.ref_zone_name);
+				WriteString(buffer, link_data.target_zone_name);
+			}
+
+			WriteRecords(buffer, entry.zones);
+			WriteRecords(buffer, entry.rules);
+			WriteValue(buffer, entry.rule_hash);
+			WriteRecords(buffer, entry.post_zones);
+
+			std::string path = GetEntryPath(entry);
+			std::string tmp_path = path + ".tmp";
+			{
+				std::ofstream out_file(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+				out_file.write(buffer.data(), buffer.size());
+				if (!out_file)
+					return false;
+			}
+
+			std::error_code error;
+			std::filesystem::rename(tmp_path, path, error);
+
+			return !error;
+		}
+
+		//=======================================================================
+		// Hash the contents of every rule group the source's zones use, the
+		// post processed zones only depend on these and on the zones
+		//=======================================================================
+		void SourceCache::HashRules(const SourceEntry& entry, tz::TzdbConnectorInterface& tzdb_connector, uint64_t (&rule_hash)[2]) const
+		{
+			// fields one by one, padding bytes are never initialized
+			std::vector<char> buffer;
+			const auto* rule_arr = tzdb_connector.GetRuleHandle();
+
+			for (const auto& zone : entry.zones)
+			{
+				if (zone.rule_id == 0)
+					continue;
+
+				auto rules = tzdb_connector.FindRules(zone.rule_id);
+				WriteValue(buffer, zone.rule_id);
+				WriteValue(buffer, rules.size);
+
+				for (int i = rules.first; i < rules.first + rules.size; ++i)
+				{
+					const auto& rule = rule_arr[i];
+					WriteValue(buffer, rule.from_year);
+					WriteValue(buffer, rule.to_year);
+					WriteValue(buffer, rule.month);
+					WriteValue(buffer, rule.day);
+					WriteValue(buffer, rule.day_type);
+					WriteValue(buffer, rule.at_time);
+					WriteValue(buffer, rule.at_type);
+					WriteValue(buffer, rule.offset);
+					WriteValue(buffer, rule.letter);
+				}
+			}
+
+			MurmurHash3_x64_128(buffer.data(), static_cast<int>(buffer.size()), KSOURCE_CACHE_VERSION, rule_hash);
+		}
+	}
+}
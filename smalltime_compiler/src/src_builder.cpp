@@ -96,9 +96,8 @@ namespace smalltime
 			out_file << "\nstatic const RD KMaxRuleOffset = " << tzdb_meta.max_rule_offset << ";";
 			out_file << "\nstatic const int KMaxZoneSize = " << tzdb_meta.max_zone_size << ";";
 			out_file << "\nstatic const int KMaxRuleSize = " << tzdb_meta.max_rule_size << ";";
-
-			out_file << "\n\nthread_local static std::array<RD, KMaxZoneSize * 3> zone_pool;";
-			out_file << "\nthread_local static std::array<RD, KMaxRuleSize * 3> rule_pool;";
+			out_file << "\nstatic const int KMaxYearRuleSize = " << tzdb_meta.max_year_rule_size << ";";
+			out_file << "\nstatic const int KTransitionHorizon = " << tzdb_meta.transition_horizon << ";";
 
 			out_file << "\n\nstatic constexpr std::array<Zone," << vec_zone.size() << "> KZoneArray = {\n";
 			// Add zones
@@ -128,6 +127,94 @@ namespace smalltime
 			return true;
 		}
 
+		//=================================================
+		// Add precompiled transitions to file
+		//==================================================
+		bool SrcBuilder::BuildTransitions(const std::vector<tz::UtcTransition>& vec_transition, const std::vector<tz::UtcTransitions>& vec_transition_lookup,
+			const std::vector<uint64_t>& vec_abbrev, std::ofstream& out_file)
+		{
+			if (!out_file)
+				return false;
+
+			out_file << "\nstatic constexpr std::array<UtcTransition," << vec_transition.size() << "> KUtcTransitionArray = {\n";
+			// Add transitions
+			for (const auto& utc_transition : vec_transition)
+				InsertUtcTransition(utc_transition, out_file);
+
+			out_file << "\n};\n";
+			out_file << "\nstatic constexpr std::array<UtcTransitions," << vec_transition_lookup.size() << "> KUtcTransitionLookupArray = {\n";
+			// Add transitions
+			for (const auto& utc_transitions : vec_transition_lookup)
+				InsertUtcTransitionSearch(utc_transitions, out_file);
+
+			out_file << "\n};\n";
+			out_file << "\nstatic constexpr std::array<uint64_t," << vec_abbrev.size() << "> KAbbrevArray = {\n";
+			// Add abbreviations
+			for (const auto& abbrev : vec_abbrev)
+				out_file << abbrev << ",\n";
+
+			out_file << "\n};\n";
+
+			return true;
+		}
+
+		//==================================================
+		// Add zone name perfect hash to file
+		//==================================================
+		bool SrcBuilder::BuildZoneIndex(const std::vector<uint32_t>& vec_displacement, const std::vector<tz::ZoneIndexSlot>& vec_slot,
+			const std::vector<char>& vec_name, std::ofstream& out_file)
+		{
+			if (!out_file)
+				return false;
+
+			out_file << "\nstatic constexpr std::array<uint32_t," << vec_displacement.size() << "> KZoneIndexDisplacementArray = {\n";
+			// Add bucket displacements
+			for (const auto& displacement : vec_displacement)
+				out_file << displacement << ",\n";
+
+			out_file << "\n};\n";
+			out_file << "\nstatic constexpr std::array<ZoneIndexSlot," << vec_slot.size() << "> KZoneIndexSlotArray = {\n";
+			// Add slots
+			for (const auto& slot : vec_slot)
+				out_file << "ZoneIndexSlot {" << slot.name_offset << ", " << slot.name_size << ", " << slot.lookup_index << "},\n";
+
+			out_file << "\n};\n";
+			// Names are only letters, digits and /_+- so need no escaping
+			// leading empty literal keeps it well formed when there are no names
+			out_file << "\nstatic constexpr char KZoneIndexNames[] =\n\"\"\n";
+			for (const auto& slot : vec_slot)
+				out_file << "\"" << std::string(vec_name.data() + slot.name_offset, slot.name_size) << "\"\n";
+
+			out_file << ";\n";
+
+			return true;
+		}
+
+		//==================================================
+		// Add active years of rule sets to file
+		//==================================================
+		bool SrcBuilder::BuildRuleYearRanges(const std::vector<tz::RuleYearRange>& vec_year_range, const std::vector<tz::RuleYearRanges>& vec_year_range_lookup,
+			std::ofstream& out_file)
+		{
+			if (!out_file)
+				return false;
+
+			out_file << "\nstatic constexpr std::array<RuleYearRange," << vec_year_range.size() << "> KRuleYearRangeArray = {\n";
+			// Add year ranges
+			for (const auto& year_range : vec_year_range)
+				out_file << "RuleYearRange {" << year_range.from_year << ", " << year_range.to_year << "},\n";
+
+			out_file << "\n};\n";
+			out_file << "\nstatic constexpr std::array<RuleYearRanges," << vec_year_range_lookup.size() << "> KRuleYearRangeLookupArray = {\n";
+			// Add year range lookup
+			for (const auto& year_ranges : vec_year_range_lookup)
+				out_file << "RuleYearRanges {" << year_ranges.rule_id << ", " << year_ranges.first << ", " << year_ranges.size << "},\n";
+
+			out_file << "\n};\n";
+
+			return true;
+		}
+
 		//==================================================
 		// Add single rule object into file
 		//==================================================
@@ -191,5 +278,39 @@ namespace smalltime
 			return true;
 		}
 
+		//======================================================
+		// Add single transition object into file
+		//======================================================
+		bool SrcBuilder::InsertUtcTransition(const tz::UtcTransition& utc_transition, std::ofstream& out_file)
+		{
+			if (!out_file)
+				return false;
+
+			// 17 digits should be enough to round trip double
+			out_file << std::setprecision(17);
+
+			out_file << "UtcTransition {" << utc_transition.utc << ", " << utc_transition.offset << ", " << utc_transition.abbrev_index << "}";
+			out_file << ",\n";
+
+			return true;
+		}
+
+		//======================================================
+		// Add single transitions object into file
+		//======================================================
+		bool SrcBuilder::InsertUtcTransitionSearch(const tz::UtcTransitions& utc_transitions, std::ofstream& out_file)
+		{
+			if (!out_file)
+				return false;
+
+			// 17 digits should be enough to round trip double
+			out_file << std::setprecision(17);
+
+			out_file << "UtcTransitions {" << utc_transitions.zone_id << ", " << utc_transitions.first << ", " << utc_transitions.size << ", " << utc_transitions.tail_utc << "}";
+			out_file << ",\n";
+
+			return true;
+		}
+
 	}
 }
\ No newline at end of file
@@ -0,0 +1,417 @@
+#include "../include/transition_generator.h"
+
+#include <basic_datetime.h>
+#include <zone_group.h>
+#include <rule_group.h>
+#include <core_math.h>
+#include <time_math.h>
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+
+namespace smalltime
+{
+	namespace comp
+	{
+		//===========================================
+		// Ctor
+		//===========================================
+		TransitionGenerator::TransitionGenerator(std::shared_ptr<tz::TzdbConnectorInterface> tzdb_connector) : tzdb_connector_(tzdb_connector),
+			vec_zonedata_(nullptr), vec_ruledata_(nullptr), vec_abbrev_(nullptr), horizon_year_(KTRANSITION_HORIZON), horizon_utc_(0.0)
+		{
+
+		}
+
+		//=====================================================================
+		// Expand every zone group into the utc transitions produced by the
+		// zone rules, links share the transitions of their target zone
+		//=====================================================================
+		bool TransitionGenerator::ProcessTransitions(std::vector<tz::UtcTransition>& vec_transition, std::vector<tz::UtcTransitions>& vec_transition_lookup, std::vector<uint64_t>& vec_abbrev,
+			const std::vector<tz::Zone>& vec_zone, const std::vector<tz::Zones>& vec_zone_lookup, const std::vector<ZoneData>& vec_zonedata,
+			const std::vector<RuleData>& vec_ruledata, int horizon_year)
+		{
+			if (vec_zone.empty() || vec_zone_lookup.empty())
+				return false;
+
+			vec_zonedata_ = &vec_zonedata;
+			vec_ruledata_ = &vec_ruledata;
+			vec_abbrev_ = &vec_abbrev;
+			abbrev_index_.clear();
+
+			horizon_year_ = horizon_year;
+			horizon_utc_ = BasicDateTime<>(horizon_year + 1, 1, 1, 0, 0, 0, 0, tz::KTimeType_Utc).GetFixed();
+
+			// zone groups keyed by their first zone
+			std::map<int, tz::UtcTransitions> group_transitions;
+
+			// lookup is sorted by id so the transition lookup is too
+			for (const auto& zones : vec_zone_lookup)
+			{
+				auto group = group_transitions.find(zones.first);
+				if (group == group_transitions.end())
+				{
+					tz::UtcTransitions utc_transitions = { zones.zone_id, static_cast<int>(vec_transition.size()), 0, FindTailUtc(zones) };
+					ProcessZoneGroup(vec_transition, zones, utc_transitions.tail_utc);
+					utc_transitions.size = static_cast<int>(vec_transition.size()) - utc_transitions.first;
+
+					if (!VerifyZoneGroup(vec_transition, utc_transitions, zones))
+						return false;
+
+					group = group_transitions.emplace(zones.first, utc_transitions).first;
+				}
+
+				tz::UtcTransitions utc_transitions = group->second;
+				utc_transitions.zone_id = zones.zone_id;
+				vec_transition_lookup.push_back(utc_transitions);
+			}
+
+			return true;
+		}
+
+		//=========================================================================
+		// Evaluate the zone rules at every instant an offset could change and
+		// keep the instants where it does
+		//=========================================================================
+		void TransitionGenerator::ProcessZoneGroup(std::vector<tz::UtcTransition>& vec_transition, tz::Zones zones, RD tail_utc)
+		{
+			auto zone_handle = tzdb_connector_->GetZoneHandle();
+			int last_zone_index = zones.first + zones.size - 1;
+
+			std::vector<RD> candidates;
+			int first_year = -tz::MAX;
+
+			for (int i = zones.first; i <= last_zone_index; ++i)
+			{
+				const auto& zone = zone_handle[i];
+				int last_year = horizon_year_ + 1;
+
+				if (i < last_zone_index)
+				{
+					RD trans_utc = zone.mb_until_utc + math::MSEC();
+					candidates.push_back(trans_utc);
+					last_year = std::min(BasicDateTime<>(trans_utc, tz::KTimeType_Utc).GetYear() + 1, last_year);
+				}
+
+				if (zone.rule_id > 0)
+					AddCandidates(candidates, zone, first_year, last_year);
+
+				first_year = last_year - 2;
+			}
+
+			std::sort(candidates.begin(), candidates.end());
+			candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+			// offset in effect before any transition
+			UtcOffset cur_offset = { 0.0, 0 };
+			RD prev_rd = candidates.empty() ? 0.0 : candidates.front() - 1.0;
+			FindUtcOffset(prev_rd, zones, cur_offset);
+			vec_transition.push_back({ -tz::DMAX, cur_offset.offset, cur_offset.abbrev_index });
+
+			// the rule group can pick the wrong rule within a millisecond of a
+			// transition, so offsets are sampled clear of the candidate itself
+			const RD settle = math::SEC();
+
+			UtcOffset next_offset = { 0.0, 0 };
+			for (auto rd : candidates)
+			{
+				if (rd >= tail_utc)
+					break;
+
+				if (!FindUtcOffset(rd + settle, zones, next_offset))
+					continue;
+
+				// two changes may fall between candidates, take them in order
+				while (next_offset.offset != cur_offset.offset || next_offset.abbrev_index != cur_offset.abbrev_index)
+				{
+					RD trans_utc = rd;
+					UtcOffset trans_offset = next_offset;
+
+					UtcOffset mb_offset = { 0.0, 0 };
+					if (FindUtcOffset(rd - settle, zones, mb_offset) &&
+						(mb_offset.offset != cur_offset.offset || mb_offset.abbrev_index != cur_offset.abbrev_index))
+					{
+						// the change is not at a candidate, narrow it down to the millisecond
+						RD lo = prev_rd + settle;
+						RD hi = rd - settle;
+						while (hi - lo > math::MSEC())
+						{
+							RD mid = lo + (hi - lo) / 2.0;
+							UtcOffset mid_offset = { 0.0, 0 };
+							if (FindUtcOffset(mid, zones, mid_offset) &&
+								(mid_offset.offset != cur_offset.offset || mid_offset.abbrev_index != cur_offset.abbrev_index))
+							{
+								hi = mid;
+								trans_offset = mid_offset;
+							}
+							else
+							{
+								lo = mid;
+							}
+						}
+
+						trans_utc = hi;
+					}
+
+					vec_transition.push_back({ trans_utc, trans_offset.offset, trans_offset.abbrev_index });
+					cur_offset = trans_offset;
+					prev_rd = trans_utc;
+				}
+
+				prev_rd = rd;
+			}
+		}
+
+		//=========================================================================
+		// Add every instant a rule of the zone could take effect, with each
+		// possible previous save for wall clock rules
+		//=========================================================================
+		void TransitionGenerator::AddCandidates(std::vector<RD>& candidates, const tz::Zone& zone, int first_year, int last_year)
+		{
+			auto rule_handle = tzdb_connector_->GetRuleHandle();
+			auto rules = tzdb_connector_->FindRules(zone.rule_id);
+			if (rules.first == -1)
+				return;
+
+			int min_year = tz::MAX;
+			std::vector<RD> saves = { 0.0 };
+			for (int i = rules.first; i < rules.first + rules.size; ++i)
+			{
+				min_year = std::min(rule_handle[i].from_year, min_year);
+				if (std::find(saves.begin(), saves.end(), rule_handle[i].offset) == saves.end())
+					saves.push_back(rule_handle[i].offset);
+			}
+
+			for (int year = std::max(min_year - 1, first_year); year <= last_year; ++year)
+			{
+				// the rule group picks its rules by year
+				candidates.push_back(BasicDateTime<>(year, 1, 1, 0, 0, 0, 0, tz::KTimeType_Utc).GetFixed());
+
+				for (int i = rules.first; i < rules.first + rules.size; ++i)
+				{
+					const auto& rule = rule_handle[i];
+					if (year < rule.from_year || year > rule.to_year)
+						continue;
+
+					// same arithmetic as the rule group so the instants match exactly
+					RD rule_transition = CalcTransitionFast(rule, year).GetFixed();
+					switch (rule.at_type)
+					{
+					case tz::KTimeType_Wall:
+						for (auto save : saves)
+							candidates.push_back(rule_transition - save - zone.zone_offset);
+						break;
+					case tz::KTimeType_Std:
+						candidates.push_back(rule_transition - zone.zone_offset);
+						break;
+					case tz::KTimeType_Utc:
+						candidates.push_back(rule_transition);
+						break;
+					}
+				}
+			}
+		}
+
+		//=========================================================================
+		// Check the transitions of a zone group against the zone rules either
+		// side of every transition and twice a month up to the tail, a missed
+		// candidate shows up as a disagreement
+		//=========================================================================
+		bool TransitionGenerator::VerifyZoneGroup(const std::vector<tz::UtcTransition>& vec_transition, const tz::UtcTransitions& utc_transitions, tz::Zones zones)
+		{
+			// same margin ProcessZoneGroup samples at
+			const RD settle = math::SEC();
+			const auto first = vec_transition.begin() + utc_transitions.first;
+			const auto last = first + utc_transitions.size;
+
+			std::vector<RD> samples;
+			for (auto it = first + 1; it < last; ++it)
+			{
+				samples.push_back(it->utc - settle);
+				samples.push_back(it->utc + settle);
+			}
+
+			for (int year = KTRANSITION_VERIFY_FIRST_YEAR; year <= horizon_year_; ++year)
+			{
+				for (int month = 1; month <= 12; ++month)
+				{
+					samples.push_back(BasicDateTime<>(year, month, 1, 12, 0, 0, 0, tz::KTimeType_Utc).GetFixed());
+					samples.push_back(BasicDateTime<>(year, month, 15, 12, 0, 0, 0, tz::KTimeType_Utc).GetFixed());
+				}
+			}
+
+			for (auto rd : samples)
+			{
+				if (rd >= utc_transitions.tail_utc)
+					continue;
+
+				// last transition at or before rd, the first one covers everything before it
+				auto next = std::upper_bound(first + 1, last, rd, [](RD lhs, const tz::UtcTransition& rhs)
+				{
+					return lhs < rhs.utc;
+				});
+				const auto& table = *(next - 1);
+
+				// too close to a transition to tell which side the rules put it on
+				if ((next != last && next->utc - rd < settle) || (next - 1 != first && rd - table.utc < settle))
+					continue;
+
+				UtcOffset utc_offset = { 0.0, 0 };
+				if (!FindUtcOffset(rd, zones, utc_offset))
+					continue;
+
+				if (utc_offset.offset != table.offset || utc_offset.abbrev_index != table.abbrev_index)
+				{
+					BasicDateTime<> utc_dt(rd, tz::KTimeType_Utc);
+					std::cout << "ERROR: precompiled transitions of zone " << zones.zone_id << " disagree with its rules at " << utc_dt.GetYear() << "/" << utc_dt.GetMonth()
+						<< "/" << utc_dt.GetDay() << "T" << utc_dt.GetHour() << ":" << utc_dt.GetMinute() << ":" << utc_dt.GetSecond() << " utc ..." << std::endl;
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		//==================================================================
+		// Offset from utc and abbreviation the same way the runtime
+		// evaluates it, returns false if the zone rules throw
+		//==================================================================
+		bool TransitionGenerator::FindUtcOffset(RD rd, tz::Zones zones, UtcOffset& utc_offset)
+		{
+			try
+			{
+				BasicDateTime<> iso_dt(rd, tz::KTimeType_Utc);
+
+				tz::ZoneGroup zg(zones, tzdb_connector_->GetZoneHandle());
+
+				const tz::Zone* prev_zone = nullptr;
+				const tz::Zone* cur_zone = nullptr;
+				std::tie(prev_zone, cur_zone) = zg.FindActiveAndPreviousZone(iso_dt, Choose::KError);
+
+				if (!cur_zone)
+					return false;
+
+				const tz::Rule* active_rule = nullptr;
+				if (cur_zone->rule_id > 0)
+				{
+					auto rules = tzdb_connector_->FindRules(cur_zone->rule_id);
+					tz::RuleGroup rg(rules, tzdb_connector_->GetRuleHandle(), cur_zone, prev_zone);
+					active_rule = rg.FindActiveRule(iso_dt, Choose::KError);
+				}
+
+				utc_offset.offset = cur_zone->zone_offset + (active_rule ? active_rule->offset : 0.0);
+				utc_offset.abbrev_index = GetAbbrevIndex(cur_zone, active_rule);
+			}
+			catch (const std::exception&)
+			{
+				return false;
+			}
+
+			return true;
+		}
+
+		//==================================================================
+		// Transitions are complete if nothing changes past the horizon,
+		// otherwise the zone rules take over at the horizon
+		//==================================================================
+		RD TransitionGenerator::FindTailUtc(tz::Zones zones)
+		{
+			auto zone_handle = tzdb_connector_->GetZoneHandle();
+			int last_zone_index = zones.first + zones.size - 1;
+
+			for (int i = zones.first; i < last_zone_index; ++i)
+			{
+				if (zone_handle[i].mb_until_utc + math::MSEC() >= horizon_utc_)
+					return horizon_utc_;
+			}
+
+			const auto& last_zone = zone_handle[last_zone_index];
+			if (last_zone.rule_id > 0)
+			{
+				auto rule_handle = tzdb_connector_->GetRuleHandle();
+				auto rules = tzdb_connector_->FindRules(last_zone.rule_id);
+
+				for (int i = rules.first; i < rules.first + rules.size; ++i)
+				{
+					if (rule_handle[i].to_year > horizon_year_)
+						return horizon_utc_;
+				}
+			}
+
+			return tz::DMAX;
+		}
+
+		//==================================================================
+		// Expand the zone format with the rule letters and store it once
+		//==================================================================
+		uint32_t TransitionGenerator::GetAbbrevIndex(const tz::Zone* zone, const tz::Rule* rule)
+		{
+			auto zone_index = static_cast<std::size_t>(zone - tzdb_connector_->GetZoneHandle());
+
+			std::string format;
+			if (zone_index < vec_zonedata_->size())
+			{
+				format = (*vec_zonedata_)[zone_index].format;
+			}
+			else
+			{
+				// generated zones have no source data, strip the packing
+				format = math::Unpack8Chars(zone->abbrev);
+				format.erase(format.find_last_not_of('0') + 1);
+			}
+
+			std::string letters;
+			RD save = zone->rule_id > 0 ? 0.0 : zone->mb_rule_offset;
+			if (rule)
+			{
+				letters = (*vec_ruledata_)[rule - tzdb_connector_->GetRuleHandle()].letters;
+				save = rule->offset;
+			}
+
+			if (letters == "-")
+				letters.clear();
+
+			// standard/daylight pair e.g. GMT/BST
+			auto slash = format.find('/');
+			if (slash != std::string::npos)
+				format = (save != 0.0) ? format.substr(slash + 1) : format.substr(0, slash);
+
+			auto letters_pos = format.find("%s");
+			if (letters_pos != std::string::npos)
+				format.replace(letters_pos, 2, letters);
+
+			auto abbrev = abbrev_index_.find(format);
+			if (abbrev != abbrev_index_.end())
+				return abbrev->second;
+
+			// pad with nulls so the runtime can read it back as a c string
+			std::string padded = format;
+			padded.resize(8, '\0');
+
+			uint32_t abbrev_index = static_cast<uint32_t>(vec_abbrev_->size());
+			vec_abbrev_->push_back(math::Pack8Chars(padded));
+			abbrev_index_.emplace(format, abbrev_index);
+
+			return abbrev_index;
+		}
+
+		//===========================================================
+		// Calculate rule transiton without time type checking
+		//===========================================================
+		BasicDateTime<> TransitionGenerator::CalcTransitionFast(const tz::Rule& rule, int year)
+		{
+			std::array<int, 4> hms = math::HmsFromFixed(rule.at_time);
+
+			switch (rule.day_type)
+			{
+			case tz::KDayType_SunGE:
+				return BasicDateTime<>(year, rule.month, rule.day, hms[0], hms[1], hms[2], hms[3], RS::KSunOnOrAfter, rule.at_type);
+			case tz::KDayType_LastSun:
+				return BasicDateTime<>(year, rule.month, 1, hms[0], hms[1], hms[2], hms[3], RS::KLastSun, rule.at_type);
+			default:
+				return BasicDateTime<>(year, rule.month, rule.day, hms[0], hms[1], hms[2], hms[3], rule.at_type);
+			}
+		}
+
+	}
+}
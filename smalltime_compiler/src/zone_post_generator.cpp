@@ -24,18 +24,27 @@ namespace smalltime
 		//=====================================================
 		bool ZonePostGenerator::ProcessZones(std::vector<tz::Zone>& vec_zone)
 		{
+			return ProcessZones(vec_zone, 0, static_cast<int>(vec_zone.size()));
+		}
+
+		//=====================================================
+		// Process range of zones - add transition data
+		//=====================================================
+		bool ZonePostGenerator::ProcessZones(std::vector<tz::Zone>& vec_zone, int first, int size)
+		{
+			if (first < 0 || size < 0 || first + size > static_cast<int>(vec_zone.size()))
+				return false;
+
 			// util_wall stores temp until 
 			//until_utc stores temp rule offset
-			auto zone_arr_size = vec_zone.size();
-
-			for (int i = 0; i < zone_arr_size; ++i)
+			for (int i = first; i < first + size; ++i)
 			{
 				auto zt = CalcZoneData(i, vec_zone);
 
-				vec_zone[i].next_zone_offset = zt.next_zoffset_;
-				vec_zone[i].mb_until_utc = zt.mb_trans_utc_;
-				vec_zone[i].mb_rule_offset = zt.cur_roffset_;
-				vec_zone[i].trans_rule_offset = zt.next_roffset_;
+				vec_zone[i].next_zone_offset = math::FixedFromTicks(zt.next_zoffset_);
+				vec_zone[i].mb_until_utc = math::FixedFromTicks(zt.mb_trans_utc_);
+				vec_zone[i].mb_rule_offset = math::FixedFromTicks(zt.cur_roffset_);
+				vec_zone[i].trans_rule_offset = math::FixedFromTicks(zt.next_roffset_);
 			}
 
 			return true;
@@ -54,13 +54,13 @@ namespace smalltime
 	//==================================
 	// Init static member
 	//==================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	T BasicDateTime<T>::KCHRONOLOGY;
 
 	//================================================
 	// Ctor - create date from fields
 	//================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	BasicDateTime<T>::BasicDateTime(int year, int month, int day, int hour, int minute, int second, int millisecond, tz::TimeType tmType) noexcept
 	{
 		fixed_ = KCHRONOLOGY.FixedFromYmd(year, month, day);
@@ -74,7 +74,7 @@ namespace smalltime
 	//====================================================
 	// Ctor - create date from fields relative to
 	//====================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	BasicDateTime<T>::BasicDateTime(int year, int month, int day, int hour, int minute, int second, int millisecond, RS rel, tz::TimeType tmType) noexcept
 	{
 		fixed_ = KCHRONOLOGY.FixedFromYmd(year, month, day);
@@ -90,7 +90,7 @@ namespace smalltime
 	//====================================================
 	// Ctor - create date from fixed date
 	//====================================================
-	template <typename T = chrono::IsoChronology>
+	template <typename T>
 	BasicDateTime<T>::BasicDateTime(RD rd, tz::TimeType tmType) noexcept
 	{
 		fixed_ = rd;
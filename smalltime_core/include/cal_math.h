@@ -43,16 +43,64 @@ namespace smalltime
 		// days and weeks between to fixed points
 		int FixedWeeksBetween(RD rd0, RD rd1);
 		int FixedDaysBetween(RD rd0, RD rd1);
-		// day of week utility functions
-		RD KDayOnOrBefore(int k, RD rdate);
-		RD KDayOnOrAfter(int k, RD rdate);
 
-		RD KDayAfter(int k, RD rdate);
-		RD KDayBefore(int k, RD rdate);
+		//==========================================================================
+		// find occurrence of the Nth day of a weekly cycle on or before rdate
+		//==========================================================================
+		constexpr RD KDayOnOrBefore(int k, RD rdate)
+		{
+			//the R.D epoch is Mon 1 so 0 is on a Sun
+			int dayZero = 0;
+			int mCycle = 7;
+
+			return rdate - ConstFlMod((rdate + dayZero - k), mCycle);
+		}
+
+		//=========================================================================
+		// find occurrence of the Nth day of a weekly cycle after rdate
+		//==========================================================================
+		constexpr RD KDayAfter(int k, RD rdate)
+		{
+			return KDayOnOrBefore(k, rdate + 7.0);
+		}
+
+		//==========================================================================
+		// find occurrence of the Nth day of a weekly cycle before rdate
+		//==========================================================================
+		constexpr RD KDayBefore(int k, RD rdate)
+		{
+			return KDayOnOrBefore(k, rdate - 1.0);
+		}
 
-		RD KDayNearest(int k, RD rdate);
-		// Nth occurence of K day of week from rdate
-		RD NthKDay(int k, int n, RD rdate);
+		//==========================================================================
+		// find occurrence of the Nth day of a weekly cycle nearest rdate
+		//==========================================================================
+		constexpr RD KDayNearest(int k, RD rdate)
+		{
+			return KDayOnOrBefore(k, rdate + 3.0);
+		}
+
+		//==========================================================================
+		// find occurrence of the Nth day of a weekly cycle on or after rdate
+		//==========================================================================
+		constexpr RD KDayOnOrAfter(int k, RD rdate)
+		{
+			return KDayAfter(k, rdate - 1.0);
+		}
+
+		//===================================================================================
+		// find Nth occurence of the kday from rdate, N is pos for after and neg for before
+		//===================================================================================
+		constexpr RD NthKDay(int k, int n, RD rdate)
+		{
+			//if first occurence falls on k it is counted
+			if (n > 0)
+				return KDayBefore(k, rdate) + (7 * n);
+			else if (n < 0)
+				return KDayAfter(k, rdate) + (7 * n);
+			else
+				return rdate;
+		}
 
 	}
 }
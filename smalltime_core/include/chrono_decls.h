@@ -4,6 +4,7 @@
 
 #include "core_decls.h"
 #include <array>
+#include <cmath>
 
 namespace smalltime
 {
@@ -28,37 +29,9 @@ namespace smalltime
 			//	OPT_BASE_MONTH_Days = std::floor((1.0 / 12.0) * (367 * dMonth - 362))
 			static constexpr std::array<int, 12> KOPT_BASE_MONTH_DAYS{ 0, 31, 61, 92, 122, 153, 183, 214, 245, 275, 306, 336 };
 			//	STD_YEAR_BIAS = Floor(STD_MONTH_BIAS[month - 1] / 10.0)
-			static const std::array<double, 12> KSTD_YEAR_BIAS
-			{
-				std::floor(KSTD_MONTH_BIAS[0] / 10.0),
-				std::floor(KSTD_MONTH_BIAS[1] / 10.0),
-				std::floor(KSTD_MONTH_BIAS[2] / 10.0),
-				std::floor(KSTD_MONTH_BIAS[3] / 10.0),
-				std::floor(KSTD_MONTH_BIAS[4] / 10.0),
-				std::floor(KSTD_MONTH_BIAS[5] / 10.0),
-				std::floor(KSTD_MONTH_BIAS[6] / 10.0),
-				std::floor(KSTD_MONTH_BIAS[7] / 10.0),
-				std::floor(KSTD_MONTH_BIAS[8] / 10.0),
-				std::floor(KSTD_MONTH_BIAS[9] / 10.0),
-				std::floor(KSTD_MONTH_BIAS[10] / 10.0),
-				std::floor(KSTD_MONTH_BIAS[11] / 10.0)
-			};
+			static constexpr std::array<double, 12> KSTD_YEAR_BIAS{ 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 			// YEAR_CACHE = Floor((month + 9.0) / 12.0)
-			static const std::array<double, 12> KYEAR_CACHE
-			{
-				std::floor((1 + 9.0) / 12.0),
-				std::floor((2 + 9.0) / 12.0),
-				std::floor((3 + 9.0) / 12.0),
-				std::floor((4 + 9.0) / 12.0),
-				std::floor((5 + 9.0) / 12.0),
-				std::floor((6 + 9.0) / 12.0),
-				std::floor((7 + 9.0) / 12.0),
-				std::floor((8 + 9.0) / 12.0),
-				std::floor((9 + 9.0) / 12.0),
-				std::floor((10 + 9.0) / 12.0),
-				std::floor((11 + 9.0) / 12.0),
-				std::floor((12 + 9.0) / 12.0)
-			};
+			static constexpr std::array<double, 12> KYEAR_CACHE{ 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
 
 		}
 	}
@@ -3,6 +3,7 @@
 #define _COREDECLS_
 
 #include <array>
+#include <cinttypes>
 
 namespace smalltime
 {
@@ -10,6 +11,9 @@ namespace smalltime
 	// R.D = Rata Die from "Calendrical Calculations"
 	using RD = double;
 
+	// Fixed point form of R.D, whole milliseconds since R.D. 0
+	using RDTicks = int64_t;
+
 	// Used for specifying a date-time relative to another
 	enum class RS
 	{
@@ -63,6 +67,16 @@ namespace smalltime
 		KError
 	};
 
+	// Outcome of the non-throwing conversions, one per exception they stand in for
+	enum class Status
+	{
+		KOk,
+		KInvalidField,
+		KInvalidTimeZone,
+		KAmbigMulti,
+		KAmbigNone
+	};
+
 }
 
 #endif // !_CORECONSTANTS_
@@ -6,6 +6,7 @@
 #include "float_util.h"
 #include <cctype>
 #include <cmath>
+#include <cstddef>
 
 namespace smalltime
 {
@@ -51,6 +52,52 @@ namespace smalltime
 			return n& (3);
 		}
 
+		//=========================================================================
+		// std::floor usable in constant expressions, whole values, infinities
+		// and NaN come back unchanged so the sign of zero is kept
+		//=========================================================================
+		inline constexpr double ConstFloor(double x)
+		{
+			// every double of magnitude 2^52 and up is whole
+			if (!(x > -4503599627370496.0 && x < 4503599627370496.0))
+				return x;
+
+			double whole = static_cast<double>(static_cast<int64_t>(x));
+			if (whole == x)
+				return x;
+
+			return whole > x ? whole - 1.0 : whole;
+		}
+
+		//=========================================================================
+		// std::round usable in constant expressions, halves round away from 0
+		//=========================================================================
+		inline constexpr double ConstRound(double x)
+		{
+			double abs_x = x < 0.0 ? -x : x;
+			double whole = ConstFloor(abs_x);
+			if (abs_x - whole >= 0.5)
+				whole += 1.0;
+
+			return x < 0.0 ? -whole : whole;
+		}
+
+		//=========================================================================
+		// FlMod usable in constant expressions
+		//=========================================================================
+		inline constexpr double ConstFlMod(double x, double y)
+		{
+			return x - y * ConstFloor(x / y);
+		}
+
+		//=========================================================================
+		// Integer division rounding down, the divisor must be positive
+		//=========================================================================
+		inline constexpr int64_t FloorDiv(int64_t x, int64_t y)
+		{
+			return (x >= 0 ? x : x - (y - 1)) / y;
+		}
+
 		//==============================================
 		//  ASTOR - Arc-seconds to radians
 		//==============================================
@@ -110,6 +157,8 @@ namespace smalltime
 	
 		// hash string to create unique ID
 		uint32_t GetUniqueID(const std::string& str);
+		// CRC-32 (IEEE 802.3) checksum of a block of bytes
+		uint32_t Crc32(const void* data, std::size_t size);
 		// utility functions to store and extract characters from integers
 		uint32_t Pack4Chars(std::string str);
 		uint64_t Pack8Chars(std::string str);
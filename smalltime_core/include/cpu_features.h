@@ -0,0 +1,19 @@
+#pragma once
+#ifndef _CPU_FEATURES_
+#define _CPU_FEATURES_
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SMALLTIME_X86 1
+#endif
+
+namespace smalltime
+{
+	namespace cpu
+	{
+		// Instruction sets usable by the batch kernels, checked once at runtime
+		bool HasSse41();
+		bool HasAvx2();
+	}
+}
+
+#endif
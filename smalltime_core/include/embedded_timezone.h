@@ -0,0 +1,193 @@
+#pragma once
+#ifndef _EMBEDDED_TIMEZONE_
+#define _EMBEDDED_TIMEZONE_
+
+#include "core_decls.h"
+#include "tz_decls.h"
+#include "time_math.h"
+#include "iso_chronology.h"
+#include "basic_datetime.h"
+#include "smalltime_exceptions.h"
+#include "tzdb_literals.h"
+
+namespace smalltime
+{
+	namespace tz
+	{
+		//=====================================================================
+		// Offsets of zone literals evaluated over the precompiled utc
+		// transitions of the embedded tzdb, so moments known at compile time
+		// convert at compile time, e.g.
+		// constexpr RDTicks KOPEN = UtcTicksFromLocal(SMALLTIME_ZONE("America/New_York"), 2024, 3, 11, 9, 30, 0, 0, Choose::KError);
+		// Zone rules are not evaluated, moments past the tail of the
+		// precompiled transitions throw InvalidFieldException and so fail
+		// the build when constant evaluated. Utc offsets match TimeZone,
+		// local moments resolve against the same transitions so they round
+		// trip through TicksOffsetFromUtc
+		//=====================================================================
+
+		// Widest a utc offset can be, bounds the transitions a local moment can fall in
+		static constexpr RDTicks KEMBEDDED_MAX_OFFSET_TICKS = math::KTICKS_IN_DAY;
+
+		//=====================================================================
+		// Precompiled transitions of a zone literal, first is -1 when there
+		// are none
+		//=====================================================================
+		constexpr UtcTransitions FindEmbeddedUtcTransitions(const ZoneLiteral& zone_literal)
+		{
+			const uint32_t zone_id = zone_literal.zones.zone_id;
+			int left = 0;
+			int right = static_cast<int>(KUtcTransitionLookupArray.size()) - 1;
+
+			while (left <= right)
+			{
+				int middle = (left + right) / 2;
+				const auto& mid_transitions = KUtcTransitionLookupArray[middle];
+
+				if (mid_transitions.zone_id == zone_id)
+					return mid_transitions;
+				else if (zone_id > mid_transitions.zone_id)
+					left = middle + 1;
+				else
+					right = middle - 1;
+			}
+
+			return{ zone_id, -1, -1, 0.0 };
+		}
+
+		//=====================================================================
+		// Utc ticks a precompiled transition starts at
+		//=====================================================================
+		constexpr RDTicks EmbeddedTransitionTicks(const UtcTransitions& utc_transitions, int index)
+		{
+			return math::ConstTicksFromFixed(KUtcTransitionArray[utc_transitions.first + index].utc);
+		}
+
+		//=====================================================================
+		// Offset ticks of a precompiled transition
+		//=====================================================================
+		constexpr RDTicks EmbeddedOffsetTicks(const UtcTransitions& utc_transitions, int index)
+		{
+			return math::ConstTicksFromFixed(KUtcTransitionArray[utc_transitions.first + index].offset);
+		}
+
+		//=====================================================================
+		// Index of the last transition at or before utc ticks, the first
+		// transition covers everything before it
+		//=====================================================================
+		constexpr int FindEmbeddedTransition(const UtcTransitions& utc_transitions, RDTicks ticks)
+		{
+			int left = 0;
+			int right = utc_transitions.size;
+
+			// first transition after ticks
+			while (left < right)
+			{
+				int middle = (left + right) / 2;
+
+				if (EmbeddedTransitionTicks(utc_transitions, middle) <= ticks)
+					left = middle + 1;
+				else
+					right = middle;
+			}
+
+			return left == 0 ? 0 : left - 1;
+		}
+
+		//=====================================================================
+		// Precompiled transitions covering utc ticks, throws past the tail
+		//=====================================================================
+		constexpr UtcTransitions CheckEmbeddedUtcTransitions(const ZoneLiteral& zone_literal, RDTicks ticks)
+		{
+			auto utc_transitions = FindEmbeddedUtcTransitions(zone_literal);
+
+			if (utc_transitions.first == -1 || ticks >= math::ConstTicksFromFixed(utc_transitions.tail_utc))
+				throw InvalidFieldException("Moment past the precompiled transitions of the embedded tzdb");
+
+			return utc_transitions;
+		}
+
+		//=======================================================
+		// Produce UTC offset in ticks from utc ticks
+		//=======================================================
+		constexpr RDTicks TicksOffsetFromUtc(const ZoneLiteral& zone_literal, RDTicks ticks)
+		{
+			auto utc_transitions = CheckEmbeddedUtcTransitions(zone_literal, ticks);
+
+			return EmbeddedOffsetTicks(utc_transitions, FindEmbeddedTransition(utc_transitions, ticks));
+		}
+
+		//=======================================================
+		// Produce UTC offset in ticks from local ticks
+		//=======================================================
+		constexpr RDTicks TicksOffsetFromLocal(const ZoneLiteral& zone_literal, RDTicks ticks, Choose choose)
+		{
+			// the latest utc moment the local ticks can be
+			auto utc_transitions = CheckEmbeddedUtcTransitions(zone_literal, ticks + KEMBEDDED_MAX_OFFSET_TICKS);
+
+			const int first = FindEmbeddedTransition(utc_transitions, ticks - KEMBEDDED_MAX_OFFSET_TICKS);
+			const int last = FindEmbeddedTransition(utc_transitions, ticks + KEMBEDDED_MAX_OFFSET_TICKS);
+
+			int earliest = -1;
+			int latest = -1;
+			for (int i = first; i <= last; ++i)
+			{
+				// local ticks fall in period i when their utc moment does
+				RDTicks utc_ticks = ticks - EmbeddedOffsetTicks(utc_transitions, i);
+				if (i != 0 && utc_ticks < EmbeddedTransitionTicks(utc_transitions, i))
+					continue;
+
+				if (i + 1 != utc_transitions.size && utc_ticks >= EmbeddedTransitionTicks(utc_transitions, i + 1))
+					continue;
+
+				if (earliest == -1)
+					earliest = i;
+
+				latest = i;
+			}
+
+			if (earliest != -1 && earliest == latest)
+				return EmbeddedOffsetTicks(utc_transitions, earliest);
+
+			if (earliest != -1)
+			{
+				if (choose == Choose::KEarliest)
+					return EmbeddedOffsetTicks(utc_transitions, earliest);
+				else if (choose == Choose::KLatest)
+					return EmbeddedOffsetTicks(utc_transitions, latest);
+
+				const RDTicks start = EmbeddedTransitionTicks(utc_transitions, latest);
+				throw TimeZoneAmbigMultiException(BasicDateTime<>(math::FixedFromTicks(start + EmbeddedOffsetTicks(utc_transitions, latest)), KTimeType_Wall),
+					BasicDateTime<>(math::FixedFromTicks(start + EmbeddedOffsetTicks(utc_transitions, latest - 1) - 1), KTimeType_Wall));
+			}
+
+			// in a gap, the transition skipping over the local ticks
+			int next = first + 1;
+			while (next <= last && EmbeddedTransitionTicks(utc_transitions, next) + EmbeddedOffsetTicks(utc_transitions, next) <= ticks)
+				++next;
+
+			if (choose == Choose::KEarliest)
+				return EmbeddedOffsetTicks(utc_transitions, next - 1);
+			else if (choose == Choose::KLatest)
+				return EmbeddedOffsetTicks(utc_transitions, next);
+
+			const RDTicks start = EmbeddedTransitionTicks(utc_transitions, next);
+			throw TimeZoneAmbigNoneException(BasicDateTime<>(math::FixedFromTicks(start + EmbeddedOffsetTicks(utc_transitions, next - 1) - 1), KTimeType_Wall),
+				BasicDateTime<>(math::FixedFromTicks(start + EmbeddedOffsetTicks(utc_transitions, next)), KTimeType_Wall));
+		}
+
+		//=====================================================================
+		// Utc ticks of local calendar and time fields in a zone
+		//=====================================================================
+		constexpr RDTicks UtcTicksFromLocal(const ZoneLiteral& zone_literal, int year, int month, int day, int hour, int minute, int second,
+			int millisecond, Choose choose)
+		{
+			const chrono::IsoChronology iso;
+			const RDTicks local_ticks = iso.TicksFromYmd(year, month, day) + iso.TicksFromTime(hour, minute, second, millisecond);
+
+			return local_ticks - TicksOffsetFromLocal(zone_literal, local_ticks, choose);
+		}
+	}
+}
+
+#endif
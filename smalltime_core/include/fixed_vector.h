@@ -0,0 +1,85 @@
+#pragma once
+#ifndef _FIXED_VECTOR_
+#define _FIXED_VECTOR_
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace smalltime
+{
+	//=====================================================================
+	// Vector with its storage inline, never allocates and throws when
+	// pushed past its capacity
+	//=====================================================================
+	template <typename T, std::size_t N>
+	class FixedVector
+	{
+	public:
+		FixedVector() : size_(0) {}
+
+		FixedVector(const FixedVector& other) : size_(0)
+		{
+			for (const auto& value : other)
+				push_back(value);
+		}
+
+		FixedVector& operator=(const FixedVector& other)
+		{
+			if (this != &other)
+			{
+				clear();
+				for (const auto& value : other)
+					push_back(value);
+			}
+
+			return *this;
+		}
+
+		~FixedVector() { clear(); }
+
+		template <typename... Args>
+		void emplace_back(Args&&... args)
+		{
+			if (size_ == N)
+				throw std::runtime_error("Fixed vector capacity exceeded");
+
+			new (&storage_[size_]) T(std::forward<Args>(args)...);
+			++size_;
+		}
+
+		void push_back(const T& value) { emplace_back(value); }
+
+		void clear()
+		{
+			for (auto& value : *this)
+				value.~T();
+
+			size_ = 0;
+		}
+
+		std::size_t size() const { return size_; }
+		bool empty() const { return size_ == 0; }
+		static constexpr std::size_t capacity() { return N; }
+
+		T& operator[](std::size_t index) { return data()[index]; }
+		const T& operator[](std::size_t index) const { return data()[index]; }
+
+		T* begin() { return data(); }
+		T* end() { return data() + size_; }
+		const T* begin() const { return data(); }
+		const T* end() const { return data() + size_; }
+
+	private:
+		T* data() { return std::launder(reinterpret_cast<T*>(storage_)); }
+		const T* data() const { return std::launder(reinterpret_cast<const T*>(storage_)); }
+
+		// left uninitialised, elements are constructed as they are pushed
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_[N];
+		std::size_t size_;
+	};
+}
+
+#endif
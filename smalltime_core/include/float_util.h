@@ -4,6 +4,7 @@
 
 #include <iostream>
 #include <cfloat>
+#include <cmath>
 #include <cinttypes>
 #include <assert.h>
 #include <cstdlib>
@@ -218,7 +219,7 @@ inline bool AlmostEqualUlps(double A, double B, int maxUlpsDiff)
 	}
 
 	// Find the difference in ULPs.
-	long long ulpsDiff = abs(uA.i - uB.i);
+	long long ulpsDiff = std::llabs(uA.i - uB.i);
 
 	if (ulpsDiff <= static_cast<long long>(maxUlpsDiff))
 		return true;
@@ -258,7 +259,7 @@ inline bool AlmostEqualUlpsAndAbs(double A, double B,
 		return false;
 
 	// Find the difference in ULPs.
-	int ulpsDiff = abs(uA.i - uB.i);
+	long long ulpsDiff = std::llabs(uA.i - uB.i);
 	if (ulpsDiff <= maxUlpsDiff)
 		return true;
 
@@ -3,30 +3,53 @@
 #define _ISOCHRONOLOGY_
 
 #include "core_decls.h"
+#include "core_math.h"
+#include "cal_math.h"
+#include "chrono_decls.h"
+#include "time_math.h"
+#include "iso_chronology_batch.h"
+#include <cinttypes>
+#include <cstddef>
 
 namespace smalltime
 {
 
 	namespace chrono
 	{
+		static constexpr RD KISO_EPOCH = 1.0;
+
+		//=====================================================================
+		// Proleptic gregorian calendar. Conversions between fields and
+		// whole days are constexpr integer arithmetic, so date literals fold
+		// at compile time, e.g. constexpr RD KCUTOFF = IsoChronology().FixedFromYmd(2020, 1, 1)
+		//=====================================================================
 		class IsoChronology
 		{
 		public:
-			RD FixedFromYmd(int year, int month, int day) const;
-			RD FixedFromYwd(int year, int month, int day) const;
-			RD FixedFromYd(int year, int day) const;
+			constexpr RD FixedFromYmd(int year, int month, int day) const;
+			constexpr RD FixedFromYwd(int year, int month, int day) const;
+			constexpr RD FixedFromYd(int year, int day) const;
 
-			std::array<int, 3> YmdFromFixed(RD rd) const;
+			constexpr std::array<int, 3> YmdFromFixed(RD rd) const;
 			std::array<int, 3> YwdFromFixed(RD rd) const;
 			std::array<int, 2> YdFromFixed(RD rd) const;
+
+			// Batch YMD of n values, an AVX2 or SSE4.1 kernel is picked at runtime
+			void YmdFromFixed(const RD* rd, int32_t* year, int32_t* month, int32_t* day, std::size_t n) const;
 			
 			RD FixedRelativeTo(RD rd, RS rel) const;
 
-			RD FixedFromTime(int hour, int minute, int second, int milli) const;
+			constexpr RD FixedFromTime(int hour, int minute, int second, int milli) const;
 			std::array<int, 4> TimeFromFixed(RD rd) const;
 
+			// Exact integer forms of the above
+			constexpr RDTicks TicksFromYmd(int year, int month, int day) const;
+			constexpr std::array<int, 3> YmdFromTicks(RDTicks ticks) const;
+			constexpr RDTicks TicksFromTime(int hour, int minute, int second, int milli) const;
+			std::array<int, 4> TimeFromTicks(RDTicks ticks) const;
+
 			int WeekOfMonth(const std::array<int, 3>& ywd, RD rd) const;
-			bool IsLeapYear(int year) const;
+			constexpr bool IsLeapYear(int year) const;
 
 		private:
 			int DetermineYearFromFixed(RD rd) const;
@@ -35,6 +58,97 @@ namespace smalltime
 
 		};
 
+		//============================================================
+		// Calculate the RD format from the year, month, day format
+		//============================================================
+		constexpr RD IsoChronology::FixedFromYmd(int year, int month, int day) const
+		{
+			//If month out of range (e.g. 13) we'll catch that error as bad date
+			//Want to throw a bad date exception not an array out of range exception
+			int month_index = (month - 1) % 12;
+			int64_t m = iso_julian::KSTD_MONTH_BIAS[month_index];
+			int64_t y = static_cast<int64_t>(year) - static_cast<int64_t>(iso_julian::KSTD_YEAR_BIAS[month_index]);
+
+			int64_t leap_days = math::FloorDiv(y, 4) - math::FloorDiv(y, 100) + math::FloorDiv(y, 400);
+			int64_t month_days = iso_julian::KSTD_BASE_MONTH_DAYS[month_index];
+
+			return KISO_EPOCH + static_cast<RD>(-307 + 365 * y + leap_days + month_days + 30 * m + day);
+		}
+
+		//====================================================================
+		// Calculate the RD format from the year, week, day format
+		//====================================================================
+		constexpr RD IsoChronology::FixedFromYwd(int year, int week, int day) const
+		{
+			//the amount of day that can fall in previous cycle, add 1 to bias for week starting on Mon and Sun being end of week
+			//To find the earliest Mon we just move Sun back 1 day
+			int max_days_of_prev_year = 7 - min_days_in_first_week_ + 1;
+			return math::NthKDay(0, week, FixedFromYmd(year, 1, 1) - max_days_of_prev_year) + day;
+		}
+
+		//==================================================================
+		// Calculate the RD format from year, day format
+		//==================================================================
+		constexpr RD IsoChronology::FixedFromYd(int year, int day) const
+		{
+			RD fp = FixedFromYmd(year, 1, 1);
+			return fp + static_cast<RD>(day) - 1;
+		}
+
+		//=====================================================
+		// Calculate the YMD format from RD format
+		//=====================================================
+		constexpr std::array<int, 3> IsoChronology::YmdFromFixed(RD rd) const
+		{
+			int32_t year = 0, month = 0, day = 0;
+			batch::YmdFromDay(static_cast<int64_t>(math::ConstFloor(rd)), year, month, day);
+
+			return{ year, month, day };
+		}
+
+		//=====================================================
+		// Calculate RD format from time fields
+		//=====================================================
+		constexpr RD IsoChronology::FixedFromTime(int hour, int min, int sec, int milli) const
+		{
+			return math::FixedFromTime(hour, min, sec, milli);
+		}
+
+		//=====================================================
+		// Calculate ticks at the start of a YMD date
+		//=====================================================
+		constexpr RDTicks IsoChronology::TicksFromYmd(int year, int month, int day) const
+		{
+			return batch::DayFromYmd(year, month, day) * math::KTICKS_IN_DAY;
+		}
+
+		//=====================================================
+		// Calculate the YMD format from ticks
+		//=====================================================
+		constexpr std::array<int, 3> IsoChronology::YmdFromTicks(RDTicks ticks) const
+		{
+			int32_t year = 0, month = 0, day = 0;
+			batch::YmdFromDay(math::DayFromTicks(ticks), year, month, day);
+
+			return{ year, month, day };
+		}
+
+		//=====================================================
+		// Calculate ticks from time fields
+		//=====================================================
+		constexpr RDTicks IsoChronology::TicksFromTime(int hour, int min, int sec, int milli) const
+		{
+			return math::TicksFromTime(hour, min, sec, milli);
+		}
+
+		//=====================================================
+		// Find if the given year is a leap year
+		//=====================================================
+		constexpr bool IsoChronology::IsLeapYear(int year) const
+		{
+			return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+		}
+
 	}
 }
 
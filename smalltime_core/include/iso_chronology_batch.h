@@ -0,0 +1,104 @@
+#pragma once
+#ifndef _ISOCHRONOLOGY_BATCH_
+#define _ISOCHRONOLOGY_BATCH_
+
+#include "core_decls.h"
+#include <cinttypes>
+#include <cstddef>
+
+namespace smalltime
+{
+	namespace chrono
+	{
+		namespace batch
+		{
+			// Kernels behind IsoChronology::YmdFromFixed over arrays, the rd values
+			// must be finite, only call a simd kernel when the cpu supports it
+			void YmdFromFixedScalar(const RD* rd, int32_t* year, int32_t* month, int32_t* day, std::size_t n);
+			void YmdFromFixedSse41(const RD* rd, int32_t* year, int32_t* month, int32_t* day, std::size_t n);
+			void YmdFromFixedAvx2(const RD* rd, int32_t* year, int32_t* month, int32_t* day, std::size_t n);
+
+			// Days in a 400 year cycle
+			static constexpr int64_t KERA_DAYS = 146097;
+			// Days from R.D. 0 to 0000/3/1, years are counted from March so
+			// the leap day falls at the end of the year
+			static constexpr int64_t KMARCH_SHIFT = 305;
+			// Eras added so the simd lanes only see non-negative days
+			static constexpr int64_t KERA_BIAS = 100;
+			// Days the simd lanes handle, anything else goes through the scalar path
+			static constexpr double KMIN_DAY = -static_cast<double>(KERA_BIAS * KERA_DAYS) + 1.0;
+			static constexpr double KMAX_DAY = static_cast<double>(KERA_BIAS * KERA_DAYS);
+
+			//================================================================
+			// Calculate the YMD format from any whole day, integer arithmetic
+			//================================================================
+			constexpr void YmdFromDayAnyRange(int64_t rd_day, int32_t& year, int32_t& month, int32_t& day)
+			{
+				int64_t z = rd_day + KMARCH_SHIFT;
+				int64_t era = (z >= 0 ? z : z - (KERA_DAYS - 1)) / KERA_DAYS;
+				int64_t doe = z - era * KERA_DAYS;
+				int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+				int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+				int64_t mp = (5 * doy + 2) / 153;
+
+				day = static_cast<int32_t>(doy - (153 * mp + 2) / 5 + 1);
+				month = static_cast<int32_t>(mp < 10 ? mp + 3 : mp - 9);
+				year = static_cast<int32_t>(yoe + era * 400 + (mp < 10 ? 0 : 1));
+			}
+
+			//=====================================================================
+			// Calculate the YMD format from a day in range, the divisions by the
+			// year and month lengths are done as multiply and shift
+			// (Neri & Schneider, Euclidean affine functions)
+			//=====================================================================
+			constexpr void YmdFromDayInRange(int64_t rd_day, int32_t& year, int32_t& month, int32_t& day)
+			{
+				uint64_t n = static_cast<uint64_t>(rd_day + KMARCH_SHIFT + KERA_BIAS * KERA_DAYS);
+
+				uint64_t n1 = 4 * n + 3;
+				uint64_t century = n1 / KERA_DAYS;
+				uint64_t n2 = (n1 % KERA_DAYS) / 4 * 4 + 3;
+
+				uint64_t p2 = 2939745 * n2;
+				uint64_t year_of_century = p2 >> 32;
+				uint64_t day_of_year = (p2 & 0xFFFFFFFF) / 2939745 / 4;
+
+				uint64_t n3 = 2141 * day_of_year + 197913;
+				// January and February belong to the next year
+				uint64_t next_year = day_of_year >= 306 ? 1 : 0;
+
+				year = static_cast<int32_t>(static_cast<int64_t>(100 * century + year_of_century + next_year) - KERA_BIAS * 400);
+				month = static_cast<int32_t>((n3 >> 16) - 12 * next_year);
+				day = static_cast<int32_t>((n3 & 0xFFFF) / 2141 + 1);
+			}
+
+			//==========================================
+			// Calculate the YMD format from a whole day
+			//==========================================
+			constexpr void YmdFromDay(int64_t rd_day, int32_t& year, int32_t& month, int32_t& day)
+			{
+				if (rd_day >= KMIN_DAY && rd_day <= KMAX_DAY)
+					YmdFromDayInRange(rd_day, year, month, day);
+				else
+					YmdFromDayAnyRange(rd_day, year, month, day);
+			}
+
+			//==========================================
+			// Calculate the whole day from YMD format
+			//==========================================
+			constexpr int64_t DayFromYmd(int year, int month, int day)
+			{
+				int64_t y = static_cast<int64_t>(year) - (month <= 2 ? 1 : 0);
+				int64_t era = (y >= 0 ? y : y - 399) / 400;
+				int64_t yoe = y - era * 400;
+				int64_t mp = (month + 9) % 12;
+				int64_t doy = (153 * mp + 2) / 5 + day - 1;
+				int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+				return era * KERA_DAYS + doe - KMARCH_SHIFT;
+			}
+		}
+	}
+}
+
+#endif
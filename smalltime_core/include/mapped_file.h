@@ -0,0 +1,45 @@
+#pragma once
+#ifndef _MAPPEDFILE_
+#define _MAPPEDFILE_
+
+#include <cstddef>
+#include <string>
+
+namespace smalltime
+{
+namespace fileutil
+{
+	//===================================================================
+	// Read-only memory mapping of a whole file, the mapping is shared
+	// between every process that maps the same file
+	//===================================================================
+	class MappedFile
+	{
+	public:
+		MappedFile();
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool Open(const std::string& path);
+		void Close();
+
+		bool IsOpen() const { return data_ != nullptr; }
+		const char* GetData() const { return data_; }
+		std::size_t GetSize() const { return size_; }
+
+	private:
+		const char* data_;
+		std::size_t size_;
+
+#ifdef _WIN32
+		void* file_handle_;
+		void* map_handle_;
+#endif
+	};
+
+}
+}
+
+#endif
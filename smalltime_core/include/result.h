@@ -0,0 +1,61 @@
+#pragma once
+#ifndef _RESULT_
+#define _RESULT_
+
+#include "core_decls.h"
+
+#include <optional>
+#include <utility>
+
+namespace smalltime
+{
+	//=====================================================================
+	// A value or the status saying why there is none, returned by the
+	// Try conversions in place of throwing. Failure never allocates
+	//=====================================================================
+	template <typename T>
+	class Result
+	{
+	public:
+		Result(const T& value) : value_(value), status_(Status::KOk) {}
+		Result(T&& value) : value_(std::move(value)), status_(Status::KOk) {}
+		// status must not be Status::KOk
+		Result(Status status) noexcept : value_(), status_(status) {}
+
+		explicit operator bool() const noexcept { return status_ == Status::KOk; }
+		bool HasValue() const noexcept { return status_ == Status::KOk; }
+		Status GetStatus() const noexcept { return status_; }
+
+		// Only valid when HasValue
+		const T& GetValue() const { return *value_; }
+		T GetValueOr(const T& fallback) const { return HasValue() ? *value_ : fallback; }
+
+	private:
+		std::optional<T> value_;
+		Status status_;
+	};
+
+	//=====================================================================
+	// Message of a status, matches the exception it stands in for
+	//=====================================================================
+	inline const char* StatusMessage(Status status) noexcept
+	{
+		switch (status)
+		{
+		case Status::KOk:
+			return "Ok";
+		case Status::KInvalidField:
+			return "Invalid field or fields";
+		case Status::KInvalidTimeZone:
+			return "Timezone name not found";
+		case Status::KAmbigMulti:
+			return "Ambigous multiple timezones";
+		case Status::KAmbigNone:
+			return "Ambigous gap in timezones";
+		}
+
+		return "Unknown status";
+	}
+}
+
+#endif
@@ -6,8 +6,10 @@
 #include "tz_decls.h"
 #include "basic_datetime.h"
 #include "tzdb_connector_interface.h"
+#include "fixed_vector.h"
+#include "transition_cache.h"
 #include <memory>
-#include <vector>
+#include <utility>
 
 namespace smalltime
 {
@@ -16,26 +18,36 @@ namespace smalltime
 		class RuleGroup
 		{
 		public:
-			RuleGroup(Rules rules, const Rule* const rule_arr, const Zone* const zone, const Zone* const prev_zone);
+			// Rule transitions of one year, held inline so a lookup never allocates
+			using TransitionBuffer = FixedVector<std::pair<RDTicks, int>, KMAX_YEAR_RULE_SIZE>;
+
+			// Rules must index into the tzdb rule array when a transition cache is given, ambiguities
+			// under Choose::KError set status and pick the earliest when a status is given. Active
+			// years are searched in the year ranges of the rules when given, the rules are scanned otherwise
+			RuleGroup(Rules rules, const Rule* const rule_arr, const Zone* const zone, const Zone* const prev_zone, TransitionCache* const transition_cache = nullptr, Status* const status = nullptr,
+				const RuleYearRange* const year_range_arr = nullptr, RuleYearRanges year_ranges = { 0, -1, -1 });
 
 			const Rule* const FindActiveRule(BasicDateTime<> cur_dt, Choose choose);
 			const Rule* const FindActiveRuleNoCheck(BasicDateTime<> cur_dt);
 
-		private:
-			std::pair<const Rule* const, int> FindPreviousRule(BasicDateTime<> cur_rule);
-			std::pair<const Rule* const, int> FindPreviousRule(RD cur_rule);
+			// Most rules of one rule set in effect in a single year, the entries must index into rule_arr
+			static int FindMaxYearRuleSize(const Rules* const rules_arr, int rules_size, const Rule* const rule_arr);
 
-			std::pair<const Rule* const, int> FindNextRule(BasicDateTime<> cur_rule);
-			std::pair<const Rule* const, int> FindNextRule(RD cur_rule);
+		private:
+			std::pair<const Rule* const, int> FindPreviousRule(RDTicks cur_rule);
+			std::pair<const Rule* const, int> FindNextRule(RDTicks cur_rule);
 
-			const Rule* const CorrectForAmbigAny(const BasicDateTime<>& cur_dt, RuleTransition cur_rule_transition, const Rule* const cur_rule, Choose choose);
+			const Rule* const CorrectForAmbigAny(RDTicks cur_ticks, TimeType time_type, const RuleTransition& cur_rule_transition, const Rule* const cur_rule, Choose choose);
 
 			int FindClosestActiveYear(int year);
 			int FindPreviousActiveYear(int year);
 			int FindNextActiveYear(int year);
+			int FindYearRange(int year);
 
 			void InitTransitionData(int year);
-			void BuildTransitionData(std::vector<std::pair<RD, int> >& transition_vec, int year);
+			void BuildTransitionData(TransitionBuffer& transition_vec, int year);
+			bool LoadTransitionData(int year);
+			void StoreTransitionData(int year);
 
 
 			BasicDateTime<> CalcTransitionFast(const Rule* const rule, int year);
@@ -44,20 +56,22 @@ namespace smalltime
 		private:
 			const Rule* const rule_arr_;
 			const Rules rules_;
+			// first year range of these rules, null when the rules are scanned
+			const RuleYearRange* const year_range_arr_;
+			const RuleYearRanges year_ranges_;
 
 			const Zone* const zone_;
 			const Zone* const prev_zone_;
+			TransitionCache* const transition_cache_;
+			Status* const status_;
 			const ZoneTransition zone_transition_;
 			const ZoneTransition prev_zone_transition_;
 
 			int current_year_, primary_year_, previous_year_, next_year_;
 
-			std::vector<std::pair<RD, int> > primary_year_transitions_;
-			std::vector<std::pair<RD, int> > prev_year_transitions_;
-			std::vector<std::pair<RD, int> > next_year_transitions_;
-
-			// There's usually, at most two active rules per year
-			static const int KSTART_SIZE = 3;
+			TransitionBuffer primary_year_transitions_;
+			TransitionBuffer prev_year_transitions_;
+			TransitionBuffer next_year_transitions_;
 		};
 
 	}
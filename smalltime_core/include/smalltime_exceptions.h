@@ -23,7 +23,7 @@ namespace smalltime
 		//=========================================
 		// return error message
 		//==========================================
-		virtual const char* what() const
+		virtual const char* what() const noexcept
 		{
 			return except_msg_.c_str();
 		}
@@ -49,7 +49,7 @@ namespace smalltime
 		//=========================================
 		// return error message
 		//==========================================
-		virtual const char* what() const
+		virtual const char* what() const noexcept
 		{
 			return except_msg_.c_str();
 		}
@@ -86,7 +86,7 @@ namespace smalltime
 		//=========================================
 		// return error message
 		//==========================================
-		virtual const char* what() const
+		virtual const char* what() const noexcept
 		{
 			return except_msg_.c_str();	
 		}
@@ -122,7 +122,7 @@ namespace smalltime
 		//=========================================
 		// return error message
 		//==========================================
-		virtual const char* what() const
+		virtual const char* what() const noexcept
 		{
 			return except_msg_.c_str();
 		}
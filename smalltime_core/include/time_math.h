@@ -3,6 +3,8 @@
 #define _TIMEMATH_
 
 #include "core_decls.h"
+#include "core_math.h"
+#include <cmath>
 
 namespace smalltime
 {
@@ -64,7 +66,65 @@ namespace smalltime
 			return FixedFromTime(1, 0, 0, 0);
 		}
 
+		// Ticks globals
+		static constexpr RDTicks KTICKS_IN_DAY = 86400000;
+		static constexpr RDTicks KTICKS_IN_HOUR = KTICKS_IN_DAY / 24;
+		static constexpr RDTicks KTICKS_IN_MINUTE = KTICKS_IN_HOUR / 60;
+		static constexpr RDTicks KTICKS_IN_SECOND = KTICKS_IN_MINUTE / 60;
+
+		//===========================================
+		// convert time fields to ticks
+		//===========================================
+		constexpr RDTicks TicksFromTime(int h, int m, int s, int ms)
+		{
+			return h * KTICKS_IN_HOUR + m * KTICKS_IN_MINUTE + s * KTICKS_IN_SECOND + ms;
+		}
+
+		//===================================================
+		// Round fixed format to the closest millisecond,
+		// halves away from zero like llround but inline
+		//===================================================
+		inline RDTicks TicksFromFixed(RD rd)
+		{
+			RD ms = rd * KMILLISECONDS_IN_DAY;
+			auto ticks = static_cast<RDTicks>(ms);
+			// exact, ms and its whole part share the exponent
+			RD frac = ms - static_cast<RD>(ticks);
+
+			if (frac >= 0.5)
+				++ticks;
+			else if (frac <= -0.5)
+				--ticks;
+
+			return ticks;
+		}
+
+		//===================================================
+		// TicksFromFixed usable in constant expressions
+		//===================================================
+		constexpr RDTicks ConstTicksFromFixed(RD rd)
+		{
+			return static_cast<RDTicks>(ConstRound(rd * KMILLISECONDS_IN_DAY));
+		}
+
+		//===========================================
+		// convert ticks to fixed format
+		//===========================================
+		constexpr RD FixedFromTicks(RDTicks ticks)
+		{
+			return static_cast<RD>(ticks) / KMILLISECONDS_IN_DAY;
+		}
+
+		//===========================================
+		// Whole day of ticks, rounds down
+		//===========================================
+		constexpr RDTicks DayFromTicks(RDTicks ticks)
+		{
+			return (ticks >= 0 ? ticks : ticks - (KTICKS_IN_DAY - 1)) / KTICKS_IN_DAY;
+		}
+
 		std::array<int, 4> HmsFromFixed(RD rd);
+		std::array<int, 4> HmsFromTicks(RDTicks ticks);
 	}
 }
 
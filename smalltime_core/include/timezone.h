@@ -4,23 +4,64 @@
 
 #include <string>
 #include <memory>
+#include <cstddef>
 
 #include "core_decls.h"
 #include "timezone_db.h"
+#include "zone_handle.h"
+#include "basic_datetime.h"
+#include "result.h"
 
 namespace smalltime
 {
 	namespace tz
 	{
+		// Forward decl
+		class RuleGroup;
+
 		class TimeZone
 		{
 		public:
 
 			RD FixedOffsetFromLocal(RD rd, std::string time_zone_name, Choose choose);
 			RD FixedOffsetFromUtc(RD rd, std::string time_zone_name);
+			// Empty when rd is not covered by precompiled transitions
+			std::string AbbrevFromUtc(RD rd, std::string time_zone_name);
+
+			// Same as above against a zone resolved up front
+			RD FixedOffsetFromLocal(RD rd, const ZoneHandle& zone_handle, Choose choose);
+			RD FixedOffsetFromUtc(RD rd, const ZoneHandle& zone_handle);
+			std::string AbbrevFromUtc(RD rd, const ZoneHandle& zone_handle);
+
+			// Convert a span of n datetimes, the located transition and rule
+			// group are reused while consecutive inputs stay in the same period
+			void OffsetsFromUtc(const RD* in, RD* out, std::size_t n, const ZoneHandle& zone_handle);
+			void OffsetsFromLocal(const RD* in, RD* out, std::size_t n, const ZoneHandle& zone_handle, Choose choose);
+
+			// Integer millisecond forms, exact against the precompiled transitions
+			RDTicks TicksOffsetFromUtc(RDTicks ticks, const ZoneHandle& zone_handle);
+			RDTicks TicksOffsetFromLocal(RDTicks ticks, const ZoneHandle& zone_handle, Choose choose);
+			void TicksOffsetsFromUtc(const RDTicks* in, RDTicks* out, std::size_t n, const ZoneHandle& zone_handle);
+
+			// Non-throwing forms, an unknown zone or an ambiguous time under Choose::KError comes back as a status
+			Result<RD> TryFixedOffsetFromLocal(RD rd, const std::string& time_zone_name, Choose choose);
+			Result<RD> TryFixedOffsetFromUtc(RD rd, const std::string& time_zone_name);
+			Result<RD> TryFixedOffsetFromLocal(RD rd, const ZoneHandle& zone_handle, Choose choose);
+			Result<RD> TryFixedOffsetFromUtc(RD rd, const ZoneHandle& zone_handle);
 
 		private:
-			static TimeZoneDB timezone_db_;
+			// Rule group of the last zone line, kept across a batch
+			struct RuleGroupCache
+			{
+				const Zone* zone;
+				const Zone* prev_zone;
+				std::unique_ptr<RuleGroup> rule_group;
+			};
+
+			RD FixedOffsetFromZones(const BasicDateTime<>& iso_dt, Zones zones, const TzdbSnapshot& snapshot, const ZoneHandle* const zone_handle, Choose choose, RuleGroupCache* const rule_group_cache = nullptr, Status* const status = nullptr);
+			const UtcTransition* const FindUtcTransition(RD rd, const UtcTransitions& utc_transitions, const TzdbSnapshot& snapshot);
+			const UtcTransition* const FindUtcTransition(RD rd, const ZoneHandle& zone_handle);
+			std::size_t FindUtcTransitionTicks(RDTicks ticks, const RDTicks* const utc_transition_ticks, std::size_t size);
 		};
 	}
 }
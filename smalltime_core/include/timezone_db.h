@@ -4,21 +4,48 @@
 
 #include "core_decls.h"
 #include "tz_decls.h"
+#include "tzdb_snapshot.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace smalltime
 {
 	namespace tz
 	{
+		//=====================================================================
+		// Publishes the current TzdbSnapshot. The tzdb is loaded on first
+		// use and can be replaced with Reload while conversions run, those
+		// in flight finish on the snapshot they started with. Readers take
+		// no lock, each thread keeps the snapshot it last saw and only
+		// swaps it after a new one is published
+		//=====================================================================
 		class TimeZoneDB
 		{
 		public:
 			
+			// Load again on next use, conversions in flight keep the old snapshot
 			static void SetPath(std::string path);
+			static void SetLoadMode(LoadMode load_mode);
+			static LoadMode GetLoadMode();
+			// Back the tzdb with tables compiled into the program and switch
+			// to LoadMode::KEmbedded, nullptr goes back to reading the file
+			static void SetEmbedded(const EmbeddedTzdb* tables);
 			static void Init();
+
+			// Load the tzdb again and publish it, the current snapshot is kept
+			// when loading throws
+			static uint64_t Reload();
+
+			// The snapshot stays alive as long as the returned pointer
+			static std::shared_ptr<const TzdbSnapshot> GetSnapshot();
+			// Valid until the calling thread asks for a snapshot again
+			static const TzdbSnapshot& GetThreadSnapshot();
 			
+			// Lookups against the calling thread's snapshot, handles are
+			// valid until the thread picks up a reload
 			const Rule* const GetRuleHandle();
 			const Zone* const GetZoneHandle();
 
@@ -27,28 +54,32 @@ namespace smalltime
 
 			Zones FindZones(const std::string& zoneName);
 			Zones FindZones(uint32_t zone_id);
-			
-		private:
-			std::unique_ptr<RD[]> zone_buffer_;
-			std::unique_ptr<RD[]> rule_buffer_;
 
-			Zones BinarySearchZones(uint32_t zone_id, int size);
-			Rules BinarySearchRules(uint32_t rule_id, int size);
+			// Precompiled transitions, first is -1 when the tzdb file has none
+			const UtcTransition* const GetUtcTransitionHandle();
+			UtcTransitions FindUtcTransitions(uint32_t zone_id);
+			std::string GetAbbrev(uint32_t abbrev_index);
 
-			static std::unique_ptr<Zone[]> zone_arr_;
-			static std::unique_ptr<Rule[]> rule_arr_;
-			static std::unique_ptr<Zones[]> zone_lookup_arr_;
-			static std::unique_ptr<Rules[]> rule_lookup_arr_;
+			// Rule transitions per year of the loaded tzdb
+			TransitionCache* const GetTransitionCache();
+			
+		private:
+			static std::shared_ptr<const TzdbSnapshot> Load(std::string path, LoadMode load_mode, const EmbeddedTzdb* embedded, uint64_t version);
+			static void Publish(std::shared_ptr<const TzdbSnapshot> snapshot);
+			static const std::shared_ptr<const TzdbSnapshot>& ThreadSnapshot();
 
-			static int zone_size_, rule_size_, zone_lookup_size_, rule_lookup_size_;
-			static bool initialized_;
+			static std::shared_ptr<const TzdbSnapshot> snapshot_;
+			// version of snapshot_, 0 until the first load
+			static std::atomic<uint64_t> version_;
+			static uint64_t next_version_;
 
+			// guards snapshot_, path_, load_mode_, embedded_ and loading
+			static std::mutex mutex_;
+			static LoadMode load_mode_;
 			static std::string path_;
+			static const EmbeddedTzdb* embedded_;
 		};
 	}
 }
 
 #endif
-
-
-
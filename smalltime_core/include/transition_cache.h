@@ -0,0 +1,95 @@
+#pragma once
+#ifndef _TRANSITION_CACHE_
+#define _TRANSITION_CACHE_
+
+#include "core_decls.h"
+#include "tz_decls.h"
+
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace smalltime
+{
+	namespace tz
+	{
+		// Most transitions of one year a cache entry holds, years with more are not cached
+		static const int KCACHE_YEAR_SIZE = 6;
+		// Number of entries, the cache never grows past this
+		static const int KCACHE_SLOTS = 512;
+
+		// Transition of a rule in the rule array
+		struct CachedTransition
+		{
+			RDTicks ticks;
+			int32_t rule_index;
+			int32_t padding;
+		};
+
+		//=====================================================================
+		// The active years and rule transitions a rule group computes for
+		// a year, they only depend on the rules so zones sharing a rule
+		// share the entry
+		//=====================================================================
+		struct YearTransitions
+		{
+			// rule group and the year asked for
+			int32_t rule_first;
+			int32_t rule_size;
+			int32_t year;
+
+			int32_t primary_year;
+			int32_t previous_year;
+			int32_t next_year;
+
+			int32_t primary_size;
+			int32_t prev_size;
+			int32_t next_size;
+			int32_t padding;
+
+			CachedTransition primary[KCACHE_YEAR_SIZE];
+			CachedTransition prev[KCACHE_YEAR_SIZE];
+			CachedTransition next[KCACHE_YEAR_SIZE];
+		};
+
+		//=====================================================================
+		// Bounded, direct mapped cache of YearTransitions shared by every
+		// thread. Each slot is a seqlock, readers never block or write and
+		// treat a slot being written as a miss, a writer that finds the
+		// slot taken by another writer drops its entry
+		//=====================================================================
+		class TransitionCache
+		{
+		public:
+			TransitionCache();
+
+			TransitionCache(const TransitionCache&) = delete;
+			TransitionCache& operator=(const TransitionCache&) = delete;
+
+			bool Find(Rules rules, int year, YearTransitions& year_transitions) const;
+			void Insert(const YearTransitions& year_transitions);
+			void Clear();
+
+		private:
+			static_assert(std::is_trivially_copyable<YearTransitions>::value, "YearTransitions is copied word by word");
+			static_assert(sizeof(YearTransitions) % sizeof(uint64_t) == 0, "YearTransitions must be a whole number of words");
+
+			static const std::size_t KSLOT_WORDS = sizeof(YearTransitions) / sizeof(uint64_t);
+
+			struct Slot
+			{
+				// odd while a writer owns the slot
+				std::atomic<uint32_t> sequence;
+				std::atomic<uint64_t> words[KSLOT_WORDS];
+			};
+
+			static std::size_t SlotIndex(int rule_first, int year);
+
+			std::unique_ptr<Slot[]> slots_;
+		};
+	}
+}
+
+#endif
@@ -12,7 +12,12 @@ namespace smalltime
 	{
 		static const int ONLY = -999;
 		static const RD DMAX = 3651695.0; // (9999/1/1)
+		static const RDTicks DMAX_TICKS = math::ConstTicksFromFixed(DMAX);
 		static const int MAX = 9999;
+		// Most rules of one name in effect in a single year, rule groups buffer
+		// this many transitions inline. The bundled sources need 4, the compiler
+		// and the tzdb loaders refuse data needing more
+		static const int KMAX_YEAR_RULE_SIZE = 8;
 		
 		enum TimeType
 		{
@@ -82,84 +87,105 @@ namespace smalltime
 			int size;
 		};
 
+		// Years in which at least one rule of a rule set is in effect, the
+		// ranges of one set are merged and sorted by year
+		struct RuleYearRange
+		{
+			int from_year;
+			int to_year;
+		};
+
+		// Year ranges of one rule set, sorted by rule id like Rules
+		struct RuleYearRanges
+		{
+			uint32_t rule_id;
+			int first;
+			int size;
+		};
+
+		// Precompiled change of offset, in effect from utc onwards
+		struct UtcTransition
+		{
+			RD utc;
+			RD offset;
+			uint32_t abbrev_index;
+		};
+
+		// Transitions of one zone, past tail_utc the zone rules are evaluated
+		struct UtcTransitions
+		{
+			uint32_t zone_id;
+			int first;
+			int size;
+			RD tail_utc;
+		};
+
+		// Slot of the zone name perfect hash, the name is stored for verification
+		struct ZoneIndexSlot
+		{
+			uint32_t name_offset;
+			uint32_t name_size;
+			int lookup_index;
+		};
+
+		// Zone transition in ticks, the zone data is converted once so the
+		// engine compares transitions exactly. The transition takes effect
+		// one tick after the moment before
 		class ZoneTransition
 		{
 		public:
-			ZoneTransition(RD mb_trans_utc, RD cur_zoffset, RD next_zoffset, RD cur_roffset, RD next_roffset) :
-				mb_trans_utc_(mb_trans_utc),
-				cur_zoffset_(cur_zoffset),
-				next_zoffset_(next_zoffset),
-				cur_roffset_(cur_roffset),
-				next_roffset_(next_roffset),
-				mb_trans_wall_(mb_trans_utc + cur_zoffset + cur_roffset), 
-				mb_trans_std_(mb_trans_utc + cur_zoffset),
-				trans_wall_(mb_trans_utc + cur_zoffset + cur_roffset + math::MSEC()),
-				trans_std_(mb_trans_utc + cur_zoffset + math::MSEC()),
-				trans_utc_(mb_trans_utc + math::MSEC()),
-				first_inst_std_(mb_trans_utc + math::MSEC() + next_zoffset),
-				first_inst_wall_(mb_trans_utc + math::MSEC() + next_zoffset + next_roffset)
+			ZoneTransition(RD mb_trans_utc, RD cur_zoffset, RD next_zoffset, RD cur_roffset, RD next_roffset)
 			{
-
+				Reset(mb_trans_utc, cur_zoffset, next_zoffset, cur_roffset, next_roffset);
 			}
 
 			void Reset(RD mb_trans_utc, RD cur_zoffset, RD next_zoffset, RD cur_roffset, RD next_roffset)
 			{
-				cur_zoffset_ = cur_zoffset;
-				next_zoffset_ = next_zoffset;
-				cur_roffset_ = cur_roffset;
-				next_roffset_ = next_roffset;
+				cur_zoffset_ = math::TicksFromFixed(cur_zoffset);
+				next_zoffset_ = math::TicksFromFixed(next_zoffset);
+				cur_roffset_ = math::TicksFromFixed(cur_roffset);
+				next_roffset_ = math::TicksFromFixed(next_roffset);
 
-				mb_trans_utc_ = mb_trans_utc;
-				mb_trans_std_ = mb_trans_utc + cur_zoffset;
-				mb_trans_wall_ = mb_trans_utc + cur_zoffset + cur_roffset;
-
-				trans_utc_ = mb_trans_utc + math::MSEC();
-				trans_std_ = mb_trans_utc + cur_zoffset + math::MSEC();
-				trans_wall_ = mb_trans_utc + cur_zoffset + cur_roffset + math::MSEC();
+				mb_trans_utc_ = math::TicksFromFixed(mb_trans_utc);
+				mb_trans_std_ = mb_trans_utc_ + cur_zoffset_;
+				mb_trans_wall_ = mb_trans_utc_ + cur_zoffset_ + cur_roffset_;
 
-				first_inst_std_ = mb_trans_utc + math::MSEC() + next_zoffset;
-				first_inst_wall_ = mb_trans_utc + math::MSEC() + next_zoffset + next_roffset;
+				trans_utc_ = mb_trans_utc_ + 1;
+				trans_std_ = trans_utc_ + cur_zoffset_;
+				trans_wall_ = trans_utc_ + cur_zoffset_ + cur_roffset_;
 
+				first_inst_std_ = trans_utc_ + next_zoffset_;
+				first_inst_wall_ = trans_utc_ + next_zoffset_ + next_roffset_;
 			}
 
-			RD mb_trans_wall_;
-			RD mb_trans_std_;
-			RD mb_trans_utc_;
+			RDTicks mb_trans_wall_;
+			RDTicks mb_trans_std_;
+			RDTicks mb_trans_utc_;
 
-			RD trans_wall_;
-			RD trans_std_;
-			RD trans_utc_;
+			RDTicks trans_wall_;
+			RDTicks trans_std_;
+			RDTicks trans_utc_;
 
-			RD first_inst_wall_;
-			RD first_inst_std_;
+			RDTicks first_inst_wall_;
+			RDTicks first_inst_std_;
 
-			RD cur_zoffset_;
-			RD cur_roffset_;
-			RD next_zoffset_;
-			RD next_roffset_;
+			RDTicks cur_zoffset_;
+			RDTicks cur_roffset_;
+			RDTicks next_zoffset_;
+			RDTicks next_roffset_;
 
 		};
 
+		// Rule transition in ticks, takes effect one tick after the moment before
 		class RuleTransition
 		{
 		public:
-			RuleTransition(RD mb_trans_utc, RD zoffset, RD cur_roffset, RD prev_roffset) :
-				mb_trans_utc_(mb_trans_utc),
-				zoffset_(zoffset),
-				cur_roffset_(cur_roffset),
-				prev_roffset_(prev_roffset),
-				mb_trans_std_(mb_trans_utc + zoffset),
-				mb_trans_wall_(mb_trans_utc + zoffset + prev_roffset),
-				trans_utc_(mb_trans_utc + math::MSEC()),
-				trans_std_(mb_trans_utc + zoffset + math::MSEC()),
-				trans_wall_(mb_trans_utc + zoffset + prev_roffset + math::MSEC()),
-				first_inst_std_(mb_trans_utc + math::MSEC() + zoffset),
-				first_inst_wall_(mb_trans_utc + math::MSEC() + zoffset + cur_roffset)
+			RuleTransition(RDTicks mb_trans_utc, RDTicks zoffset, RDTicks cur_roffset, RDTicks prev_roffset)
 			{
-
+				Reset(mb_trans_utc, zoffset, cur_roffset, prev_roffset);
 			}
 
-			void Reset(RD mb_trans_utc, RD zoffset, RD cur_roffset, RD prev_roffset)
+			void Reset(RDTicks mb_trans_utc, RDTicks zoffset, RDTicks cur_roffset, RDTicks prev_roffset)
 			{
 				zoffset_ = zoffset;
 				cur_roffset_ = cur_roffset;
@@ -169,28 +195,28 @@ namespace smalltime
 				mb_trans_std_ = mb_trans_utc + zoffset;
 				mb_trans_wall_ = mb_trans_utc + zoffset + prev_roffset;
 
-				trans_utc_ = mb_trans_utc + math::MSEC();
-				trans_std_ = mb_trans_utc + zoffset + math::MSEC();
-				trans_wall_ = mb_trans_utc + zoffset + prev_roffset + math::MSEC();
+				trans_utc_ = mb_trans_utc + 1;
+				trans_std_ = trans_utc_ + zoffset;
+				trans_wall_ = trans_utc_ + zoffset + prev_roffset;
 
-				first_inst_std_ = mb_trans_utc + math::MSEC() + zoffset;
-				first_inst_wall_ = mb_trans_utc + math::MSEC() + zoffset + cur_roffset;
+				first_inst_std_ = trans_utc_ + zoffset;
+				first_inst_wall_ = trans_utc_ + zoffset + cur_roffset;
 			}
 
-			RD mb_trans_wall_;
-			RD mb_trans_std_;
-			RD mb_trans_utc_;
+			RDTicks mb_trans_wall_;
+			RDTicks mb_trans_std_;
+			RDTicks mb_trans_utc_;
 
-			RD trans_wall_;
-			RD trans_std_;
-			RD trans_utc_;
+			RDTicks trans_wall_;
+			RDTicks trans_std_;
+			RDTicks trans_utc_;
 
-			RD first_inst_wall_;
-			RD first_inst_std_;
+			RDTicks first_inst_wall_;
+			RDTicks first_inst_std_;
 
-			RD zoffset_;
-			RD cur_roffset_;
-			RD prev_roffset_;
+			RDTicks zoffset_;
+			RDTicks cur_roffset_;
+			RDTicks prev_roffset_;
 
 		};
 
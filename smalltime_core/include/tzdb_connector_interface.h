@@ -5,6 +5,8 @@
 #include "core_decls.h"
 #include "tz_decls.h"
 
+#include <string>
+
 namespace smalltime
 {
 	namespace tz
@@ -0,0 +1,16 @@
+#pragma once
+#ifndef _TZDB_EMBEDDED_
+#define _TZDB_EMBEDDED_
+
+#include "tzdb_snapshot.h"
+
+namespace smalltime
+{
+	namespace tz
+	{
+		// Tables of the generated Tzdb.h, only linked in with SMALLTIME_EMBEDDED_TZDB
+		const EmbeddedTzdb& GetEmbeddedTzdb();
+	}
+}
+
+#endif
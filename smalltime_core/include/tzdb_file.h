@@ -0,0 +1,93 @@
+#pragma once
+#ifndef _TZDB_FILE_
+#define _TZDB_FILE_
+
+#include "core_decls.h"
+#include "tz_decls.h"
+#include <cinttypes>
+#include <cstddef>
+
+namespace smalltime
+{
+	namespace tz
+	{
+		//===================================================================
+		// Layout of the version 2 tzdb.bin
+		// A fixed size header followed by naturally aligned arrays of the
+		// in memory structs, each array can be used in place once the
+		// header has been validated
+		//===================================================================
+
+		// "TZDB" read as a little endian uint32_t
+		static const uint32_t KTZDB_MAGIC = 0x42445a54;
+		static const uint32_t KTZDB_VERSION = 2;
+		// Every section starts on this boundary
+		static const uint32_t KTZDB_ALIGNMENT = 16;
+		static const int KTZDB_MAX_SECTIONS = 16;
+
+		enum TzdbSectionType
+		{
+			KTzdbSection_Zone = 0,
+			KTzdbSection_Rule = 1,
+			KTzdbSection_ZoneLookup = 2,
+			KTzdbSection_RuleLookup = 3,
+			// Optional, precompiled utc transitions
+			KTzdbSection_UtcTransition = 4,
+			KTzdbSection_UtcTransitionLookup = 5,
+			KTzdbSection_Abbrev = 6,
+			// Optional, perfect hash over zone and link names
+			KTzdbSection_ZoneIndexDisplacement = 7,
+			KTzdbSection_ZoneIndexSlot = 8,
+			KTzdbSection_ZoneIndexName = 9,
+			// Optional, active years of each rule set
+			KTzdbSection_RuleYearRange = 10,
+			KTzdbSection_RuleYearRangeLookup = 11,
+			KTzdbSection_Count = 12
+		};
+
+		// Sections every version 2 file must have
+		static const uint32_t KTZDB_REQUIRED_SECTIONS = KTzdbSection_RuleLookup + 1;
+
+		struct TzdbSection
+		{
+			uint64_t offset;
+			uint32_t count;
+			uint32_t record_size;
+		};
+
+		struct TzdbHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint64_t file_size;
+			uint32_t header_size;
+			uint32_t section_count;
+			// CRC-32 of every byte following the header
+			uint32_t crc;
+			// Most rules of one name in effect in a single year, 0 in files
+			// written before it was recorded
+			uint32_t max_year_rule_size;
+			TzdbSection sections[KTZDB_MAX_SECTIONS];
+			// Last year the utc transitions were precompiled for, zones whose
+			// offsets still change past it have their tail_utc at the start of
+			// the following year. Files written before it was recorded end
+			// the header here
+			int32_t transition_horizon;
+			uint32_t reserved;
+		};
+
+		// Header size of version 2 files without the transition horizon
+		static const uint32_t KTZDB_HEADER_SIZE_NO_HORIZON = offsetof(TzdbHeader, transition_horizon);
+
+		//=============================================
+		// Round offset up to the section alignment
+		//=============================================
+		inline uint64_t AlignTzdbOffset(uint64_t offset)
+		{
+			return (offset + KTZDB_ALIGNMENT - 1) & ~static_cast<uint64_t>(KTZDB_ALIGNMENT - 1);
+		}
+
+	}
+}
+
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+#ifndef _TZDB_LITERALS_
+#define _TZDB_LITERALS_
+
+#include "core_decls.h"
+#include "tz_decls.h"
+#include "zone_handle.h"
+
+// generated by smalltime_compiler -f header, only on the include path
+// with SMALLTIME_EMBEDDED_TZDB
+#include <Tzdb.h>
+
+namespace smalltime
+{
+	namespace tz
+	{
+		//=====================================================================
+		// Check name against the name of a zone index slot
+		//=====================================================================
+		constexpr bool EmbeddedSlotHasName(const ZoneIndexSlot& slot, const char* name)
+		{
+			for (uint32_t i = 0; i < slot.name_size; ++i)
+			{
+				if (name[i] == '\0' || KZoneIndexNames[slot.name_offset + i] != name[i])
+					return false;
+			}
+
+			return name[slot.name_size] == '\0';
+		}
+
+		//=====================================================================
+		// Zones of a zone or link name in the embedded tzdb, first is -1
+		// when there is no such name. Walks every name so it is only meant
+		// for constant evaluation
+		//=====================================================================
+		constexpr ZoneLiteral FindEmbeddedZone(const char* name)
+		{
+			for (const auto& slot : KZoneIndexSlotArray)
+			{
+				if (!EmbeddedSlotHasName(slot, name))
+					continue;
+
+				const auto& zones = KZoneLookupArray[slot.lookup_index];
+				return{ name, zones, KZoneArray[zones.first].zone_id };
+			}
+
+			return{ name, { 0, -1, -1 }, 0 };
+		}
+	}
+}
+
+//=====================================================================
+// Zone literal resolved at compile time, a name missing from the
+// embedded tzdb fails the build, e.g.
+// static const tz::ZoneHandle KNEW_YORK(SMALLTIME_ZONE("America/New_York"));
+//=====================================================================
+#define SMALLTIME_ZONE(name) \
+	([]() \
+	{ \
+		constexpr ::smalltime::tz::ZoneLiteral zone_literal = ::smalltime::tz::FindEmbeddedZone(name); \
+		static_assert(zone_literal.zones.first != -1, "time zone not in the embedded tzdb: " name); \
+		return zone_literal; \
+	}())
+
+#endif
@@ -0,0 +1,166 @@
+#pragma once
+#ifndef _TZDB_SNAPSHOT_
+#define _TZDB_SNAPSHOT_
+
+#include "core_decls.h"
+#include "tz_decls.h"
+#include "mapped_file.h"
+#include "transition_cache.h"
+
+#include <cinttypes>
+#include <memory>
+#include <string>
+
+namespace smalltime
+{
+	namespace tz
+	{
+		// How the tzdb file is brought into memory, KEmbedded reads no file
+		// and uses the tables compiled in with SMALLTIME_EMBEDDED_TZDB
+		enum class LoadMode
+		{
+			KStream,
+			KMapped,
+			KEmbedded
+		};
+
+		//=====================================================================
+		// Tables of a tzdb compiled into the program from Tzdb.h, they are
+		// used in place and must outlive every snapshot made from them
+		//=====================================================================
+		struct EmbeddedTzdb
+		{
+			const Zone* zones;
+			int zone_size;
+			const Rule* rules;
+			int rule_size;
+			const Zones* zone_lookup;
+			int zone_lookup_size;
+			const Rules* rule_lookup;
+			int rule_lookup_size;
+			const UtcTransition* utc_transitions;
+			int utc_transition_size;
+			const UtcTransitions* utc_transition_lookup;
+			int utc_transition_lookup_size;
+			const uint64_t* abbrevs;
+			int abbrev_size;
+			const uint32_t* zone_index_displacements;
+			int zone_index_displacement_size;
+			const ZoneIndexSlot* zone_index_slots;
+			int zone_index_slot_size;
+			const char* zone_index_names;
+			int zone_index_name_size;
+			const RuleYearRange* rule_year_ranges;
+			int rule_year_range_size;
+			const RuleYearRanges* rule_year_range_lookup;
+			int rule_year_range_lookup_size;
+			int transition_horizon;
+		};
+
+		//=====================================================================
+		// One loaded tzdb file, never changes once loaded. Whoever holds a
+		// shared_ptr to it keeps every array and handle it hands out alive.
+		// The precompiled transitions are converted to ticks once on load
+		//=====================================================================
+		class TzdbSnapshot
+		{
+		public:
+			// Throws when the file is missing or corrupt
+			static std::shared_ptr<const TzdbSnapshot> Load(std::string path, LoadMode load_mode, uint64_t version);
+			// Never touches the filesystem, only the transition ticks are built
+			static std::shared_ptr<const TzdbSnapshot> Load(const EmbeddedTzdb& tables, uint64_t version);
+
+			TzdbSnapshot(const TzdbSnapshot&) = delete;
+			TzdbSnapshot& operator=(const TzdbSnapshot&) = delete;
+
+			uint64_t GetVersion() const { return version_; }
+			const std::string& GetPath() const { return path_; }
+
+			const Rule* const GetRuleHandle() const;
+			const Zone* const GetZoneHandle() const;
+			int GetZoneSize() const { return zone_size_; }
+
+			Rules FindRules(const std::string& ruleName) const;
+			Rules FindRules(uint32_t rule_id) const;
+
+			Zones FindZones(const std::string& zoneName) const;
+			Zones FindZones(uint32_t zone_id) const;
+
+			// Precompiled transitions, first is -1 when the tzdb file has none
+			const UtcTransition* const GetUtcTransitionHandle() const;
+			UtcTransitions FindUtcTransitions(uint32_t zone_id) const;
+			// Utc moments and offsets of the precompiled transitions in ticks,
+			// parallel to the transition array
+			const RDTicks* const GetUtcTransitionTickHandle() const;
+			const RDTicks* const GetOffsetTickHandle() const;
+			// Last year the transitions were precompiled for, 0 when the
+			// tzdb does not record it
+			int GetTransitionHorizon() const { return transition_horizon_; }
+			std::string GetAbbrev(uint32_t abbrev_index) const;
+
+			// Active years of rule sets, first is -1 when the tzdb file has none
+			const RuleYearRange* const GetRuleYearRangeHandle() const;
+			RuleYearRanges FindRuleYearRanges(uint32_t rule_id) const;
+
+			// Rule transitions per year of this snapshot's rule array
+			TransitionCache* const GetTransitionCache() const;
+
+		private:
+			TzdbSnapshot(std::string path, uint64_t version);
+
+			Zones BinarySearchZones(uint32_t zone_id, int size) const;
+			Rules BinarySearchRules(uint32_t rule_id, int size) const;
+			UtcTransitions BinarySearchUtcTransitions(uint32_t zone_id, int size) const;
+			RuleYearRanges BinarySearchRuleYearRanges(uint32_t rule_id, int size) const;
+
+			void InitFromStream();
+			void InitFromMapping();
+			void InitFromImage(const char* data, std::size_t size, bool verify_checksum);
+			void InitFromTables(const EmbeddedTzdb& tables);
+			void ResetUtcTransitions();
+			void InitUtcTransitionTicks();
+			void CheckTransitionHorizon() const;
+			void ResetZoneIndex();
+			void ResetRuleYearRanges();
+			void CheckYearRuleSize(uint32_t max_year_rule_size) const;
+
+			std::string path_;
+			uint64_t version_;
+
+			std::unique_ptr<Zone[]> zone_arr_;
+			std::unique_ptr<Rule[]> rule_arr_;
+			std::unique_ptr<Zones[]> zone_lookup_arr_;
+			std::unique_ptr<Rules[]> rule_lookup_arr_;
+			std::unique_ptr<uint64_t[]> file_buffer_;
+			fileutil::MappedFile mapped_file_;
+			std::unique_ptr<RDTicks[]> utc_transition_tick_arr_;
+			std::unique_ptr<RDTicks[]> offset_tick_arr_;
+
+			// point into the owned arrays, straight into the file image or into
+			// the embedded tables
+			const Zone* zone_handle_;
+			const Rule* rule_handle_;
+			const Zones* zone_lookup_handle_;
+			const Rules* rule_lookup_handle_;
+			const UtcTransition* utc_transition_handle_;
+			const UtcTransitions* utc_transition_lookup_handle_;
+			const uint64_t* abbrev_handle_;
+			const uint32_t* zone_index_displacement_handle_;
+			const ZoneIndexSlot* zone_index_slot_handle_;
+			const char* zone_index_name_handle_;
+			const RuleYearRange* rule_year_range_handle_;
+			const RuleYearRanges* rule_year_range_lookup_handle_;
+
+			int zone_size_, rule_size_, zone_lookup_size_, rule_lookup_size_;
+			int utc_transition_size_, utc_transition_lookup_size_, abbrev_size_;
+			int zone_index_displacement_size_, zone_index_slot_size_, zone_index_name_size_;
+			int rule_year_range_size_, rule_year_range_lookup_size_;
+			int transition_horizon_;
+
+			// filled in by readers, the only state that changes after loading
+			mutable TransitionCache transition_cache_;
+		};
+	}
+}
+
+#endif
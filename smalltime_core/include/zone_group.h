@@ -15,7 +15,8 @@ namespace smalltime
 		class ZoneGroup
 		{
 		public:
-			ZoneGroup(Zones zones, const Zone* const zone_arr);
+			// Ambiguities under Choose::KError set status and pick the earliest when a status is given, otherwise they throw
+			ZoneGroup(Zones zones, const Zone* const zone_arr, Status* const status = nullptr);
 
 			const Zone* const FindActiveZone(BasicDateTime<> cur_dt, Choose choose);
 			std::pair<const Zone* const, const Zone* const>  FindActiveAndPreviousZone(BasicDateTime<> cur_dt, Choose choose);
@@ -24,13 +25,15 @@ namespace smalltime
 		private:
 			const Zone* const FindPreviousZone(int cur_zone_index);
 			const Zone* const FindNextZone(int cur_zone_index);
+			static RDTicks FindTransitionTicks(const Zone& zone, TimeType time_type);
 
-			const Zone* const CorrectForAmbigAny(const BasicDateTime<>& cur_dt, int cur_zone_index, const ZoneTransition& cur_zone_transition, Choose choose);
-			std::pair<const Zone* const, const Zone* const> CorrectPairForAmbigAny(const BasicDateTime<>& cur_dt, int cur_zone_index, const ZoneTransition& cur_zone_transition, Choose choose);
+			const Zone* const CorrectForAmbigAny(RDTicks cur_ticks, TimeType time_type, int cur_zone_index, const ZoneTransition& cur_zone_transition, Choose choose);
+			std::pair<const Zone* const, const Zone* const> CorrectPairForAmbigAny(RDTicks cur_ticks, TimeType time_type, int cur_zone_index, const ZoneTransition& cur_zone_transition, Choose choose);
 
 		private:
 			const Zone* const zone_arr_;
 			const Zones zones_;
+			Status* const status_;
 		};
 	}
 }
@@ -0,0 +1,89 @@
+#pragma once
+#ifndef _ZONE_HANDLE_
+#define _ZONE_HANDLE_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core_decls.h"
+#include "tz_decls.h"
+#include "timezone_db.h"
+
+namespace smalltime
+{
+	namespace tz
+	{
+		//=====================================================================
+		// A zone name resolved at compile time against the embedded tzdb,
+		// made by SMALLTIME_ZONE in tzdb_literals.h
+		//=====================================================================
+		struct ZoneLiteral
+		{
+			const char* name;
+			Zones zones;
+			// zone id of the zone lines, differs from zones.zone_id for links
+			uint32_t line_zone_id;
+		};
+
+		//=====================================================================
+		// A time zone resolved once against the tzdb, conversions taking a
+		// handle skip hashing the name and searching the lookup arrays.
+		// The handle keeps the snapshot it was resolved against, resolve
+		// again to pick up a reloaded tzdb
+		//=====================================================================
+		class ZoneHandle
+		{
+		public:
+			explicit ZoneHandle(const std::string& time_zone_name);
+			// Skips the name lookup when the loaded tzdb is the embedded one
+			explicit ZoneHandle(const ZoneLiteral& zone_literal);
+
+			const std::string& GetName() const { return name_; }
+			uint32_t GetZoneId() const { return zone_id_; }
+			const TzdbSnapshot& GetSnapshot() const { return *snapshot_; }
+
+			const Zone* const GetZoneHandle() const { return zone_arr_; }
+			const Rule* const GetRuleHandle() const { return rule_arr_; }
+			const Zones& GetZones() const { return zones_; }
+
+			// first is -1 when the tzdb file has no precompiled transitions
+			const UtcTransition* const GetUtcTransitionHandle() const { return utc_transition_arr_; }
+			const UtcTransitions& GetUtcTransitions() const { return utc_transitions_; }
+
+			// Integer forms of the zone's precompiled transitions, GetUtcTransitions().size
+			// of each in the snapshot's tables, null when the zone has none
+			const RDTicks* const GetUtcTransitionTicks() const { return utc_transition_ticks_; }
+			const RDTicks* const GetOffsetTicks() const { return offset_ticks_; }
+			RDTicks GetTailTicks() const { return tail_ticks_; }
+
+			Rules FindRules(const Zone* const zone) const;
+			RuleYearRanges FindRuleYearRanges(const Zone* const zone) const;
+
+		private:
+			ZoneHandle(const std::string& time_zone_name, const ZoneLiteral* const zone_literal);
+
+			bool MatchesSnapshot(const ZoneLiteral& zone_literal) const;
+
+			std::string name_;
+			uint32_t zone_id_;
+			std::shared_ptr<const TzdbSnapshot> snapshot_;
+
+			const Zone* zone_arr_;
+			const Rule* rule_arr_;
+			const UtcTransition* utc_transition_arr_;
+
+			Zones zones_;
+			UtcTransitions utc_transitions_;
+			// parallel to the zone lines in zones_
+			std::vector<Rules> zone_rules_;
+			std::vector<RuleYearRanges> zone_rule_years_;
+
+			const RDTicks* utc_transition_ticks_;
+			const RDTicks* offset_ticks_;
+			RDTicks tail_ticks_;
+		};
+	}
+}
+
+#endif
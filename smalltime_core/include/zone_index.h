@@ -0,0 +1,53 @@
+#pragma once
+#ifndef _ZONE_INDEX_
+#define _ZONE_INDEX_
+
+#include "core_decls.h"
+#include "tz_decls.h"
+
+#include <cinttypes>
+#include <cstddef>
+#include <string>
+
+namespace smalltime
+{
+	namespace tz
+	{
+		//=====================================================================
+		// Minimal perfect hash over every zone and link name, built by the
+		// compiler with hash and displace (CHD). A name hashes to a bucket,
+		// the bucket's displacement picks the one slot the name can be in
+		//=====================================================================
+
+		// Average names per bucket
+		static const int KZONE_INDEX_BUCKET_LOAD = 4;
+		static const uint32_t KZONE_INDEX_SEED = 0x5a4f4e45;
+
+		struct ZoneNameHash
+		{
+			uint32_t bucket;
+			uint32_t f1;
+			uint32_t f2;
+		};
+
+		ZoneNameHash HashZoneName(const char* name, std::size_t size);
+
+		//===================================================================
+		// Slot of a hashed name, the displacement packs d0 in the high and
+		// d1 in the low 16 bits
+		//===================================================================
+		inline uint32_t ZoneIndexSlotOf(const ZoneNameHash& hash, uint32_t displacement, uint32_t slot_count)
+		{
+			uint64_t d0 = displacement >> 16;
+			uint64_t d1 = displacement & 0xffff;
+
+			return static_cast<uint32_t>((hash.f1 + d0 * hash.f2 + d1) % slot_count);
+		}
+
+		// Index into the zone lookup array, -1 when name is not a zone or link
+		int FindZoneIndex(const std::string& name, const uint32_t* displacement_arr, int bucket_count,
+			const ZoneIndexSlot* slot_arr, int slot_count, const char* name_arr);
+	}
+}
+
+#endif
@@ -1,6 +1,8 @@
 #include "../include/core_math.h"
 #include "../include/murmur_hash3.h"
 
+#include <array>
+
 namespace smalltime
 {
 	namespace math
@@ -31,6 +33,33 @@ namespace smalltime
 			return ret_id;
 		}
 
+		//======================================================================
+		// CRC-32 (IEEE 802.3, reflected) checksum of a block of bytes
+		//========================================================================
+		uint32_t Crc32(const void* data, std::size_t size)
+		{
+			static const std::array<uint32_t, 256> crc_table = []()
+			{
+				std::array<uint32_t, 256> table;
+				for (uint32_t i = 0; i < 256; ++i)
+				{
+					uint32_t c = i;
+					for (int k = 0; k < 8; ++k)
+						c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+
+					table[i] = c;
+				}
+				return table;
+			}();
+
+			auto bytes = static_cast<const unsigned char*>(data);
+			uint32_t crc = 0xffffffffu;
+			for (std::size_t i = 0; i < size; ++i)
+				crc = crc_table[(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+
+			return crc ^ 0xffffffffu;
+		}
+
 		//=====================================================================
 		// Store first 4 chars of string into uint32_t else fill with 0
 		//=====================================================================
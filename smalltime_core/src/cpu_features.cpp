@@ -0,0 +1,106 @@
+#include "../include/cpu_features.h"
+
+#if defined(SMALLTIME_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace smalltime
+{
+	namespace cpu
+	{
+#if defined(SMALLTIME_X86)
+		//==========================================
+		// Query a cpuid leaf
+		//==========================================
+		static void CpuId(unsigned int leaf, unsigned int sub_leaf, unsigned int regs[4])
+		{
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuidex(info, static_cast<int>(leaf), static_cast<int>(sub_leaf));
+			for (int i = 0; i < 4; ++i)
+				regs[i] = static_cast<unsigned int>(info[i]);
+#else
+			__cpuid_count(leaf, sub_leaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+		}
+
+		//====================================================
+		// Check for AVX and that the OS saves the ymm registers
+		//====================================================
+		static bool OsSavesYmm()
+		{
+			unsigned int regs[4];
+			CpuId(1, 0, regs);
+			// osxsave and avx
+			if ((regs[2] & (1u << 27)) == 0 || (regs[2] & (1u << 28)) == 0)
+				return false;
+#if defined(_MSC_VER)
+			unsigned long long xcr0 = _xgetbv(0);
+#else
+			unsigned int xcr0_lo = 0, xcr0_hi = 0;
+			__asm__ volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+			unsigned long long xcr0 = (static_cast<unsigned long long>(xcr0_hi) << 32) | xcr0_lo;
+#endif
+			return (xcr0 & 0x6) == 0x6;
+		}
+
+		//==========================================
+		// SSE4.1 support
+		//==========================================
+		bool HasSse41()
+		{
+			static const bool has_sse41 = []()
+			{
+				unsigned int regs[4];
+				CpuId(0, 0, regs);
+				if (regs[0] < 1)
+					return false;
+
+				CpuId(1, 0, regs);
+				return (regs[2] & (1u << 19)) != 0;
+			}();
+
+			return has_sse41;
+		}
+
+		//==========================================
+		// AVX2 support, including the OS state
+		//==========================================
+		bool HasAvx2()
+		{
+			static const bool has_avx2 = []()
+			{
+				unsigned int regs[4];
+				CpuId(0, 0, regs);
+				if (regs[0] < 7 || !OsSavesYmm())
+					return false;
+
+				CpuId(7, 0, regs);
+				return (regs[1] & (1u << 5)) != 0;
+			}();
+
+			return has_avx2;
+		}
+#else
+		//==========================================
+		// Not an x86 target, scalar only
+		//==========================================
+		bool HasSse41()
+		{
+			return false;
+		}
+
+		//==========================================
+		// Not an x86 target, scalar only
+		//==========================================
+		bool HasAvx2()
+		{
+			return false;
+		}
+#endif
+	}
+}
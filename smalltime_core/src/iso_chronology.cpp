@@ -2,6 +2,8 @@
 #include "../include/chrono_decls.h"
 #include "../include/cal_math.h"
 #include "../include/time_math.h"
+#include "../include/iso_chronology_batch.h"
+#include "../include/cpu_features.h"
 
 namespace smalltime
 {
@@ -13,71 +15,17 @@ namespace smalltime
 		using YD = std::array<int, 2>;
 		using HMS = std::array<int, 4>;
 
-		static const RD KISO_EPOCH = 1.0;
-		static constexpr double KYear4 = 1.0 / 4.0;
-		static constexpr double KYear100 = 1.0 / 100.0;
-		static constexpr double KYear400 = 1.0 / 400.0;
-
-		//============================================================
-		// Calculate the RD format from the year, month, day format
-		//============================================================
-		RD IsoChronology::FixedFromYmd(int year, int month, int day) const
-		{
-			//If month out of range (e.g. 13) we'll catch that error as bad date
-			//Want to throw a bad date exception not an array out of range exception
-			int month_index = (month - 1) % 12;
-			double m = iso_julian::KSTD_MONTH_BIAS[month_index];
-			//double y = year - Floor(m / 10.0);
-			double y = static_cast<double>(year) - iso_julian::KSTD_YEAR_BIAS[month_index];
-
-			double leap4 = std::floor(y * KYear4);
-			double leap100 = std::floor(y * KYear100);
-			double leap400 = std::floor(y * KYear400);
-
-			double month_days = iso_julian::KSTD_BASE_MONTH_DAYS[month_index];
-
-			RD rd = KISO_EPOCH - 307.0 + (365.0 * y) + leap4 - leap100 + leap400 + month_days + 30.0 * m + day;
-
-			return rd;
-		}
-
-		//====================================================================
-		// Calculate the RD format from the year, week, day format
-		//====================================================================
-		RD IsoChronology::FixedFromYwd(int year, int week, int day) const
+		//=========================================================
+		// Calculate the YMD format of n RD values
+		//=========================================================
+		void IsoChronology::YmdFromFixed(const RD* rd, int32_t* year, int32_t* month, int32_t* day, std::size_t n) const
 		{
-			//the amount of day that can fall in previous cycle, add 1 to bias for week starting on Mon and Sun being end of week
-			//To find the earliest Mon we just move Sun back 1 day
-			int max_days_of_prev_year = 7 - min_days_in_first_week_ + 1;
-			return math::NthKDay(0, week, FixedFromYmd(year, 1, 1) - max_days_of_prev_year) + day;
-		}
-
-		//==================================================================
-		// Calculate the RD format from year, day format
-		//==================================================================
-		RD IsoChronology::FixedFromYd(int year, int day) const
-		{
-			RD fp = FixedFromYmd(year, 1, 1);
-			return fp + static_cast<RD>(day) - 1;
-		}
-
-		//=====================================================
-		// Calculate the YMD format from RD format
-		//=====================================================
-		YMD IsoChronology::YmdFromFixed(RD rd) const
-		{
-			RD rd_only = math::ExtractDate(rd);
-
-			int y = DetermineYearFromFixed(KISO_EPOCH - 1.0 + rd_only + 306.0);
-			double prior_days = rd_only - FixedFromYmd(y - 1, 3, 1);
-
-			double m = std::floor((1.0 / 153.0) * (5.0 * prior_days + 2));
-			double month = math::AFlMod(m + 3.0, 12.0);
-
-			double year = y - std::floor((month + 9.0) / 12.0);
-			double day = rd_only - FixedFromYmd(year, month, 1) + 1.0;
-
-			return{ static_cast<int>(year), static_cast<int>(month), static_cast<int>(day) };
+			if (cpu::HasAvx2())
+				batch::YmdFromFixedAvx2(rd, year, month, day, n);
+			else if (cpu::HasSse41())
+				batch::YmdFromFixedSse41(rd, year, month, day, n);
+			else
+				batch::YmdFromFixedScalar(rd, year, month, day, n);
 		}
 
 		//===================================================
@@ -257,14 +205,6 @@ namespace smalltime
 			return relative_rd;
 		}
 
-		//=====================================================
-		// Calculate RD format from time fields
-		//=====================================================
-		RD IsoChronology::FixedFromTime(int hour, int min, int sec, int milli) const
-		{
-			return math::FixedFromTime(hour, min, sec, milli);
-		}
-
 		//====================================================
 		// calculate time fields from RD format
 		//====================================================
@@ -273,6 +213,14 @@ namespace smalltime
 			return math::HmsFromFixed(rd);
 		}
 
+		//====================================================
+		// calculate time fields from ticks
+		//====================================================
+		HMS IsoChronology::TimeFromTicks(RDTicks ticks) const
+		{
+			return math::HmsFromTicks(ticks);
+		}
+
 		//=============================================================================
 		// calculate the week of month with min amount of days in first week
 		//=============================================================================
@@ -294,28 +242,5 @@ namespace smalltime
 
 		}
 
-		//=====================================================
-		// Find if the given year is a leap year
-		//=====================================================
-		bool IsoChronology::IsLeapYear(int year) const
-		{
-			unsigned int abs_year = abs(year);
-			const unsigned int leap100 = 100;
-			const unsigned int leap400 = 400;
-
-			if (math::FastMod4(abs_year) == 0)
-			{
-				if (abs_year % leap100 == 0)
-				{
-					if (abs_year % leap400 == 0)
-						return true;
-					else
-						return false;
-				}
-				return true;
-			}
-			return false;
-		}
-
 	}
 }
\ No newline at end of file
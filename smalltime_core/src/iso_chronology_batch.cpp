@@ -0,0 +1,203 @@
+#include "../include/iso_chronology_batch.h"
+#include "../include/cpu_features.h"
+
+#include <cmath>
+
+#if defined(SMALLTIME_X86)
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#define SMALLTIME_TARGET_SSE41
+#define SMALLTIME_TARGET_AVX2
+#else
+#define SMALLTIME_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define SMALLTIME_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace smalltime
+{
+	namespace chrono
+	{
+		namespace batch
+		{
+			//==========================================
+			// Scalar kernel
+			//==========================================
+			void YmdFromFixedScalar(const RD* rd, int32_t* year, int32_t* month, int32_t* day, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; ++i)
+					YmdFromDay(static_cast<int64_t>(std::floor(rd[i])), year[i], month[i], day[i]);
+			}
+
+#if defined(SMALLTIME_X86)
+			//=====================================================================
+			// Reciprocal nudged up by 2^-45, the product with a whole number
+			// below 2^40 then floors to the exact quotient without correction
+			//=====================================================================
+			static inline double FloorReciprocal(double divisor)
+			{
+				return (1.0 / divisor) * (1.0 + 1.0 / 35184372088832.0);
+			}
+
+			//==========================================
+			// Floor division of whole lanes
+			//==========================================
+			SMALLTIME_TARGET_SSE41 static inline __m128d FloorDiv(__m128d a, __m128d inv_b)
+			{
+				return _mm_floor_pd(_mm_mul_pd(a, inv_b));
+			}
+
+			//==========================================
+			// Floor division of whole lanes
+			//==========================================
+			SMALLTIME_TARGET_AVX2 static inline __m256d FloorDiv(__m256d a, __m256d inv_b)
+			{
+				return _mm256_floor_pd(_mm256_mul_pd(a, inv_b));
+			}
+
+			//==========================================
+			// SSE4.1 kernel, two days per step
+			//==========================================
+			SMALLTIME_TARGET_SSE41 void YmdFromFixedSse41(const RD* rd, int32_t* year, int32_t* month, int32_t* day, std::size_t n)
+			{
+				const __m128d min_day = _mm_set1_pd(KMIN_DAY);
+				const __m128d max_day = _mm_set1_pd(KMAX_DAY);
+				const __m128d shift = _mm_set1_pd(static_cast<double>(KMARCH_SHIFT + KERA_BIAS * KERA_DAYS));
+				const __m128d year_bias = _mm_set1_pd(static_cast<double>(KERA_BIAS * 400));
+
+				const __m128d era_days = _mm_set1_pd(static_cast<double>(KERA_DAYS));
+				const __m128d inv_era_days = _mm_set1_pd(FloorReciprocal(static_cast<double>(KERA_DAYS)));
+				const __m128d inv_year_div = _mm_set1_pd(FloorReciprocal(4.0 * 2939745.0));
+				const __m128d month_div = _mm_set1_pd(2141.0);
+				const __m128d inv_month_div = _mm_set1_pd(FloorReciprocal(2141.0));
+
+				const __m128d one = _mm_set1_pd(1.0);
+				const __m128d three = _mm_set1_pd(3.0);
+				const __m128d four = _mm_set1_pd(4.0);
+				const __m128d quarter = _mm_set1_pd(0.25);
+				const __m128d two_32 = _mm_set1_pd(4294967296.0);
+				const __m128d inv_two_32 = _mm_set1_pd(1.0 / 4294967296.0);
+				const __m128d two_16 = _mm_set1_pd(65536.0);
+				const __m128d inv_two_16 = _mm_set1_pd(1.0 / 65536.0);
+
+				std::size_t i = 0;
+				for (; i + 2 <= n; i += 2)
+				{
+					__m128d rd_day = _mm_floor_pd(_mm_loadu_pd(rd + i));
+
+					__m128d in_range = _mm_and_pd(_mm_cmpge_pd(rd_day, min_day), _mm_cmple_pd(rd_day, max_day));
+					if (_mm_movemask_pd(in_range) != 0x3)
+					{
+						YmdFromFixedScalar(rd + i, year + i, month + i, day + i, 2);
+						continue;
+					}
+
+					// every lane is a whole number below 2^53, so products are exact
+					__m128d n1 = _mm_add_pd(_mm_mul_pd(_mm_add_pd(rd_day, shift), four), three);
+					__m128d century = FloorDiv(n1, inv_era_days);
+					__m128d n2 = _mm_add_pd(_mm_mul_pd(_mm_floor_pd(_mm_mul_pd(_mm_sub_pd(n1, _mm_mul_pd(century, era_days)), quarter)), four), three);
+
+					__m128d p2 = _mm_mul_pd(n2, _mm_set1_pd(2939745.0));
+					__m128d year_of_century = _mm_floor_pd(_mm_mul_pd(p2, inv_two_32));
+					__m128d day_of_year = FloorDiv(_mm_sub_pd(p2, _mm_mul_pd(year_of_century, two_32)), inv_year_div);
+
+					__m128d n3 = _mm_add_pd(_mm_mul_pd(day_of_year, month_div), _mm_set1_pd(197913.0));
+					__m128d m = _mm_floor_pd(_mm_mul_pd(n3, inv_two_16));
+					__m128d d = _mm_add_pd(FloorDiv(_mm_sub_pd(n3, _mm_mul_pd(m, two_16)), inv_month_div), one);
+
+					// January and February belong to the next year
+					__m128d next_year = _mm_and_pd(_mm_cmpge_pd(day_of_year, _mm_set1_pd(306.0)), one);
+					__m128d y = _mm_add_pd(_mm_sub_pd(_mm_add_pd(_mm_mul_pd(century, _mm_set1_pd(100.0)), year_of_century), year_bias), next_year);
+					m = _mm_sub_pd(m, _mm_mul_pd(next_year, _mm_set1_pd(12.0)));
+
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(year + i), _mm_cvtpd_epi32(y));
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(month + i), _mm_cvtpd_epi32(m));
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(day + i), _mm_cvtpd_epi32(d));
+				}
+
+				YmdFromFixedScalar(rd + i, year + i, month + i, day + i, n - i);
+			}
+
+			//==========================================
+			// AVX2 kernel, four days per step
+			//==========================================
+			SMALLTIME_TARGET_AVX2 void YmdFromFixedAvx2(const RD* rd, int32_t* year, int32_t* month, int32_t* day, std::size_t n)
+			{
+				const __m256d min_day = _mm256_set1_pd(KMIN_DAY);
+				const __m256d max_day = _mm256_set1_pd(KMAX_DAY);
+				const __m256d shift = _mm256_set1_pd(static_cast<double>(KMARCH_SHIFT + KERA_BIAS * KERA_DAYS));
+				const __m256d year_bias = _mm256_set1_pd(static_cast<double>(KERA_BIAS * 400));
+
+				const __m256d era_days = _mm256_set1_pd(static_cast<double>(KERA_DAYS));
+				const __m256d inv_era_days = _mm256_set1_pd(FloorReciprocal(static_cast<double>(KERA_DAYS)));
+				const __m256d inv_year_div = _mm256_set1_pd(FloorReciprocal(4.0 * 2939745.0));
+				const __m256d month_div = _mm256_set1_pd(2141.0);
+				const __m256d inv_month_div = _mm256_set1_pd(FloorReciprocal(2141.0));
+
+				const __m256d one = _mm256_set1_pd(1.0);
+				const __m256d three = _mm256_set1_pd(3.0);
+				const __m256d four = _mm256_set1_pd(4.0);
+				const __m256d quarter = _mm256_set1_pd(0.25);
+				const __m256d two_32 = _mm256_set1_pd(4294967296.0);
+				const __m256d inv_two_32 = _mm256_set1_pd(1.0 / 4294967296.0);
+				const __m256d two_16 = _mm256_set1_pd(65536.0);
+				const __m256d inv_two_16 = _mm256_set1_pd(1.0 / 65536.0);
+
+				std::size_t i = 0;
+				for (; i + 4 <= n; i += 4)
+				{
+					__m256d rd_day = _mm256_floor_pd(_mm256_loadu_pd(rd + i));
+
+					__m256d in_range = _mm256_and_pd(_mm256_cmp_pd(rd_day, min_day, _CMP_GE_OQ), _mm256_cmp_pd(rd_day, max_day, _CMP_LE_OQ));
+					if (_mm256_movemask_pd(in_range) != 0xF)
+					{
+						YmdFromFixedScalar(rd + i, year + i, month + i, day + i, 4);
+						continue;
+					}
+
+					// every lane is a whole number below 2^53, so products are exact
+					__m256d n1 = _mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(rd_day, shift), four), three);
+					__m256d century = FloorDiv(n1, inv_era_days);
+					__m256d n2 = _mm256_add_pd(_mm256_mul_pd(_mm256_floor_pd(_mm256_mul_pd(_mm256_sub_pd(n1, _mm256_mul_pd(century, era_days)), quarter)), four), three);
+
+					__m256d p2 = _mm256_mul_pd(n2, _mm256_set1_pd(2939745.0));
+					__m256d year_of_century = _mm256_floor_pd(_mm256_mul_pd(p2, inv_two_32));
+					__m256d day_of_year = FloorDiv(_mm256_sub_pd(p2, _mm256_mul_pd(year_of_century, two_32)), inv_year_div);
+
+					__m256d n3 = _mm256_add_pd(_mm256_mul_pd(day_of_year, month_div), _mm256_set1_pd(197913.0));
+					__m256d m = _mm256_floor_pd(_mm256_mul_pd(n3, inv_two_16));
+					__m256d d = _mm256_add_pd(FloorDiv(_mm256_sub_pd(n3, _mm256_mul_pd(m, two_16)), inv_month_div), one);
+
+					// January and February belong to the next year
+					__m256d next_year = _mm256_and_pd(_mm256_cmp_pd(day_of_year, _mm256_set1_pd(306.0), _CMP_GE_OQ), one);
+					__m256d y = _mm256_add_pd(_mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(century, _mm256_set1_pd(100.0)), year_of_century), year_bias), next_year);
+					m = _mm256_sub_pd(m, _mm256_mul_pd(next_year, _mm256_set1_pd(12.0)));
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(year + i), _mm256_cvtpd_epi32(y));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(month + i), _mm256_cvtpd_epi32(m));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(day + i), _mm256_cvtpd_epi32(d));
+				}
+
+				YmdFromFixedScalar(rd + i, year + i, month + i, day + i, n - i);
+			}
+#else
+			//==========================================
+			// No simd on this target
+			//==========================================
+			void YmdFromFixedSse41(const RD* rd, int32_t* year, int32_t* month, int32_t* day, std::size_t n)
+			{
+				YmdFromFixedScalar(rd, year, month, day, n);
+			}
+
+			//==========================================
+			// No simd on this target
+			//==========================================
+			void YmdFromFixedAvx2(const RD* rd, int32_t* year, int32_t* month, int32_t* day, std::size_t n)
+			{
+				YmdFromFixedScalar(rd, year, month, day, n);
+			}
+#endif
+		}
+	}
+}
@@ -0,0 +1,125 @@
+#include "../include/mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace smalltime
+{
+	namespace fileutil
+	{
+		//==========================================
+		// Ctor
+		//==========================================
+#ifdef _WIN32
+		MappedFile::MappedFile() : data_(nullptr), size_(0), file_handle_(INVALID_HANDLE_VALUE), map_handle_(nullptr)
+		{
+
+		}
+#else
+		MappedFile::MappedFile() : data_(nullptr), size_(0)
+		{
+
+		}
+#endif
+
+		//==========================================
+		// Dtor - release the mapping if any
+		//==========================================
+		MappedFile::~MappedFile()
+		{
+			Close();
+		}
+
+		//=====================================================
+		// Map whole file read-only, returns false on failure
+		//=====================================================
+		bool MappedFile::Open(const std::string& path)
+		{
+			Close();
+
+#ifdef _WIN32
+			file_handle_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file_handle_ == INVALID_HANDLE_VALUE)
+				return false;
+
+			LARGE_INTEGER file_size;
+			if (!GetFileSizeEx(file_handle_, &file_size) || file_size.QuadPart == 0)
+			{
+				Close();
+				return false;
+			}
+
+			map_handle_ = CreateFileMappingA(file_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (map_handle_ == nullptr)
+			{
+				Close();
+				return false;
+			}
+
+			data_ = static_cast<const char*>(MapViewOfFile(map_handle_, FILE_MAP_READ, 0, 0, 0));
+			if (data_ == nullptr)
+			{
+				Close();
+				return false;
+			}
+
+			size_ = static_cast<std::size_t>(file_size.QuadPart);
+#else
+			int fd = open(path.c_str(), O_RDONLY);
+			if (fd == -1)
+				return false;
+
+			struct stat file_stat;
+			if (fstat(fd, &file_stat) == -1 || file_stat.st_size == 0)
+			{
+				close(fd);
+				return false;
+			}
+
+			void* addr = mmap(nullptr, static_cast<std::size_t>(file_stat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+			// the mapping holds its own reference to the file
+			close(fd);
+
+			if (addr == MAP_FAILED)
+				return false;
+
+			data_ = static_cast<const char*>(addr);
+			size_ = static_cast<std::size_t>(file_stat.st_size);
+#endif
+
+			return true;
+		}
+
+		//==========================================
+		// Unmap file
+		//==========================================
+		void MappedFile::Close()
+		{
+#ifdef _WIN32
+			if (data_)
+				UnmapViewOfFile(data_);
+			if (map_handle_)
+				CloseHandle(map_handle_);
+			if (file_handle_ != INVALID_HANDLE_VALUE)
+				CloseHandle(file_handle_);
+
+			map_handle_ = nullptr;
+			file_handle_ = INVALID_HANDLE_VALUE;
+#else
+			if (data_)
+				munmap(const_cast<char*>(data_), size_);
+#endif
+
+			data_ = nullptr;
+			size_ = 0;
+		}
+
+	}
+}
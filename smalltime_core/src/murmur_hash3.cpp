@@ -7,7 +7,7 @@
 // compile and run any of them on any platform, but your performance with the
 // non-native version will be less than optimal.
 
-#include "..\include\murmur_hash3.h"
+#include "../include/murmur_hash3.h"
 
 //-----------------------------------------------------------------------------
 // Platform-specific functions and macros
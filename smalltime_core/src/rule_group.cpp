@@ -1,7 +1,6 @@
 
 #include "../include/rule_group.h"
 #include "../include/smalltime_exceptions.h"
-#include "../include/float_util.h"
 #include "../include/time_math.h"
 #include <iostream>
 #include <assert.h>
@@ -16,24 +15,26 @@ namespace smalltime
 		//=======================================
 		// Ctor
 		//======================================
-		RuleGroup::RuleGroup(Rules rules, const Rule* const rule_arr, const Zone* const zone, const Zone* const prev_zone) :
+		RuleGroup::RuleGroup(Rules rules, const Rule* const rule_arr, const Zone* const zone, const Zone* const prev_zone, TransitionCache* const transition_cache, Status* const status,
+			const RuleYearRange* const year_range_arr, RuleYearRanges year_ranges) :
+			rule_arr_(rule_arr),
+			rules_(rules),
+			year_range_arr_(year_range_arr == nullptr || year_ranges.first == -1 ? nullptr : year_range_arr + year_ranges.first),
+			year_ranges_(year_ranges),
 			zone_(zone),
 			prev_zone_(prev_zone),
-			rules_(rules),
-			rule_arr_(rule_arr),
-			current_year_(0),
-			primary_year_(0),
-			previous_year_(0),
-			next_year_(0),
-			primary_year_transitions_(KSTART_SIZE),
-			prev_year_transitions_(KSTART_SIZE),
-			next_year_transitions_(KSTART_SIZE),
+			transition_cache_(transition_cache),
+			status_(status),
 			zone_transition_(zone_->mb_until_utc, zone_->zone_offset, zone_->next_zone_offset, zone_->mb_rule_offset, zone_->trans_rule_offset),
 			prev_zone_transition_(prev_zone == nullptr ? 0.0 : prev_zone->mb_until_utc,
 				prev_zone == nullptr ? 0.0 : prev_zone->zone_offset,
 				prev_zone == nullptr ? 0.0 : prev_zone->next_zone_offset,
 				prev_zone == nullptr ? 0.0 : prev_zone->mb_rule_offset,
-				prev_zone == nullptr ? 0.0 : prev_zone->trans_rule_offset)
+				prev_zone == nullptr ? 0.0 : prev_zone->trans_rule_offset),
+			current_year_(0),
+			primary_year_(0),
+			previous_year_(0),
+			next_year_(0)
 		{
 
 		}
@@ -48,6 +49,9 @@ namespace smalltime
 
 			current_year_ = year;
 
+			if (transition_cache_ && LoadTransitionData(year))
+				return;
+
 			// set the active years
 			primary_year_ = FindClosestActiveYear(year);
 			previous_year_ = FindPreviousActiveYear(primary_year_);
@@ -58,6 +62,71 @@ namespace smalltime
 			BuildTransitionData(prev_year_transitions_, previous_year_);
 			// build transition data for next closest year
 			BuildTransitionData(next_year_transitions_, next_year_);
+
+			if (transition_cache_)
+				StoreTransitionData(year);
+		}
+
+		//=================================================================
+		// Fill the active years and transitions from the cache if there
+		//=================================================================
+		bool RuleGroup::LoadTransitionData(int year)
+		{
+			YearTransitions year_transitions;
+			if (!transition_cache_->Find(rules_, year, year_transitions))
+				return false;
+
+			primary_year_ = year_transitions.primary_year;
+			previous_year_ = year_transitions.previous_year;
+			next_year_ = year_transitions.next_year;
+
+			primary_year_transitions_.clear();
+			for (int i = 0; i < year_transitions.primary_size; ++i)
+				primary_year_transitions_.emplace_back(year_transitions.primary[i].ticks, year_transitions.primary[i].rule_index);
+
+			prev_year_transitions_.clear();
+			for (int i = 0; i < year_transitions.prev_size; ++i)
+				prev_year_transitions_.emplace_back(year_transitions.prev[i].ticks, year_transitions.prev[i].rule_index);
+
+			next_year_transitions_.clear();
+			for (int i = 0; i < year_transitions.next_size; ++i)
+				next_year_transitions_.emplace_back(year_transitions.next[i].ticks, year_transitions.next[i].rule_index);
+
+			return true;
+		}
+
+		//=================================================================
+		// Publish the active years and transitions, years with more
+		// transitions than an entry holds are left out
+		//=================================================================
+		void RuleGroup::StoreTransitionData(int year)
+		{
+			if (primary_year_transitions_.size() > KCACHE_YEAR_SIZE || prev_year_transitions_.size() > KCACHE_YEAR_SIZE ||
+				next_year_transitions_.size() > KCACHE_YEAR_SIZE)
+				return;
+
+			YearTransitions year_transitions = {};
+			year_transitions.rule_first = rules_.first;
+			year_transitions.rule_size = rules_.size;
+			year_transitions.year = year;
+
+			year_transitions.primary_year = primary_year_;
+			year_transitions.previous_year = previous_year_;
+			year_transitions.next_year = next_year_;
+
+			year_transitions.primary_size = static_cast<int32_t>(primary_year_transitions_.size());
+			for (int i = 0; i < year_transitions.primary_size; ++i)
+				year_transitions.primary[i] = { primary_year_transitions_[i].first, primary_year_transitions_[i].second, 0 };
+
+			year_transitions.prev_size = static_cast<int32_t>(prev_year_transitions_.size());
+			for (int i = 0; i < year_transitions.prev_size; ++i)
+				year_transitions.prev[i] = { prev_year_transitions_[i].first, prev_year_transitions_[i].second, 0 };
+
+			year_transitions.next_size = static_cast<int32_t>(next_year_transitions_.size());
+			for (int i = 0; i < year_transitions.next_size; ++i)
+				year_transitions.next[i] = { next_year_transitions_[i].first, next_year_transitions_[i].second, 0 };
+
+			transition_cache_->Insert(year_transitions);
 		}
 
 		//====================================================
@@ -68,20 +137,18 @@ namespace smalltime
 			InitTransitionData(cur_dt.GetYear());
 
 			const Rule* closest_rule = nullptr;
-			RuleTransition closest_rule_transition(0.0, 0.0, 0.0, 0.0);
+			RuleTransition closest_rule_transition(0, 0, 0, 0);
+			RDTicks cur_ticks = math::TicksFromFixed(cur_dt.GetFixed());
 
-			RD closest_diff = DMAX;
-			RD diff = 0.0;
-
-			//RuleTransition cur_rule_transition(0.0, 0.0, 0.0, 0.0);
-			RD trans_any = 0.0;
+			RDTicks closest_diff = DMAX_TICKS;
+			RDTicks diff = 0;
+			RDTicks trans_any = 0;
 
 			// check the primary pool for an active rule 
 			for (const auto& rule_transition : primary_year_transitions_)
 			{
-				
 				auto r = &rule_arr_[rule_transition.second];
-				auto  cur_rule_transition = CalcRuleData(r, primary_year_);
+				auto cur_rule_transition = CalcRuleData(r, primary_year_);
 
 				switch (cur_dt.GetType())
 				{
@@ -96,27 +163,24 @@ namespace smalltime
 					break;
 				}
 
-				diff = cur_dt.GetFixed() - trans_any;
-				if ((diff > 0.0 || AlmostEqualUlps(cur_dt.GetFixed(), trans_any, 11)) && diff < closest_diff)
+				diff = cur_ticks - trans_any;
+				if (diff >= 0 && diff < closest_diff)
 				{
 					closest_rule_transition = cur_rule_transition;
 					closest_diff = diff;
 					closest_rule = r;
 				}
-
 			}
 
 			if (closest_rule)
-				return CorrectForAmbigAny(cur_dt, closest_rule_transition, closest_rule, choose);
+				return CorrectForAmbigAny(cur_ticks, cur_dt.GetType(), closest_rule_transition, closest_rule, choose);
 
 			// Closest rule not found, check previous
-			diff = 0.0;
-			// check the previous pool for an active rule 
+			// check the prev pool for an active rule 
 			for (const auto& rule_transition : prev_year_transitions_)
 			{
-		
 				auto r = &rule_arr_[rule_transition.second];
-				auto  cur_rule_transition = CalcRuleData(r, previous_year_);
+				auto cur_rule_transition = CalcRuleData(r, previous_year_);
 
 				switch (cur_dt.GetType())
 				{
@@ -131,18 +195,17 @@ namespace smalltime
 					break;
 				}
 
-				diff = cur_dt.GetFixed() - trans_any;
-				if ((diff > 0.0 || AlmostEqualUlps(cur_dt.GetFixed(), trans_any, 11)) && diff < closest_diff)
+				diff = cur_ticks - trans_any;
+				if (diff >= 0 && diff < closest_diff)
 				{
 					closest_rule_transition = cur_rule_transition;
 					closest_diff = diff;
 					closest_rule = r;
 				}
-				
 			}
 
 			if (closest_rule)
-				return CorrectForAmbigAny(cur_dt, closest_rule_transition, closest_rule, choose);
+				return CorrectForAmbigAny(cur_ticks, cur_dt.GetType(), closest_rule_transition, closest_rule, choose);
 			else
 				return closest_rule;
 		}
@@ -155,20 +218,18 @@ namespace smalltime
 			InitTransitionData(cur_dt.GetYear());
 
 			const Rule* closest_rule = nullptr;
-			RuleTransition closest_rule_transition(0.0, 0.0, 0.0, 0.0);
+			RuleTransition closest_rule_transition(0, 0, 0, 0);
+			RDTicks cur_ticks = math::TicksFromFixed(cur_dt.GetFixed());
 
-			RD closest_diff = DMAX;
-			RD diff = 0.0;
-
-			//RuleTransition cur_rule_transition(0.0, 0.0, 0.0, 0.0);
-			RD trans_any = 0.0;
+			RDTicks closest_diff = DMAX_TICKS;
+			RDTicks diff = 0;
+			RDTicks trans_any = 0;
 
 			// check the primary pool for an active rule 
 			for (const auto& rule_transition : primary_year_transitions_)
 			{
-
 				auto r = &rule_arr_[rule_transition.second];
-				auto  cur_rule_transition = CalcRuleData(r, primary_year_);
+				auto cur_rule_transition = CalcRuleData(r, primary_year_);
 
 				switch (cur_dt.GetType())
 				{
@@ -183,26 +244,24 @@ namespace smalltime
 					break;
 				}
 
-				diff = cur_dt.GetFixed() - trans_any;
-				if ((diff > 0.0 || AlmostEqualUlps(cur_dt.GetFixed(), trans_any, 11)) && diff < closest_diff)
+				diff = cur_ticks - trans_any;
+				if (diff >= 0 && diff < closest_diff)
 				{
 					closest_rule_transition = cur_rule_transition;
 					closest_diff = diff;
 					closest_rule = r;
 				}
-
 			}
 
 			if (closest_rule)
 				return closest_rule;
 
 			// Closest rule not found, check previous
-			diff = 0.0;
-			// check the previous pool for an active rule 
+			// check the prev pool for an active rule 
 			for (const auto& rule_transition : prev_year_transitions_)
 			{
 				auto r = &rule_arr_[rule_transition.second];
-				auto  cur_rule_transition = CalcRuleData(r, previous_year_);
+				auto cur_rule_transition = CalcRuleData(r, previous_year_);
 
 				switch (cur_dt.GetType())
 				{
@@ -217,82 +276,34 @@ namespace smalltime
 					break;
 				}
 
-				diff = cur_dt.GetFixed() - trans_any;
-				if ((diff > 0.0 || AlmostEqualUlps(cur_dt.GetFixed(), trans_any, 11)) && diff < closest_diff)
+				diff = cur_ticks - trans_any;
+				if (diff >= 0 && diff < closest_diff)
 				{
 					closest_rule_transition = cur_rule_transition;
 					closest_diff = diff;
 					closest_rule = r;
 				}
-
-			}
-	
-			return closest_rule;
-		}
-
-		//==============================================
-		// Find the previous rule in effect if any
-		//===============================================
-		std::pair<const Rule* const, int> RuleGroup::FindPreviousRule(BasicDateTime<> cur_rule)
-		{
-			const Rule* prev_rule = nullptr;
-			int prev_rule_year = 0;
-			RD closest_diff = 0.0;
-			RD diff = 0.0;
-			// check the primary pool for an active rule 
-			for (const auto& rule_transition : primary_year_transitions_)
-			{
-				auto rule_rd = rule_transition.first;
-				diff = cur_rule.GetFixed() - rule_rd;
-				// rule transition is not null and before rd
-				if (diff > 0.0 && rule_rd > closest_diff)
-				{
-					closest_diff = rule_rd;
-					prev_rule = &rule_arr_[rule_transition.second];
-					prev_rule_year = primary_year_;
-				}
-			}
-			// if a previous rule wasn't found check secondary pool
-			if (prev_rule == nullptr)
-			{
-				diff = 0.0;
-				closest_diff = 0.0;
-				for (const auto& rule_transition : prev_year_transitions_)
-				{
-					auto rule_rd = rule_transition.first;
-					diff = cur_rule.GetFixed() - rule_rd;
-					// rule transition is not null and before rd
-					// rule transition will not be no way close enough to be within ulp margin of error
-					if (diff > 0.0 && rule_rd > closest_diff)
-					{
-						closest_diff = rule_rd;
-						prev_rule = &rule_arr_[rule_transition.second];
-						prev_rule_year = previous_year_;
-					}
-				}
 			}
 
-			return std::make_pair(prev_rule, prev_rule_year);
+			return closest_rule;
 		}
 
 		//==============================================
 		// Find the previous rule in effect if any
 		//===============================================
-		std::pair<const Rule* const, int> RuleGroup::FindPreviousRule(RD cur_rule)
+		std::pair<const Rule* const, int> RuleGroup::FindPreviousRule(RDTicks cur_rule)
 		{
 			const Rule* prev_rule = nullptr;
 			int prev_rule_year = 0;
-			RD closest_diff = 0.0;
-			RD diff = 0.0;
+			RDTicks closest_rule = 0;
 			// check the primary pool for an active rule 
 			for (const auto& rule_transition : primary_year_transitions_)
 			{
-				auto rule_rd = rule_transition.first;
-				diff = cur_rule - rule_rd;
-				// rule transition is not null and before rd
-				if (diff > 0.0 && rule_rd > closest_diff)
+				auto rule_ticks = rule_transition.first;
+				// rule transition is not null and before cur rule
+				if (rule_ticks < cur_rule && rule_ticks > closest_rule)
 				{
-					closest_diff = rule_rd;
+					closest_rule = rule_ticks;
 					prev_rule = &rule_arr_[rule_transition.second];
 					prev_rule_year = primary_year_;
 				}
@@ -300,17 +311,14 @@ namespace smalltime
 			// if a previous rule wasn't found check secondary pool
 			if (prev_rule == nullptr)
 			{
-				diff = 0.0;
-				closest_diff = 0.0;
+				closest_rule = 0;
 				for (const auto& rule_transition : prev_year_transitions_)
 				{
-					auto rule_rd = rule_transition.first;
-					diff = cur_rule - rule_rd;
-					// rule transition is not null and before rd
-					// rule transition will not be no way close enough to be within ulp margin of error
-					if (diff > 0.0 && rule_rd > closest_diff)
+					auto rule_ticks = rule_transition.first;
+					// rule transition is not null and before cur rule
+					if (rule_ticks < cur_rule && rule_ticks > closest_rule)
 					{
-						closest_diff = rule_rd;
+						closest_rule = rule_ticks;
 						prev_rule = &rule_arr_[rule_transition.second];
 						prev_rule_year = previous_year_;
 					}
@@ -323,67 +331,19 @@ namespace smalltime
 		//================================================
 		// Find the next rule in effect if any
 		//================================================
-		std::pair<const Rule* const, int> RuleGroup::FindNextRule(BasicDateTime<> cur_rule)
-		{
-			const Rule* next_rule = nullptr;
-			int next_rule_year = 0;
-			RD closest_diff = DMAX;
-			RD diff = 0.0;
-			// check the primary pool for an active rule 
-			for (const auto& rule_transition : primary_year_transitions_)
-			{
-				auto rule_rd = rule_transition.first;
-				diff = cur_rule.GetFixed() - rule_rd;
-				// rule transition is not null and after the cur rule
-				// rule transition will not be no way close enough to be within ulp margin of error
-				if (diff < 0.0 && rule_rd < closest_diff)
-				{
-					closest_diff = rule_rd;
-					next_rule = &rule_arr_[rule_transition.second];
-					next_rule_year = primary_year_;
-				}
-			}
-			// if a next rule wasn't found check secondary pool
-			if (next_rule == nullptr)
-			{
-				diff = 0.0;
-				closest_diff = 0.0;
-				for (const auto& rule_transition : next_year_transitions_)
-				{
-					auto rule_rd = rule_transition.first;
-					diff = cur_rule.GetFixed() - rule_rd;
-					// rule transition is not null and after cur rule
-					if (diff < 0.0 && rule_rd < closest_diff )
-					{
-						closest_diff = rule_rd;
-						next_rule = &rule_arr_[rule_transition.second];
-						next_rule_year = next_year_;
-					}
-				}
-			}
-
-			return std::make_pair(next_rule, next_rule_year);
-		}
-
-		//================================================
-		// Find the next rule in effect if any
-		//================================================
-		std::pair<const Rule* const, int> RuleGroup::FindNextRule(RD cur_rule)
+		std::pair<const Rule* const, int> RuleGroup::FindNextRule(RDTicks cur_rule)
 		{
 			const Rule* next_rule = nullptr;
 			int next_rule_year = 0;
-			RD closest_diff = DMAX;
-			RD diff = 0.0;
+			RDTicks closest_rule = DMAX_TICKS;
 			// check the primary pool for an active rule 
 			for (const auto& rule_transition : primary_year_transitions_)
 			{
-				auto rule_rd = rule_transition.first;
-				diff = cur_rule - rule_rd;
+				auto rule_ticks = rule_transition.first;
 				// rule transition is not null and after the cur rule
-				// rule transition will not be no way close enough to be within ulp margin of error
-				if (diff < 0.0 && rule_rd < closest_diff)
+				if (rule_ticks > cur_rule && rule_ticks < closest_rule)
 				{
-					closest_diff = rule_rd;
+					closest_rule = rule_ticks;
 					next_rule = &rule_arr_[rule_transition.second];
 					next_rule_year = primary_year_;
 				}
@@ -391,16 +351,14 @@ namespace smalltime
 			// if a next rule wasn't found check secondary pool
 			if (next_rule == nullptr)
 			{
-				diff = 0.0;
-				closest_diff = 0.0;
+				closest_rule = 0;
 				for (const auto& rule_transition : next_year_transitions_)
 				{
-					auto rule_rd = rule_transition.first;
-					diff = cur_rule - rule_rd;
+					auto rule_ticks = rule_transition.first;
 					// rule transition is not null and after cur rule
-					if (diff < 0.0 && rule_rd < closest_diff)
+					if (rule_ticks > cur_rule && rule_ticks < closest_rule)
 					{
-						closest_diff = rule_rd;
+						closest_rule = rule_ticks;
 						next_rule = &rule_arr_[rule_transition.second];
 						next_rule_year = next_year_;
 					}
@@ -413,43 +371,38 @@ namespace smalltime
 		//==========================================================================
 		// check if the cur date time is within an ambiguous range in wall time
 		//==========================================================================
-		const Rule* const RuleGroup::CorrectForAmbigAny(const BasicDateTime<>& cur_dt, RuleTransition cur_rule_transition, const Rule* const cur_rule, Choose choose)
+		const Rule* const RuleGroup::CorrectForAmbigAny(RDTicks cur_ticks, TimeType time_type, const RuleTransition& cur_rule_transition, const Rule* const cur_rule, Choose choose)
 		{
 			
 			// Zone and Rule transition are the same, zone will have already checked for ambig
 			// Return the current rule since were assuming its not ambiguous or the zone would have caught it
-			if (AlmostEqualUlps(prev_zone_transition_.trans_wall_, cur_rule_transition.trans_wall_, 11))
+			if (prev_zone_transition_.trans_wall_ == cur_rule_transition.trans_wall_)
 				return cur_rule;
 
 			auto prev_rule = FindPreviousRule(cur_rule_transition.trans_wall_);
 			if (prev_rule.first)
 			{
-				RD mb_any = 0.0;
-				RD fi_any = 0.0;
-				TimeType time_type = KTimeType_Wall;
+				RDTicks mb_any = 0;
+				RDTicks fi_any = 0;
 
-				switch (cur_dt.GetType())
+				switch (time_type)
 				{
 				case KTimeType_Wall:
 					mb_any = cur_rule_transition.mb_trans_wall_;
 					fi_any = cur_rule_transition.first_inst_wall_;
-					time_type = KTimeType_Wall;
 					break;
 				case KTimeType_Std:
 					mb_any = cur_rule_transition.mb_trans_std_;
 					fi_any = cur_rule_transition.first_inst_std_;
-					time_type = KTimeType_Std;
 					break;
 				case KTimeType_Utc:
 					mb_any = cur_rule_transition.mb_trans_utc_;
 					fi_any = cur_rule_transition.trans_utc_;
-					time_type = KTimeType_Utc;
 					break;
 				}
 
 				// check for ambig with previous rule and current rule
-				if ((mb_any < cur_dt.GetFixed() && !AlmostEqualRelative(mb_any, cur_dt.GetFixed()))&&
-					(cur_dt.GetFixed() < fi_any && !AlmostEqualRelative(cur_dt.GetFixed(), fi_any)))
+				if (mb_any < cur_ticks && cur_ticks < fi_any)
 				{
 					switch (choose)
 					{
@@ -459,7 +412,10 @@ namespace smalltime
 					case Choose::KLatest:
 						return cur_rule;
 					case Choose::KError:
-						throw TimeZoneAmbigNoneException(BasicDateTime<>(mb_any, time_type), BasicDateTime<>(fi_any, time_type));
+						if (!status_)
+							throw TimeZoneAmbigNoneException(BasicDateTime<>(math::FixedFromTicks(mb_any), time_type), BasicDateTime<>(math::FixedFromTicks(fi_any), time_type));
+						*status_ = Status::KAmbigNone;
+						return prev_rule.first;
 					}
 				}
 			}
@@ -468,38 +424,33 @@ namespace smalltime
 			auto next_rule = FindNextRule(cur_rule_transition.trans_wall_);
 			if (next_rule.first)
 			{
-				RD mb_any = 0.0;
-				RD fi_any = 0.0;
-				TimeType time_type = KTimeType_Wall;
+				RDTicks mb_any = 0;
+				RDTicks fi_any = 0;
 
 				RuleTransition next_rule_transition = CalcRuleData(next_rule.first, next_rule.second);
 				// Zone and Rule transition are the same, zone will have already checked for ambig
 				// Return the current rule since were assuming its not ambiguous or the zone would have caught it
-				if (AlmostEqualUlps(zone_transition_.trans_wall_, next_rule_transition.trans_wall_, 11))
+				if (zone_transition_.trans_wall_ == next_rule_transition.trans_wall_)
 					return cur_rule;
 
-				switch (cur_dt.GetType())
+				switch (time_type)
 				{
 				case KTimeType_Wall:
 					mb_any = next_rule_transition.mb_trans_wall_;
 					fi_any = next_rule_transition.first_inst_wall_;
-					time_type = KTimeType_Wall;
 					break;
 				case KTimeType_Std:
 					mb_any = next_rule_transition.mb_trans_std_;
 					fi_any = next_rule_transition.first_inst_std_;
-					time_type = KTimeType_Std;
 					break;
 				case KTimeType_Utc:
 					mb_any = next_rule_transition.mb_trans_utc_;
 					fi_any = next_rule_transition.trans_utc_;
-					time_type = KTimeType_Utc;
 					break;
 				}
 
 				// check for ambig with current and next rule
-				if ((fi_any <= cur_dt.GetFixed() || AlmostEqualRelative(fi_any, cur_dt.GetFixed())) &&
-					(cur_dt.GetFixed() <= mb_any || AlmostEqualRelative(mb_any, cur_dt.GetFixed())))
+				if (fi_any <= cur_ticks && cur_ticks <= mb_any)
 				{
 					// Ambigiuous local time gap
 					switch (choose)
@@ -509,7 +460,10 @@ namespace smalltime
 					case Choose::KLatest:
 						return next_rule.first;
 					case Choose::KError:
-						throw TimeZoneAmbigMultiException(BasicDateTime<>(fi_any, time_type), BasicDateTime<>(mb_any, time_type));
+						if (!status_)
+							throw TimeZoneAmbigMultiException(BasicDateTime<>(math::FixedFromTicks(fi_any), time_type), BasicDateTime<>(math::FixedFromTicks(mb_any), time_type));
+						*status_ = Status::KAmbigMulti;
+						return cur_rule;
 					}
 				}
 			}
@@ -522,6 +476,16 @@ namespace smalltime
 		//=============================================================
 		int RuleGroup::FindClosestActiveYear(int year)
 		{
+			if (year_range_arr_)
+			{
+				int range = FindYearRange(year);
+				if (range == -1)
+					return 0;
+
+				const auto& year_range = year_range_arr_[range];
+				return year > year_range.to_year ? year_range.to_year : year;
+			}
+
 			int closest_year = 0;
 			for (int i = rules_.first; i < rules_.first + rules_.size; ++i)
 			{
@@ -550,6 +514,16 @@ namespace smalltime
 		int RuleGroup::FindPreviousActiveYear(int year)
 		{
 			year -= 1;
+			if (year_range_arr_)
+			{
+				int range = FindYearRange(year);
+				if (range == -1)
+					return 0;
+
+				const auto& year_range = year_range_arr_[range];
+				return year > year_range.to_year ? year_range.to_year : year;
+			}
+
 			int closest_year = 0;
 			for (int i = rules_.first; i < rules_.first + rules_.size; ++i)
 			{
@@ -578,19 +552,27 @@ namespace smalltime
 		int RuleGroup::FindNextActiveYear(int year)
 		{
 			year += 1;
+			if (year_range_arr_)
+			{
+				int range = FindYearRange(year);
+				if (range != -1 && year <= year_range_arr_[range].to_year)
+					return year;
+
+				// the first range starting after year, if any
+				if (range + 1 < year_ranges_.size)
+					return year_range_arr_[range + 1].from_year;
+
+				return 0;
+			}
+
 			int closest_year = 0;
 			for (int i = rules_.first; i < rules_.first + rules_.size; ++i)
 			{
-				int rule_range = rule_arr_[i].to_year - rule_arr_[i].from_year;
-				int cur_range = year - rule_arr_[i].from_year;
-				int cur_year = 0;
+				// rules that ended before year have no next year
+				if (rule_arr_[i].to_year < year)
+					continue;
 
-				if (cur_range > rule_range)
-					cur_year = 0;
-				else if (cur_range < 0)
-					cur_year = rule_arr_[i].from_year;
-				else
-					cur_year = year;
+				int cur_year = rule_arr_[i].from_year > year ? rule_arr_[i].from_year : year;
 
 				// Set the closest year
 				if (closest_year == 0 || cur_year < closest_year)
@@ -601,17 +583,69 @@ namespace smalltime
 			return closest_year;
 		}
 
+		//===================================================================
+		// Count the rules in effect in the first year of every rule, the
+		// most rules of a set overlap in one of those years
+		//===================================================================
+		int RuleGroup::FindMaxYearRuleSize(const Rules* const rules_arr, int rules_size, const Rule* const rule_arr)
+		{
+			int max_year_rule_size = 0;
+			for (int r = 0; r < rules_size; ++r)
+			{
+				const int first = rules_arr[r].first;
+				const int last = first + rules_arr[r].size;
+
+				for (int i = first; i < last; ++i)
+				{
+					int year_rule_size = 0;
+					for (int j = first; j < last; ++j)
+					{
+						if (rule_arr[j].from_year <= rule_arr[i].from_year && rule_arr[i].from_year <= rule_arr[j].to_year)
+							++year_rule_size;
+					}
+
+					if (year_rule_size > max_year_rule_size)
+						max_year_rule_size = year_rule_size;
+				}
+			}
+
+			return max_year_rule_size;
+		}
+
+		//===================================================================
+		// Binary search for the last year range starting at or before
+		// year, returns its index in the rule set or -1
+		//===================================================================
+		int RuleGroup::FindYearRange(int year)
+		{
+			int left = 0;
+			int right = year_ranges_.size;
+
+			// first range starting after year
+			while (left < right)
+			{
+				int middle = (left + right) / 2;
+
+				if (year_range_arr_[middle].from_year <= year)
+					left = middle + 1;
+				else
+					right = middle;
+			}
+
+			return left - 1;
+		}
+
 		//================================================
 		// Fill buffer with rule transition data
 		//================================================
-		void RuleGroup::BuildTransitionData(std::vector<std::pair<RD, int> >& transition_vec, int year)
+		void RuleGroup::BuildTransitionData(TransitionBuffer& transition_vec, int year)
 		{
 			transition_vec.clear();
 
 			for (int i = rules_.first; i < rules_.first + rules_.size; ++i)
 			{
-				auto rule_transition = CalcTransitionFast(&rule_arr_[i], year).GetFixed();
-				if (rule_transition > 0.0)
+				auto rule_transition = math::TicksFromFixed(CalcTransitionFast(&rule_arr_[i], year).GetFixed());
+				if (rule_transition > 0)
 					transition_vec.emplace_back(std::make_pair(rule_transition, i));
 			}
 		}
@@ -622,29 +656,30 @@ namespace smalltime
 		RuleTransition RuleGroup::CalcRuleData(const Rule* const rule, int year)
 		{
 			auto rule_transition = CalcTransitionFast(rule, year);
-			if (rule_transition.GetFixed() == 0.0)
-				return RuleTransition(0.0, 0.0, 0.0, 0.0);
+			auto rule_ticks = math::TicksFromFixed(rule_transition.GetFixed());
+			if (rule_ticks == 0)
+				return RuleTransition(0, 0, 0, 0);
 
-			RD zone_offset = zone_->zone_offset;
-			RD cur_rule_offset = rule->offset;
-			RD prev_rule_offset = 0.0;
+			RDTicks zone_offset = zone_transition_.cur_zoffset_;
+			RDTicks cur_rule_offset = math::TicksFromFixed(rule->offset);
+			RDTicks prev_rule_offset = 0;
 
-			auto pr = FindPreviousRule(rule_transition);
+			auto pr = FindPreviousRule(rule_ticks);
 			if (pr.first)
-				prev_rule_offset = pr.first->offset;
+				prev_rule_offset = math::TicksFromFixed(pr.first->offset);
 
-			RD mb_trans_utc = 0.0;
+			RDTicks mb_trans_utc = 0;
 
 			switch (rule_transition.GetType())
 			{
 			case KTimeType_Wall:
-				mb_trans_utc = rule_transition.GetFixed() - prev_rule_offset - zone_offset - math::MSEC();
+				mb_trans_utc = rule_ticks - prev_rule_offset - zone_offset - 1;
 				break;
 			case KTimeType_Std:
-				mb_trans_utc = rule_transition.GetFixed() - zone_offset - math::MSEC();
+				mb_trans_utc = rule_ticks - zone_offset - 1;
 				break;
 			case KTimeType_Utc:
-				mb_trans_utc =  math::MSEC();
+				mb_trans_utc = 1;
 				break;
 			}
 
@@ -32,5 +32,20 @@ namespace smalltime
 			return{ ihours, imins, isecs, imillis };
 
 		}
+
+		//=====================================================
+		// convert ticks to time fields
+		//======================================================
+		std::array<int, 4> HmsFromTicks(RDTicks ticks)
+		{
+			RDTicks time_of_day = ticks - DayFromTicks(ticks) * KTICKS_IN_DAY;
+
+			int hours = static_cast<int>(time_of_day / KTICKS_IN_HOUR);
+			int mins = static_cast<int>(time_of_day % KTICKS_IN_HOUR / KTICKS_IN_MINUTE);
+			int secs = static_cast<int>(time_of_day % KTICKS_IN_MINUTE / KTICKS_IN_SECOND);
+			int millis = static_cast<int>(time_of_day % KTICKS_IN_SECOND);
+
+			return{ hours, mins, secs, millis };
+		}
 	}
-}
\ No newline at end of file
+}
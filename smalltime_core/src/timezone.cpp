@@ -4,83 +4,333 @@
 #include "../include/zone_group.h"
 #include "../include/rule_group.h"
 #include "../include/smalltime_exceptions.h"
+#include "../include/core_math.h"
+#include "../include/time_math.h"
+
+#include <algorithm>
+#include <cstdint>
 
 
 namespace smalltime
 {
 	namespace tz
 	{
-		//==================================
-		// Init static member
-		//==================================
-		TimeZoneDB TimeZone::timezone_db_;
-
 		//=======================================================
 		// Produce UTC offset from a local datetime
 		//=======================================================
 		RD TimeZone::FixedOffsetFromLocal(RD rd, std::string time_zone_name, Choose choose)
 		{
-			auto zone_handle = timezone_db_.GetZoneHandle();
-			auto zones = timezone_db_.FindZones(time_zone_name);
+			const auto& snapshot = TimeZoneDB::GetThreadSnapshot();
+			auto zones = snapshot.FindZones(time_zone_name);
 
-			if (zones.size < 1)
+			if (zones.first == -1)
 				throw InvalidTimeZoneException(time_zone_name);
 
 			// Convert datetime to iso to check with time zones
 			BasicDateTime<> iso_dt(rd, KTimeType_Wall);
 
-			ZoneGroup zg(zones, zone_handle);
+			return FixedOffsetFromZones(iso_dt, zones, snapshot, nullptr, choose);
+		}
 
-			const Zone*  prev_zone = nullptr;
-			const Zone*  cur_zone = nullptr;
-			std::tie(prev_zone, cur_zone) = zg.FindActiveAndPreviousZone(iso_dt, choose);
+		//=======================================================
+		// Produce UTC offset from a utc datetime
+		//=======================================================
+		RD TimeZone::FixedOffsetFromUtc(RD rd, std::string time_zone_name)
+		{
+			const auto& snapshot = TimeZoneDB::GetThreadSnapshot();
+			auto zones = snapshot.FindZones(time_zone_name);
 
-			// If iso_dt past DMAX then nullptr is returned and no offset is applied
-			// This would be past the year 10,000 so timezones wouldn't be of much use
-			RD total_offset = 0.0;
-			if (cur_zone)
-				total_offset = cur_zone->zone_offset;
-			else
-				return 0.0;
+			if (zones.first == -1)
+				throw InvalidTimeZoneException(time_zone_name);
 
-			if (cur_zone->rule_id <= 0)
-				return total_offset;
+			// precompiled transitions, past the tail fall back to the zone rules
+			auto utc_transitions = snapshot.FindUtcTransitions(zones.zone_id);
+			if (utc_transitions.first != -1 && rd < utc_transitions.tail_utc)
+				return FindUtcTransition(rd, utc_transitions, snapshot)->offset;
 
-			// get rule data
-			auto rule_arr_ = timezone_db_.GetRuleHandle();
-			auto rules = timezone_db_.FindRules(cur_zone->rule_id);
-			RuleGroup rg(rules, rule_arr_, cur_zone, prev_zone);
+			// Convert datetime to iso to check with time zones
+			BasicDateTime<> iso_dt(rd, KTimeType_Utc);
 
-			auto active_rule = rg.FindActiveRule(iso_dt, choose);
+			// converting from utc should not produce an ambig error
+			return FixedOffsetFromZones(iso_dt, zones, snapshot, nullptr, Choose::KError);
+		}
 
-			// No active rule found
-			if (!active_rule)
-				return total_offset;
+		//=======================================================
+		// Produce time zone abbreviation from a utc datetime
+		//=======================================================
+		std::string TimeZone::AbbrevFromUtc(RD rd, std::string time_zone_name)
+		{
+			const auto& snapshot = TimeZoneDB::GetThreadSnapshot();
+			auto zones = snapshot.FindZones(time_zone_name);
 
-			total_offset += active_rule->offset;
-			return total_offset;
+			if (zones.first == -1)
+				throw InvalidTimeZoneException(time_zone_name);
+
+			auto utc_transitions = snapshot.FindUtcTransitions(zones.zone_id);
+			if (utc_transitions.first == -1 || rd >= utc_transitions.tail_utc)
+				return std::string();
+
+			auto utc_transition = FindUtcTransition(rd, utc_transitions, snapshot);
+			return snapshot.GetAbbrev(utc_transition->abbrev_index);
 		}
 
 		//=======================================================
 		// Produce UTC offset from a local datetime
 		//=======================================================
-		RD TimeZone::FixedOffsetFromUtc(RD rd, std::string time_zone_name)
+		RD TimeZone::FixedOffsetFromLocal(RD rd, const ZoneHandle& zone_handle, Choose choose)
+		{
+			BasicDateTime<> iso_dt(rd, KTimeType_Wall);
+
+			return FixedOffsetFromZones(iso_dt, zone_handle.GetZones(), zone_handle.GetSnapshot(), &zone_handle, choose);
+		}
+
+		//=======================================================
+		// Produce UTC offset from a utc datetime
+		//=======================================================
+		RD TimeZone::FixedOffsetFromUtc(RD rd, const ZoneHandle& zone_handle)
+		{
+			const auto& utc_transitions = zone_handle.GetUtcTransitions();
+			if (utc_transitions.first != -1 && rd < utc_transitions.tail_utc)
+				return FindUtcTransition(rd, zone_handle)->offset;
+
+			BasicDateTime<> iso_dt(rd, KTimeType_Utc);
+
+			return FixedOffsetFromZones(iso_dt, zone_handle.GetZones(), zone_handle.GetSnapshot(), &zone_handle, Choose::KError);
+		}
+
+		//=======================================================
+		// Produce time zone abbreviation from a utc datetime
+		//=======================================================
+		std::string TimeZone::AbbrevFromUtc(RD rd, const ZoneHandle& zone_handle)
+		{
+			const auto& utc_transitions = zone_handle.GetUtcTransitions();
+			if (utc_transitions.first == -1 || rd >= utc_transitions.tail_utc)
+				return std::string();
+
+			auto utc_transition = FindUtcTransition(rd, zone_handle);
+			return zone_handle.GetSnapshot().GetAbbrev(utc_transition->abbrev_index);
+		}
+
+		//=============================================================
+		// Produce UTC offsets for a span of utc datetimes
+		//=============================================================
+		void TimeZone::OffsetsFromUtc(const RD* in, RD* out, std::size_t n, const ZoneHandle& zone_handle)
+		{
+			const auto& utc_transitions = zone_handle.GetUtcTransitions();
+			auto utc_transition_ticks = zone_handle.GetUtcTransitionTicks();
+			auto utc_transition_size = static_cast<std::size_t>(utc_transitions.size);
+			auto utc_transition_handle = zone_handle.GetUtcTransitionHandle();
+
+			RuleGroupCache rule_group_cache = { nullptr, nullptr, nullptr };
+			std::size_t cur_index = 0;
+			// Bounds of the period at cur_index, empty until the first lookup
+			RDTicks period_start = 0;
+			RDTicks period_end = 0;
+
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				RD rd = in[i];
+
+				if (utc_transitions.first == -1 || rd >= utc_transitions.tail_utc)
+				{
+					BasicDateTime<> iso_dt(rd, KTimeType_Utc);
+					out[i] = FixedOffsetFromZones(iso_dt, zone_handle.GetZones(), zone_handle.GetSnapshot(), &zone_handle, Choose::KError, &rule_group_cache);
+					continue;
+				}
+
+				RDTicks ticks = math::TicksFromFixed(rd);
+				if (ticks < period_start || ticks >= period_end)
+				{
+					// sorted input usually just steps into the following period
+					if (period_start != period_end && ticks >= period_end &&
+						(cur_index + 2 == utc_transition_size || ticks < utc_transition_ticks[cur_index + 2]))
+						++cur_index;
+					else
+						cur_index = FindUtcTransitionTicks(ticks, utc_transition_ticks, utc_transition_size);
+
+					period_start = cur_index == 0 ? INT64_MIN : utc_transition_ticks[cur_index];
+					period_end = cur_index + 1 == utc_transition_size ? INT64_MAX : utc_transition_ticks[cur_index + 1];
+				}
+
+				out[i] = utc_transition_handle[utc_transitions.first + cur_index].offset;
+			}
+		}
+
+		//=============================================================
+		// Produce UTC offsets for a span of local datetimes
+		//=============================================================
+		void TimeZone::OffsetsFromLocal(const RD* in, RD* out, std::size_t n, const ZoneHandle& zone_handle, Choose choose)
+		{
+			RuleGroupCache rule_group_cache = { nullptr, nullptr, nullptr };
+
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				BasicDateTime<> iso_dt(in[i], KTimeType_Wall);
+				out[i] = FixedOffsetFromZones(iso_dt, zone_handle.GetZones(), zone_handle.GetSnapshot(), &zone_handle, choose, &rule_group_cache);
+			}
+		}
+
+		//=======================================================
+		// Produce UTC offset in ticks from utc ticks
+		//=======================================================
+		RDTicks TimeZone::TicksOffsetFromUtc(RDTicks ticks, const ZoneHandle& zone_handle)
 		{
-			auto zone_handle = timezone_db_.GetZoneHandle();
-			auto zones = timezone_db_.FindZones(time_zone_name);
+			auto utc_transition_ticks = zone_handle.GetUtcTransitionTicks();
+			if (utc_transition_ticks != nullptr && ticks < zone_handle.GetTailTicks())
+				return zone_handle.GetOffsetTicks()[FindUtcTransitionTicks(ticks, utc_transition_ticks, zone_handle.GetUtcTransitions().size)];
+
+			return math::TicksFromFixed(FixedOffsetFromUtc(math::FixedFromTicks(ticks), zone_handle));
+		}
+
+		//=======================================================
+		// Produce UTC offset in ticks from local ticks
+		//=======================================================
+		RDTicks TimeZone::TicksOffsetFromLocal(RDTicks ticks, const ZoneHandle& zone_handle, Choose choose)
+		{
+			return math::TicksFromFixed(FixedOffsetFromLocal(math::FixedFromTicks(ticks), zone_handle, choose));
+		}
+
+		//=============================================================
+		// Produce UTC offsets in ticks for a span of utc ticks
+		//=============================================================
+		void TimeZone::TicksOffsetsFromUtc(const RDTicks* in, RDTicks* out, std::size_t n, const ZoneHandle& zone_handle)
+		{
+			auto utc_transition_ticks = zone_handle.GetUtcTransitionTicks();
+			auto utc_transition_size = static_cast<std::size_t>(zone_handle.GetUtcTransitions().size);
+			auto offset_ticks = zone_handle.GetOffsetTicks();
+			auto tail_ticks = zone_handle.GetTailTicks();
+
+			RuleGroupCache rule_group_cache = { nullptr, nullptr, nullptr };
+			std::size_t cur_index = 0;
+			// Bounds of the period at cur_index, empty until the first lookup
+			RDTicks period_start = 0;
+			RDTicks period_end = 0;
+
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				RDTicks ticks = in[i];
+
+				if (utc_transition_ticks == nullptr || ticks >= tail_ticks)
+				{
+					BasicDateTime<> iso_dt(math::FixedFromTicks(ticks), KTimeType_Utc);
+					out[i] = math::TicksFromFixed(FixedOffsetFromZones(iso_dt, zone_handle.GetZones(), zone_handle.GetSnapshot(), &zone_handle, Choose::KError, &rule_group_cache));
+					continue;
+				}
+
+				if (ticks < period_start || ticks >= period_end)
+				{
+					// sorted input usually just steps into the following period
+					if (period_start != period_end && ticks >= period_end &&
+						(cur_index + 2 == utc_transition_size || ticks < utc_transition_ticks[cur_index + 2]))
+						++cur_index;
+					else
+						cur_index = FindUtcTransitionTicks(ticks, utc_transition_ticks, utc_transition_size);
+
+					period_start = cur_index == 0 ? INT64_MIN : utc_transition_ticks[cur_index];
+					period_end = cur_index + 1 == utc_transition_size ? INT64_MAX : utc_transition_ticks[cur_index + 1];
+				}
+
+				out[i] = offset_ticks[cur_index];
+			}
+		}
+
+		//=======================================================
+		// Produce UTC offset from a local datetime, no throw
+		//=======================================================
+		Result<RD> TimeZone::TryFixedOffsetFromLocal(RD rd, const std::string& time_zone_name, Choose choose)
+		{
+			const auto& snapshot = TimeZoneDB::GetThreadSnapshot();
+			auto zones = snapshot.FindZones(time_zone_name);
 
 			if (zones.first == -1)
-				throw InvalidTimeZoneException(time_zone_name);
+				return Status::KInvalidTimeZone;
+
+			BasicDateTime<> iso_dt(rd, KTimeType_Wall);
+
+			Status status = Status::KOk;
+			RD offset = FixedOffsetFromZones(iso_dt, zones, snapshot, nullptr, choose, nullptr, &status);
+			if (status != Status::KOk)
+				return status;
+
+			return offset;
+		}
+
+		//=======================================================
+		// Produce UTC offset from a utc datetime, no throw
+		//=======================================================
+		Result<RD> TimeZone::TryFixedOffsetFromUtc(RD rd, const std::string& time_zone_name)
+		{
+			const auto& snapshot = TimeZoneDB::GetThreadSnapshot();
+			auto zones = snapshot.FindZones(time_zone_name);
+
+			if (zones.first == -1)
+				return Status::KInvalidTimeZone;
+
+			auto utc_transitions = snapshot.FindUtcTransitions(zones.zone_id);
+			if (utc_transitions.first != -1 && rd < utc_transitions.tail_utc)
+				return FindUtcTransition(rd, utc_transitions, snapshot)->offset;
 
-			// Convert datetime to iso to check with time zones
 			BasicDateTime<> iso_dt(rd, KTimeType_Utc);
 
-			// converting from utc should not produce an ambig error
-			ZoneGroup zg(zones, zone_handle);
-			
+			Status status = Status::KOk;
+			RD offset = FixedOffsetFromZones(iso_dt, zones, snapshot, nullptr, Choose::KError, nullptr, &status);
+			if (status != Status::KOk)
+				return status;
+
+			return offset;
+		}
+
+		//=======================================================
+		// Produce UTC offset from a local datetime, no throw
+		//=======================================================
+		Result<RD> TimeZone::TryFixedOffsetFromLocal(RD rd, const ZoneHandle& zone_handle, Choose choose)
+		{
+			BasicDateTime<> iso_dt(rd, KTimeType_Wall);
+
+			Status status = Status::KOk;
+			RD offset = FixedOffsetFromZones(iso_dt, zone_handle.GetZones(), zone_handle.GetSnapshot(), &zone_handle, choose, nullptr, &status);
+			if (status != Status::KOk)
+				return status;
+
+			return offset;
+		}
+
+		//=======================================================
+		// Produce UTC offset from a utc datetime, no throw
+		//=======================================================
+		Result<RD> TimeZone::TryFixedOffsetFromUtc(RD rd, const ZoneHandle& zone_handle)
+		{
+			const auto& utc_transitions = zone_handle.GetUtcTransitions();
+			if (utc_transitions.first != -1 && rd < utc_transitions.tail_utc)
+				return FindUtcTransition(rd, zone_handle)->offset;
+
+			BasicDateTime<> iso_dt(rd, KTimeType_Utc);
+
+			Status status = Status::KOk;
+			RD offset = FixedOffsetFromZones(iso_dt, zone_handle.GetZones(), zone_handle.GetSnapshot(), &zone_handle, Choose::KError, nullptr, &status);
+			if (status != Status::KOk)
+				return status;
+
+			return offset;
+		}
+
+		//==================================================================
+		// Evaluate zone lines and rules, rules come from the handle
+		// when there is one and from the tzdb otherwise, the rule
+		// group is reused when a cache is given. Ambiguities set status
+		// instead of throwing when one is given
+		//==================================================================
+		RD TimeZone::FixedOffsetFromZones(const BasicDateTime<>& iso_dt, Zones zones, const TzdbSnapshot& snapshot, const ZoneHandle* const zone_handle, Choose choose, RuleGroupCache* const rule_group_cache, Status* const status)
+		{
+			auto zone_arr = snapshot.GetZoneHandle();
+			ZoneGroup zg(zones, zone_arr, status);
+
 			const Zone*  prev_zone = nullptr;
 			const Zone*  cur_zone = nullptr;
-			std::tie(prev_zone, cur_zone) = zg.FindActiveAndPreviousZone(iso_dt, Choose::KError);
+			std::tie(prev_zone, cur_zone) = zg.FindActiveAndPreviousZone(iso_dt, choose);
+
+			if (status && *status != Status::KOk)
+				return 0.0;
 
 			// If iso_dt past DMAX then nullptr is returned and no offset is applied
 			// This would be past the year 10,000 so timezones wouldn't be of much use
@@ -94,11 +344,36 @@ namespace smalltime
 				return total_offset;
 
 			// get rule data
-			auto rule_arr_ = timezone_db_.GetRuleHandle();
-			auto rules = timezone_db_.FindRules(cur_zone->rule_id);
-			RuleGroup rg(rules, rule_arr_, cur_zone, prev_zone);
+			auto rule_arr = snapshot.GetRuleHandle();
+			auto year_range_arr = snapshot.GetRuleYearRangeHandle();
+			const Rule* active_rule = nullptr;
+
+			if (rule_group_cache)
+			{
+				// the rule group keeps the transitions of the last year it looked at
+				if (!rule_group_cache->rule_group || rule_group_cache->zone != cur_zone || rule_group_cache->prev_zone != prev_zone)
+				{
+					auto rules = zone_handle ? zone_handle->FindRules(cur_zone) : snapshot.FindRules(cur_zone->rule_id);
+					auto year_ranges = zone_handle ? zone_handle->FindRuleYearRanges(cur_zone) : snapshot.FindRuleYearRanges(cur_zone->rule_id);
+					rule_group_cache->rule_group = std::make_unique<RuleGroup>(rules, rule_arr, cur_zone, prev_zone, snapshot.GetTransitionCache(), status,
+						year_range_arr, year_ranges);
+					rule_group_cache->zone = cur_zone;
+					rule_group_cache->prev_zone = prev_zone;
+				}
 
-			auto active_rule = rg.FindActiveRule(iso_dt, Choose::KError);
+				active_rule = rule_group_cache->rule_group->FindActiveRule(iso_dt, choose);
+			}
+			else
+			{
+				auto rules = zone_handle ? zone_handle->FindRules(cur_zone) : snapshot.FindRules(cur_zone->rule_id);
+				auto year_ranges = zone_handle ? zone_handle->FindRuleYearRanges(cur_zone) : snapshot.FindRuleYearRanges(cur_zone->rule_id);
+				RuleGroup rg(rules, rule_arr, cur_zone, prev_zone, snapshot.GetTransitionCache(), status, year_range_arr, year_ranges);
+
+				active_rule = rg.FindActiveRule(iso_dt, choose);
+			}
+
+			if (status && *status != Status::KOk)
+				return 0.0;
 
 			// No active rule found
 			if (!active_rule)
@@ -108,6 +383,38 @@ namespace smalltime
 			return total_offset;
 		}
 
+		//=============================================================
+		// Last transition at or before rd, searched in the tick
+		// table of the snapshot like the rule transitions
+		//=============================================================
+		const UtcTransition* const TimeZone::FindUtcTransition(RD rd, const UtcTransitions& utc_transitions, const TzdbSnapshot& snapshot)
+		{
+			auto index = FindUtcTransitionTicks(math::TicksFromFixed(rd), snapshot.GetUtcTransitionTickHandle() + utc_transitions.first, utc_transitions.size);
+			return &snapshot.GetUtcTransitionHandle()[utc_transitions.first + index];
+		}
+
+		//=============================================================
+		// Last transition of the handle zone at or before rd, searched
+		// in the tick table of the handle
+		//=============================================================
+		const UtcTransition* const TimeZone::FindUtcTransition(RD rd, const ZoneHandle& zone_handle)
+		{
+			auto index = FindUtcTransitionTicks(math::TicksFromFixed(rd), zone_handle.GetUtcTransitionTicks(), zone_handle.GetUtcTransitions().size);
+			return &zone_handle.GetUtcTransitionHandle()[zone_handle.GetUtcTransitions().first + index];
+		}
+
+		//=============================================================
+		// Index of the last of size transitions at or before ticks,
+		// the first transition covers everything before it
+		//=============================================================
+		std::size_t TimeZone::FindUtcTransitionTicks(RDTicks ticks, const RDTicks* const utc_transition_ticks, std::size_t size)
+		{
+			auto it = std::upper_bound(utc_transition_ticks, utc_transition_ticks + size, ticks);
+			if (it == utc_transition_ticks)
+				return 0;
+
+			return static_cast<std::size_t>(it - utc_transition_ticks) - 1;
+		}
 
 	}
-}
\ No newline at end of file
+}
@@ -1,8 +1,11 @@
 #include "../include/timezone_db.h"
-#include "../include/core_math.h"
-#include "../include/file_util.h"
 
-#include <fstream>
+#if defined(SMALLTIME_EMBEDDED_TZDB)
+#include "../include/tzdb_embedded.h"
+#endif
+
+#include <stdexcept>
+#include <utility>
 
 namespace smalltime
 {
@@ -12,91 +15,25 @@ namespace smalltime
 		//==================================
 		// Init static member
 		//==================================
-		std::unique_ptr<Zone[]> TimeZoneDB::zone_arr_(nullptr);
-		std::unique_ptr<Rule[]> TimeZoneDB::rule_arr_(nullptr);
-		std::unique_ptr<Zones[]> TimeZoneDB::zone_lookup_arr_(nullptr);
-		std::unique_ptr<Rules[]> TimeZoneDB::rule_lookup_arr_(nullptr);
-	
+		std::shared_ptr<const TzdbSnapshot> TimeZoneDB::snapshot_(nullptr);
+		std::atomic<uint64_t> TimeZoneDB::version_(0);
+		uint64_t TimeZoneDB::next_version_ = 1;
+		std::mutex TimeZoneDB::mutex_;
+#if defined(SMALLTIME_EMBEDDED_TZDB)
+		// built with the tzdb compiled in, it is used till another mode is set
+		LoadMode TimeZoneDB::load_mode_ = LoadMode::KEmbedded;
+#else
+		LoadMode TimeZoneDB::load_mode_ = LoadMode::KStream;
+#endif
 		std::string TimeZoneDB::path_ = "tzdb.bin";
-		int TimeZoneDB::zone_size_ = 0;
-		int TimeZoneDB::rule_size_ = 0;
-		int TimeZoneDB::zone_lookup_size_ = 0;
-		int TimeZoneDB::rule_lookup_size_ = 0;
-		bool TimeZoneDB::initialized_ = false;
-
-		static constexpr tz::Zone KZONE;
-		static constexpr int KZONE_SIZE = sizeof(KZONE.abbrev) + sizeof(KZONE.mb_rule_offset) + sizeof(KZONE.mb_until_utc) + sizeof(KZONE.next_zone_offset) +
-			sizeof(KZONE.rule_id) + sizeof(KZONE.trans_rule_offset) + sizeof(KZONE.until_type) + sizeof(KZONE.zone_id) + sizeof(KZONE.zone_offset);
-
-		static constexpr tz::Rule KRULE;
-		static constexpr int KRULE_SIZE = sizeof(KRULE.at_time) + sizeof(KRULE.at_type) + sizeof(KRULE.day) + sizeof(KRULE.day_type) +
-			sizeof(KRULE.from_year) + sizeof(KRULE.letter) + sizeof(KRULE.month) + sizeof(KRULE.offset) + sizeof(KRULE.rule_id) + sizeof(KRULE.to_year);
-
-		static constexpr tz::Zones KZONES;
-		static constexpr int KZONES_SIZE = sizeof(KZONES.first) + sizeof(KZONES.size) + sizeof(KZONES.zone_id);
-
-
-		static constexpr tz::Zones KRULES;
-		static constexpr int KRULES_SIZE = sizeof(KRULES.first) + sizeof(KRULES.size) + sizeof(KRULES.zone_id);
-
-		
-		//===============================================
-		// Binary search function for zones
-		//===============================================
-		Zones TimeZoneDB::BinarySearchZones(uint32_t zone_id, int size)
-		{
-			int left = 0;
-			int right = size - 1;
-
-			while (left <= right)
-			{
-				int middle = (left + right) / 2;
-				const auto& mid_zones = zone_lookup_arr_[middle];
-
-				if (mid_zones.zone_id == zone_id)
-					return mid_zones;
-				else if (zone_id > mid_zones.zone_id)
-					left = middle + 1;
-				else
-					right = middle - 1;
-			}
-
-			return{ zone_id, -1, -1 };
-		}
-
-		//===============================================
-		// Binary search function for zones
-		//===============================================
-		Rules TimeZoneDB::BinarySearchRules(uint32_t rule_id, int size)
-		{
-			int left = 0;
-			int right = size - 1;
-
-			while (left <= right)
-			{
-				int middle = (left + right) / 2;
-				const auto& mid_zones = rule_lookup_arr_[middle];
-
-				if (mid_zones.rule_id == rule_id)
-					return mid_zones;
-				else if (rule_id > mid_zones.rule_id)
-					left = middle + 1;
-				else
-					right = middle - 1;
-			}
-
-			return{ rule_id, -1, -1 };
-		}
+		const EmbeddedTzdb* TimeZoneDB::embedded_ = nullptr;
 
 		//===============================================
 		// Get pointer to first element of tzdb array
 		//================================================
 		const Rule* const TimeZoneDB::GetRuleHandle()
 		{
-			if (!initialized_)
-				Init();
-
-			return rule_arr_.get();
+			return GetThreadSnapshot().GetRuleHandle();
 		}
 
 		//===============================================
@@ -104,10 +41,7 @@ namespace smalltime
 		//================================================
 		const Zone* const TimeZoneDB::GetZoneHandle()
 		{
-			if (!initialized_)
-				Init();
-
-			return zone_arr_.get();
+			return GetThreadSnapshot().GetZoneHandle();
 		}
 		
 		//================================================
@@ -115,11 +49,7 @@ namespace smalltime
 		//================================================
 		Rules TimeZoneDB::FindRules(const std::string& name)
 		{
-			if (!initialized_)
-				Init();
-
-			auto rule_id = math::GetUniqueID(name);
-			return BinarySearchRules(rule_id, rule_lookup_size_);
+			return GetThreadSnapshot().FindRules(name);
 		}
 
 		//================================================
@@ -127,10 +57,7 @@ namespace smalltime
 		//================================================
 		Rules TimeZoneDB::FindRules(uint32_t rule_id)
 		{
-			if (!initialized_)
-				Init();
-
-			return BinarySearchRules(rule_id, rule_lookup_size_);
+			return GetThreadSnapshot().FindRules(rule_id);
 		}
 
 		//================================================
@@ -138,11 +65,7 @@ namespace smalltime
 		//================================================
 		Zones TimeZoneDB::FindZones(const std::string& name)
 		{
-			if (!initialized_)
-				Init();
-
-			auto zone_id = math::GetUniqueID(name);
-			return BinarySearchZones(zone_id, zone_lookup_size_);
+			return GetThreadSnapshot().FindZones(name);
 		}
 
 		//================================================
@@ -150,109 +73,157 @@ namespace smalltime
 		//================================================
 		Zones TimeZoneDB::FindZones(uint32_t zone_id)
 		{
-			if (!initialized_)
-				Init();
+			return GetThreadSnapshot().FindZones(zone_id);
+		}
+
+		//===============================================
+		// Get pointer to first precompiled transition
+		//================================================
+		const UtcTransition* const TimeZoneDB::GetUtcTransitionHandle()
+		{
+			return GetThreadSnapshot().GetUtcTransitionHandle();
+		}
+
+		//================================================
+		// Find precompiled transitions of zone if any
+		//================================================
+		UtcTransitions TimeZoneDB::FindUtcTransitions(uint32_t zone_id)
+		{
+			return GetThreadSnapshot().FindUtcTransitions(zone_id);
+		}
+
+		//================================================
+		// Get abbreviation of a transition
+		//================================================
+		std::string TimeZoneDB::GetAbbrev(uint32_t abbrev_index)
+		{
+			return GetThreadSnapshot().GetAbbrev(abbrev_index);
+		}
 
-			return BinarySearchZones(zone_id, zone_lookup_size_);
+		//===============================================
+		// Get the transition cache of the loaded tzdb
+		//===============================================
+		TransitionCache* const TimeZoneDB::GetTransitionCache()
+		{
+			return GetThreadSnapshot().GetTransitionCache();
 		}
 
 		//=============================================
-		// Init tzdb from binary file
+		// Load the tzdb if nothing is published yet
 		//=============================================
 		void TimeZoneDB::Init()
 		{
-			if (initialized_)
-				return;
-
-			std::ifstream in_file (path_.c_str(), std::ios::in | std::ios::binary);
-			auto tzdb_id = math::GetUniqueID("TZDB_FILE");
+			std::lock_guard<std::mutex> lock(mutex_);
 
-			// check if file length is correct
-			in_file.seekg(0, in_file.end);
-			int file_size = in_file.tellg();
-			in_file.seekg(0, in_file.beg);
+			if (version_.load(std::memory_order_relaxed) != 0)
+				return;
 
-			uint32_t in_tzdb_id = 0;
-			in_file.read(reinterpret_cast<char*>(&in_tzdb_id), sizeof(in_tzdb_id));
+			snapshot_ = Load(path_, load_mode_, embedded_, next_version_++);
+			version_.store(snapshot_->GetVersion(), std::memory_order_release);
+		}
 
-			// check if file id is correct
-			if (tzdb_id != in_tzdb_id)
-				throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+		//==================================================================
+		// Load a new snapshot outside the lock and publish it
+		//==================================================================
+		uint64_t TimeZoneDB::Reload()
+		{
+			std::string path;
+			LoadMode load_mode;
+			const EmbeddedTzdb* embedded;
+			uint64_t version;
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				path = path_;
+				load_mode = load_mode_;
+				embedded = embedded_;
+				version = next_version_++;
+			}
 
-			int in_file_size = 0;
-			in_file.read(reinterpret_cast<char*>(&in_file_size), sizeof(in_file_size));
+			auto snapshot = Load(std::move(path), load_mode, embedded, version);
+			Publish(snapshot);
 
-			if (in_file_size != file_size)
-				throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+			return snapshot->GetVersion();
+		}
 
-			zone_size_ = 0;
-			in_file.read(reinterpret_cast<char*>(&zone_size_), sizeof(zone_size_));
-			zone_size_ /= KZONE_SIZE;
+		//==================================================================
+		// Load a snapshot from the file or the embedded tables
+		//==================================================================
+		std::shared_ptr<const TzdbSnapshot> TimeZoneDB::Load(std::string path, LoadMode load_mode, const EmbeddedTzdb* embedded, uint64_t version)
+		{
+			if (load_mode != LoadMode::KEmbedded)
+				return TzdbSnapshot::Load(std::move(path), load_mode, version);
 
-			// init and populate zone array
-			zone_arr_ = std::unique_ptr<Zone[]>{ new Zone[zone_size_] };
-			for (int i = 0; i < zone_size_; ++i)
+			if (embedded == nullptr)
 			{
-				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].zone_id), sizeof(zone_arr_[i].zone_id));
-				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].rule_id), sizeof(zone_arr_[i].rule_id));
-				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].mb_until_utc), sizeof(zone_arr_[i].mb_until_utc));
-				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].until_type), sizeof(zone_arr_[i].until_type));
-				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].zone_offset), sizeof(zone_arr_[i].zone_offset));
-				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].next_zone_offset), sizeof(zone_arr_[i].next_zone_offset));
-				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].mb_rule_offset), sizeof(zone_arr_[i].mb_rule_offset));
-				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].trans_rule_offset), sizeof(zone_arr_[i].trans_rule_offset));
-				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].abbrev), sizeof(zone_arr_[i].abbrev));
+#if defined(SMALLTIME_EMBEDDED_TZDB)
+				embedded = &GetEmbeddedTzdb();
+#else
+				throw std::runtime_error("No embedded tzdb, build with SMALLTIME_EMBEDDED_TZDB");
+#endif
 			}
 
-			int rule_size_ = 0;
-			in_file.read(reinterpret_cast<char*>(&rule_size_), sizeof(rule_size_));
-			rule_size_ /= KRULE_SIZE;
+			return TzdbSnapshot::Load(*embedded, version);
+		}
 
-			// init and populate rule array
-			rule_arr_ = std::unique_ptr<Rule[]>{ new Rule[rule_size_] };
-			for (int i = 0; i < rule_size_; ++i)
-			{
-				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].rule_id), sizeof(rule_arr_[i].rule_id));
-				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].from_year), sizeof(rule_arr_[i].from_year));
-				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].to_year), sizeof(rule_arr_[i].to_year));
-				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].month), sizeof(rule_arr_[i].month));
-				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].day), sizeof(rule_arr_[i].day));
-				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].day_type), sizeof(rule_arr_[i].day_type));
-				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].at_time), sizeof(rule_arr_[i].at_time));
-				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].at_type), sizeof(rule_arr_[i].at_type));
-				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].offset), sizeof(rule_arr_[i].offset));
-				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].letter), sizeof(rule_arr_[i].letter));
+		//==================================================================
+		// Replace the published snapshot, an older load finishing after a
+		// newer one is dropped
+		//==================================================================
+		void TimeZoneDB::Publish(std::shared_ptr<const TzdbSnapshot> snapshot)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
 
-			}
+			if (snapshot_ && snapshot_->GetVersion() > snapshot->GetVersion())
+				return;
 
-			zone_lookup_size_ = 0;
-			in_file.read(reinterpret_cast<char*>(&zone_lookup_size_), sizeof(zone_lookup_size_));
-			zone_lookup_size_ /= KZONES_SIZE;
+			snapshot_ = std::move(snapshot);
+			version_.store(snapshot_->GetVersion(), std::memory_order_release);
+		}
 
-			// init and populate zone lookup array
-			zone_lookup_arr_ = std::unique_ptr<Zones[]>{ new Zones[zone_lookup_size_] };
-			for (int i = 0; i < zone_lookup_size_; ++i)
-			{
-				in_file.read(reinterpret_cast<char*>(&zone_lookup_arr_[i].zone_id), sizeof(zone_lookup_arr_[i].zone_id));
-				in_file.read(reinterpret_cast<char*>(&zone_lookup_arr_[i].first), sizeof(zone_lookup_arr_[i].first));
-				in_file.read(reinterpret_cast<char*>(&zone_lookup_arr_[i].size), sizeof(zone_lookup_arr_[i].size));
-			}
+		//==================================================================
+		// Get a reference counted pointer to the current snapshot
+		//==================================================================
+		std::shared_ptr<const TzdbSnapshot> TimeZoneDB::GetSnapshot()
+		{
+			return ThreadSnapshot();
+		}
 
+		//==================================================================
+		// Get the snapshot this thread holds
+		//==================================================================
+		const TzdbSnapshot& TimeZoneDB::GetThreadSnapshot()
+		{
+			return *ThreadSnapshot();
+		}
 
-			rule_lookup_size_ = 0;
-			in_file.read(reinterpret_cast<char*>(&rule_lookup_size_), sizeof(rule_lookup_size_));
-			rule_lookup_size_ /= KRULES_SIZE;
+		//==================================================================
+		// The snapshot this thread holds, swapped for the published one
+		// only when the published version moved on
+		//==================================================================
+		const std::shared_ptr<const TzdbSnapshot>& TimeZoneDB::ThreadSnapshot()
+		{
+			thread_local std::shared_ptr<const TzdbSnapshot> thread_snapshot;
+			thread_local uint64_t thread_version = 0;
 
-			// init and populate rule lookup array
-			rule_lookup_arr_ = std::unique_ptr<Rules[]>{ new Rules[rule_lookup_size_] };
-			for (int i = 0; i < rule_lookup_size_; ++i)
+			for (;;)
 			{
-				in_file.read(reinterpret_cast<char*>(&rule_lookup_arr_[i].rule_id), sizeof(rule_lookup_arr_[i].rule_id));
-				in_file.read(reinterpret_cast<char*>(&rule_lookup_arr_[i].first), sizeof(rule_lookup_arr_[i].first));
-				in_file.read(reinterpret_cast<char*>(&rule_lookup_arr_[i].size), sizeof(rule_lookup_arr_[i].size));
-			}
+				uint64_t version = version_.load(std::memory_order_acquire);
+				if (version != 0 && version == thread_version)
+					return thread_snapshot;
 
-			initialized_ = true;
+				if (version == 0)
+					Init();
+
+				// SetPath may have dropped it in between
+				std::lock_guard<std::mutex> lock(mutex_);
+				if (!snapshot_)
+					continue;
+
+				thread_snapshot = snapshot_;
+				thread_version = thread_snapshot->GetVersion();
+
+				return thread_snapshot;
+			}
 		}
 
 		//========================================
@@ -260,13 +231,54 @@ namespace smalltime
 		//========================================
 		void TimeZoneDB::SetPath(std::string path)
 		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
 			path_ = std::move(path);
 		//	path_ = fileutil::ExtractParent(path);
 		//	path_ = fileutil::AddSeparator(path_);
 			path_ += "tzdb.bin";
 
-			initialized_ = false;
+			// loaded again on next use, threads keep the old snapshot till then
+			snapshot_.reset();
+			version_.store(0, std::memory_order_release);
+		}
+
+		//========================================
+		// Set how the tzdb file is loaded
+		//========================================
+		void TimeZoneDB::SetLoadMode(LoadMode load_mode)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			if (load_mode_ == load_mode)
+				return;
+
+			load_mode_ = load_mode;
+			snapshot_.reset();
+			version_.store(0, std::memory_order_release);
+		}
+
+		//========================================
+		// Get how the tzdb is loaded
+		//========================================
+		LoadMode TimeZoneDB::GetLoadMode()
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			return load_mode_;
+		}
+
+		//===============================================
+		// Set the tables compiled into the program
+		//===============================================
+		void TimeZoneDB::SetEmbedded(const EmbeddedTzdb* tables)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
 
+			embedded_ = tables;
+			load_mode_ = tables != nullptr ? LoadMode::KEmbedded : LoadMode::KStream;
+			snapshot_.reset();
+			version_.store(0, std::memory_order_release);
 		}
 
 	}
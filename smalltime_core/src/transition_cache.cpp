@@ -0,0 +1,102 @@
+#include "../include/transition_cache.h"
+
+#include <cstring>
+
+namespace smalltime
+{
+	namespace tz
+	{
+		//=========================================
+		// Ctor - every slot starts out empty
+		//=========================================
+		TransitionCache::TransitionCache() : slots_(new Slot[KCACHE_SLOTS])
+		{
+			for (int i = 0; i < KCACHE_SLOTS; ++i)
+			{
+				slots_[i].sequence.store(0, std::memory_order_relaxed);
+				for (std::size_t w = 0; w < KSLOT_WORDS; ++w)
+					slots_[i].words[w].store(0, std::memory_order_relaxed);
+			}
+		}
+
+		//==================================================================
+		// Copy out the entry for a rule group and year, false on a miss
+		//==================================================================
+		bool TransitionCache::Find(Rules rules, int year, YearTransitions& year_transitions) const
+		{
+			const Slot& slot = slots_[SlotIndex(rules.first, year)];
+
+			uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+			if (sequence & 1)
+				return false;
+
+			uint64_t words[KSLOT_WORDS];
+			for (std::size_t w = 0; w < KSLOT_WORDS; ++w)
+				words[w] = slot.words[w].load(std::memory_order_relaxed);
+
+			// a writer got in while copying, the copy may be torn
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+				return false;
+
+			std::memcpy(&year_transitions, words, sizeof(year_transitions));
+
+			return year_transitions.rule_first == rules.first && year_transitions.rule_size == rules.size &&
+				year_transitions.year == year;
+		}
+
+		//=================================================================
+		// Publish an entry, replacing whatever shared its slot
+		//=================================================================
+		void TransitionCache::Insert(const YearTransitions& year_transitions)
+		{
+			Slot& slot = slots_[SlotIndex(year_transitions.rule_first, year_transitions.year)];
+
+			uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+			if ((sequence & 1) || !slot.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed))
+				return;
+
+			std::atomic_thread_fence(std::memory_order_release);
+
+			uint64_t words[KSLOT_WORDS];
+			std::memcpy(words, &year_transitions, sizeof(year_transitions));
+			for (std::size_t w = 0; w < KSLOT_WORDS; ++w)
+				slot.words[w].store(words[w], std::memory_order_relaxed);
+
+			slot.sequence.store(sequence + 2, std::memory_order_release);
+		}
+
+		//=================================================================
+		// Empty every slot, waits out writers still holding a slot
+		//=================================================================
+		void TransitionCache::Clear()
+		{
+			for (int i = 0; i < KCACHE_SLOTS; ++i)
+			{
+				Slot& slot = slots_[i];
+
+				uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+				while ((sequence & 1) || !slot.sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_relaxed))
+					sequence = slot.sequence.load(std::memory_order_relaxed);
+
+				std::atomic_thread_fence(std::memory_order_release);
+
+				for (std::size_t w = 0; w < KSLOT_WORDS; ++w)
+					slot.words[w].store(0, std::memory_order_relaxed);
+
+				slot.sequence.store(sequence + 2, std::memory_order_release);
+			}
+		}
+
+		//=================================================================
+		// Slot of a rule group and year
+		//=================================================================
+		std::size_t TransitionCache::SlotIndex(int rule_first, int year)
+		{
+			uint32_t hash = static_cast<uint32_t>(rule_first) * 0x9e3779b1u ^ static_cast<uint32_t>(year) * 0x85ebca6bu;
+			hash ^= hash >> 15;
+
+			return hash % KCACHE_SLOTS;
+		}
+	}
+}
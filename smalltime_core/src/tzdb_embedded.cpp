@@ -0,0 +1,42 @@
+#include "../include/tzdb_embedded.h"
+
+// generated by smalltime_compiler -f header
+#include <Tzdb.h>
+
+namespace smalltime
+{
+	namespace tz
+	{
+		static_assert(KMaxYearRuleSize <= KMAX_YEAR_RULE_SIZE, "Tzdb.h has more rules in effect in one year than rule groups hold");
+
+		//=====================================================================
+		// Every table is constexpr so they sit in read-only data, shared by
+		// every process running the program
+		//=====================================================================
+		static constexpr EmbeddedTzdb KEMBEDDED_TZDB =
+		{
+			KZoneArray.data(), static_cast<int>(KZoneArray.size()),
+			KRuleArray.data(), static_cast<int>(KRuleArray.size()),
+			KZoneLookupArray.data(), static_cast<int>(KZoneLookupArray.size()),
+			KRuleLookupArray.data(), static_cast<int>(KRuleLookupArray.size()),
+			KUtcTransitionArray.data(), static_cast<int>(KUtcTransitionArray.size()),
+			KUtcTransitionLookupArray.data(), static_cast<int>(KUtcTransitionLookupArray.size()),
+			KAbbrevArray.data(), static_cast<int>(KAbbrevArray.size()),
+			KZoneIndexDisplacementArray.data(), static_cast<int>(KZoneIndexDisplacementArray.size()),
+			KZoneIndexSlotArray.data(), static_cast<int>(KZoneIndexSlotArray.size()),
+			// names are one string literal, drop its terminating null
+			KZoneIndexNames, static_cast<int>(sizeof(KZoneIndexNames) - 1),
+			KRuleYearRangeArray.data(), static_cast<int>(KRuleYearRangeArray.size()),
+			KRuleYearRangeLookupArray.data(), static_cast<int>(KRuleYearRangeLookupArray.size()),
+			KTransitionHorizon
+		};
+
+		//==================================
+		// Get the compiled in tables
+		//==================================
+		const EmbeddedTzdb& GetEmbeddedTzdb()
+		{
+			return KEMBEDDED_TZDB;
+		}
+	}
+}
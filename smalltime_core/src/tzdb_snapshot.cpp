@@ -0,0 +1,902 @@
+#include "../include/tzdb_snapshot.h"
+#include "../include/core_math.h"
+#include "../include/time_math.h"
+#include "../include/file_util.h"
+#include "../include/tzdb_file.h"
+#include "../include/zone_index.h"
+#include "../include/rule_group.h"
+#include "../include/basic_datetime.h"
+
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+
+namespace smalltime
+{
+	namespace tz
+	{
+
+		static constexpr tz::Zone KZONE{};
+		static constexpr int KZONE_SIZE = sizeof(KZONE.abbrev) + sizeof(KZONE.mb_rule_offset) + sizeof(KZONE.mb_until_utc) + sizeof(KZONE.next_zone_offset) +
+			sizeof(KZONE.rule_id) + sizeof(KZONE.trans_rule_offset) + sizeof(KZONE.until_type) + sizeof(KZONE.zone_id) + sizeof(KZONE.zone_offset);
+
+		static constexpr tz::Rule KRULE{};
+		static constexpr int KRULE_SIZE = sizeof(KRULE.at_time) + sizeof(KRULE.at_type) + sizeof(KRULE.day) + sizeof(KRULE.day_type) +
+			sizeof(KRULE.from_year) + sizeof(KRULE.letter) + sizeof(KRULE.month) + sizeof(KRULE.offset) + sizeof(KRULE.rule_id) + sizeof(KRULE.to_year);
+
+		static constexpr tz::Zones KZONES{};
+		static constexpr int KZONES_SIZE = sizeof(KZONES.first) + sizeof(KZONES.size) + sizeof(KZONES.zone_id);
+
+
+		static constexpr tz::Zones KRULES{};
+		static constexpr int KRULES_SIZE = sizeof(KRULES.first) + sizeof(KRULES.size) + sizeof(KRULES.zone_id);
+
+		//===================================================
+		// Copy a single field out of the mapped file
+		//===================================================
+		template <typename T>
+		static void ReadMapped(const char*& cur, T& field)
+		{
+			std::memcpy(&field, cur, sizeof(field));
+			cur += sizeof(field);
+		}
+
+		//===================================================
+		// Read the byte size of the next section
+		//===================================================
+		static int ReadMappedSection(const char*& cur, const char* end)
+		{
+			int section_size = 0;
+			if (end - cur < static_cast<std::ptrdiff_t>(sizeof(section_size)))
+				throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+
+			ReadMapped(cur, section_size);
+			if (section_size < 0 || end - cur < section_size)
+				throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+
+			return section_size;
+		}
+
+		//=======================================================================
+		// Check if a packed section can be used in place as an array of T
+		//=======================================================================
+		template <typename T>
+		static bool CanUseInPlace(const char* cur, int packed_size)
+		{
+			return packed_size == sizeof(T) && reinterpret_cast<std::uintptr_t>(cur) % alignof(T) == 0;
+		}
+
+		//=====================================================
+		// Check if the image starts with a version 2 header
+		//=====================================================
+		static bool IsVersion2(const char* data, std::size_t size)
+		{
+			uint32_t magic = 0;
+			if (size < sizeof(magic))
+				return false;
+
+			std::memcpy(&magic, data, sizeof(magic));
+			return magic == KTZDB_MAGIC;
+		}
+
+		//=============================================================
+		// Validate a version 2 section and return it as an array of T
+		//=============================================================
+		template <typename T>
+		static const T* GetSection(const char* data, const TzdbHeader& header, TzdbSectionType section_type, int& count)
+		{
+			const auto& section = header.sections[section_type];
+
+			if (section.record_size != sizeof(T) || section.offset % alignof(T) != 0 || section.offset < header.header_size ||
+				section.offset > header.file_size || (header.file_size - section.offset) / sizeof(T) < section.count)
+				throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+
+			count = static_cast<int>(section.count);
+			return reinterpret_cast<const T*>(data + section.offset);
+		}
+
+		
+		//===============================================
+		// Binary search function for zones
+		//===============================================
+		Zones TzdbSnapshot::BinarySearchZones(uint32_t zone_id, int size) const
+		{
+			int left = 0;
+			int right = size - 1;
+
+			while (left <= right)
+			{
+				int middle = (left + right) / 2;
+				const auto& mid_zones = zone_lookup_handle_[middle];
+
+				if (mid_zones.zone_id == zone_id)
+					return mid_zones;
+				else if (zone_id > mid_zones.zone_id)
+					left = middle + 1;
+				else
+					right = middle - 1;
+			}
+
+			return{ zone_id, -1, -1 };
+		}
+
+		//===============================================
+		// Binary search function for zones
+		//===============================================
+		Rules TzdbSnapshot::BinarySearchRules(uint32_t rule_id, int size) const
+		{
+			int left = 0;
+			int right = size - 1;
+
+			while (left <= right)
+			{
+				int middle = (left + right) / 2;
+				const auto& mid_zones = rule_lookup_handle_[middle];
+
+				if (mid_zones.rule_id == rule_id)
+					return mid_zones;
+				else if (rule_id > mid_zones.rule_id)
+					left = middle + 1;
+				else
+					right = middle - 1;
+			}
+
+			return{ rule_id, -1, -1 };
+		}
+
+		//===============================================
+		// Binary search function for transitions
+		//===============================================
+		UtcTransitions TzdbSnapshot::BinarySearchUtcTransitions(uint32_t zone_id, int size) const
+		{
+			int left = 0;
+			int right = size - 1;
+
+			while (left <= right)
+			{
+				int middle = (left + right) / 2;
+				const auto& mid_transitions = utc_transition_lookup_handle_[middle];
+
+				if (mid_transitions.zone_id == zone_id)
+					return mid_transitions;
+				else if (zone_id > mid_transitions.zone_id)
+					left = middle + 1;
+				else
+					right = middle - 1;
+			}
+
+			return{ zone_id, -1, -1, 0.0 };
+		}
+
+		//===============================================
+		// Binary search function for rule year ranges
+		//===============================================
+		RuleYearRanges TzdbSnapshot::BinarySearchRuleYearRanges(uint32_t rule_id, int size) const
+		{
+			int left = 0;
+			int right = size - 1;
+
+			while (left <= right)
+			{
+				int middle = (left + right) / 2;
+				const auto& mid_ranges = rule_year_range_lookup_handle_[middle];
+
+				if (mid_ranges.rule_id == rule_id)
+					return mid_ranges;
+				else if (rule_id > mid_ranges.rule_id)
+					left = middle + 1;
+				else
+					right = middle - 1;
+			}
+
+			return{ rule_id, -1, -1 };
+		}
+
+		//===============================================
+		// Get pointer to first element of tzdb array
+		//================================================
+		const Rule* const TzdbSnapshot::GetRuleHandle() const
+		{
+			return rule_handle_;
+		}
+
+		//===============================================
+		// Get pointer to first element of tzdb array
+		//================================================
+		const Zone* const TzdbSnapshot::GetZoneHandle() const
+		{
+			return zone_handle_;
+		}
+		
+		//================================================
+		// Find rules matching name id
+		//================================================
+		Rules TzdbSnapshot::FindRules(const std::string& name) const
+		{
+			auto rule_id = math::GetUniqueID(name);
+			return BinarySearchRules(rule_id, rule_lookup_size_);
+		}
+
+		//================================================
+		// Find rules matching name id
+		//================================================
+		Rules TzdbSnapshot::FindRules(uint32_t rule_id) const
+		{
+			return BinarySearchRules(rule_id, rule_lookup_size_);
+		}
+
+		//================================================
+		// Find zones matching name, through the zone
+		// index when the tzdb file has one
+		//================================================
+		Zones TzdbSnapshot::FindZones(const std::string& name) const
+		{
+			if (zone_index_slot_handle_ != nullptr)
+			{
+				int lookup_index = FindZoneIndex(name, zone_index_displacement_handle_, zone_index_displacement_size_,
+					zone_index_slot_handle_, zone_index_slot_size_, zone_index_name_handle_);
+
+				if (lookup_index < 0 || lookup_index >= zone_lookup_size_)
+					return{ math::GetUniqueID(name), -1, -1 };
+
+				return zone_lookup_handle_[lookup_index];
+			}
+
+			auto zone_id = math::GetUniqueID(name);
+			return BinarySearchZones(zone_id, zone_lookup_size_);
+		}
+
+		//================================================
+		// Find zones matching name id
+		//================================================
+		Zones TzdbSnapshot::FindZones(uint32_t zone_id) const
+		{
+			return BinarySearchZones(zone_id, zone_lookup_size_);
+		}
+
+		//===============================================
+		// Get pointer to first precompiled transition
+		//================================================
+		const UtcTransition* const TzdbSnapshot::GetUtcTransitionHandle() const
+		{
+			return utc_transition_handle_;
+		}
+
+		//===============================================
+		// Get pointer to first transition moment in ticks
+		//================================================
+		const RDTicks* const TzdbSnapshot::GetUtcTransitionTickHandle() const
+		{
+			return utc_transition_tick_arr_.get();
+		}
+
+		//===============================================
+		// Get pointer to first transition offset in ticks
+		//================================================
+		const RDTicks* const TzdbSnapshot::GetOffsetTickHandle() const
+		{
+			return offset_tick_arr_.get();
+		}
+
+		//================================================
+		// Find precompiled transitions of zone if any
+		//================================================
+		UtcTransitions TzdbSnapshot::FindUtcTransitions(uint32_t zone_id) const
+		{
+			return BinarySearchUtcTransitions(zone_id, utc_transition_lookup_size_);
+		}
+
+		//================================================
+		// Get abbreviation of a transition
+		//================================================
+		std::string TzdbSnapshot::GetAbbrev(uint32_t abbrev_index) const
+		{
+			if (abbrev_index >= static_cast<uint32_t>(abbrev_size_))
+				return std::string();
+
+			// abbreviations are padded with nulls
+			return math::Unpack8Chars(abbrev_handle_[abbrev_index]).c_str();
+		}
+
+		//===============================================
+		// Get pointer to first rule year range
+		//================================================
+		const RuleYearRange* const TzdbSnapshot::GetRuleYearRangeHandle() const
+		{
+			return rule_year_range_handle_;
+		}
+
+		//================================================
+		// Find active years of rule set if any
+		//================================================
+		RuleYearRanges TzdbSnapshot::FindRuleYearRanges(uint32_t rule_id) const
+		{
+			return BinarySearchRuleYearRanges(rule_id, rule_year_range_lookup_size_);
+		}
+
+		//===============================================
+		// Get the transition cache of the loaded tzdb
+		//===============================================
+		TransitionCache* const TzdbSnapshot::GetTransitionCache() const
+		{
+			return &transition_cache_;
+		}
+
+		//=============================================
+		// Ctor - nothing is loaded yet
+		//=============================================
+		TzdbSnapshot::TzdbSnapshot(std::string path, uint64_t version) :
+			path_(std::move(path)),
+			version_(version),
+			zone_handle_(nullptr),
+			rule_handle_(nullptr),
+			zone_lookup_handle_(nullptr),
+			rule_lookup_handle_(nullptr),
+			utc_transition_handle_(nullptr),
+			utc_transition_lookup_handle_(nullptr),
+			abbrev_handle_(nullptr),
+			zone_index_displacement_handle_(nullptr),
+			zone_index_slot_handle_(nullptr),
+			zone_index_name_handle_(nullptr),
+			rule_year_range_handle_(nullptr),
+			rule_year_range_lookup_handle_(nullptr),
+			zone_size_(0),
+			rule_size_(0),
+			zone_lookup_size_(0),
+			rule_lookup_size_(0),
+			utc_transition_size_(0),
+			utc_transition_lookup_size_(0),
+			abbrev_size_(0),
+			zone_index_displacement_size_(0),
+			zone_index_slot_size_(0),
+			zone_index_name_size_(0),
+			rule_year_range_size_(0),
+			rule_year_range_lookup_size_(0),
+			transition_horizon_(0)
+		{
+
+		}
+
+		//=============================================
+		// Load a tzdb file into a new snapshot
+		//=============================================
+		std::shared_ptr<const TzdbSnapshot> TzdbSnapshot::Load(std::string path, LoadMode load_mode, uint64_t version)
+		{
+			std::shared_ptr<TzdbSnapshot> snapshot{ new TzdbSnapshot(std::move(path), version) };
+
+			if (load_mode == LoadMode::KMapped)
+				snapshot->InitFromMapping();
+			else
+				snapshot->InitFromStream();
+
+			snapshot->InitUtcTransitionTicks();
+			return snapshot;
+		}
+
+		//=============================================
+		// Wrap tables compiled into the program
+		//=============================================
+		std::shared_ptr<const TzdbSnapshot> TzdbSnapshot::Load(const EmbeddedTzdb& tables, uint64_t version)
+		{
+			std::shared_ptr<TzdbSnapshot> snapshot{ new TzdbSnapshot(std::string(), version) };
+			snapshot->InitFromTables(tables);
+
+			snapshot->InitUtcTransitionTicks();
+			return snapshot;
+		}
+
+		//=============================================
+		// Read tzdb from binary file into heap arrays
+		//=============================================
+		void TzdbSnapshot::InitFromStream()
+		{
+			mapped_file_.Close();
+
+			std::ifstream in_file (path_.c_str(), std::ios::in | std::ios::binary);
+			auto tzdb_id = math::GetUniqueID("TZDB_FILE");
+
+			// check if file length is correct
+			in_file.seekg(0, in_file.end);
+			int file_size = in_file.tellg();
+			in_file.seekg(0, in_file.beg);
+
+			uint32_t magic = 0;
+			in_file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+			in_file.seekg(0, in_file.beg);
+
+			// version 2 files are read whole and used in place
+			if (file_size > 0 && magic == KTZDB_MAGIC)
+			{
+				file_buffer_ = std::unique_ptr<uint64_t[]>{ new uint64_t[(file_size + sizeof(uint64_t) - 1) / sizeof(uint64_t)] };
+				in_file.read(reinterpret_cast<char*>(file_buffer_.get()), file_size);
+
+				if (!in_file)
+					throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+
+				InitFromImage(reinterpret_cast<const char*>(file_buffer_.get()), file_size, true);
+				return;
+			}
+
+			file_buffer_.reset();
+
+			uint32_t in_tzdb_id = 0;
+			in_file.read(reinterpret_cast<char*>(&in_tzdb_id), sizeof(in_tzdb_id));
+
+			// check if file id is correct
+			if (tzdb_id != in_tzdb_id)
+				throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+
+			int in_file_size = 0;
+			in_file.read(reinterpret_cast<char*>(&in_file_size), sizeof(in_file_size));
+
+			if (in_file_size != file_size)
+				throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+
+			zone_size_ = 0;
+			in_file.read(reinterpret_cast<char*>(&zone_size_), sizeof(zone_size_));
+			zone_size_ /= KZONE_SIZE;
+
+			// init and populate zone array
+			zone_arr_ = std::unique_ptr<Zone[]>{ new Zone[zone_size_] };
+			for (int i = 0; i < zone_size_; ++i)
+			{
+				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].zone_id), sizeof(zone_arr_[i].zone_id));
+				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].rule_id), sizeof(zone_arr_[i].rule_id));
+				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].mb_until_utc), sizeof(zone_arr_[i].mb_until_utc));
+				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].until_type), sizeof(zone_arr_[i].until_type));
+				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].zone_offset), sizeof(zone_arr_[i].zone_offset));
+				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].next_zone_offset), sizeof(zone_arr_[i].next_zone_offset));
+				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].mb_rule_offset), sizeof(zone_arr_[i].mb_rule_offset));
+				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].trans_rule_offset), sizeof(zone_arr_[i].trans_rule_offset));
+				in_file.read(reinterpret_cast<char*>(&zone_arr_[i].abbrev), sizeof(zone_arr_[i].abbrev));
+			}
+
+			rule_size_ = 0;
+			in_file.read(reinterpret_cast<char*>(&rule_size_), sizeof(rule_size_));
+			rule_size_ /= KRULE_SIZE;
+
+			// init and populate rule array
+			rule_arr_ = std::unique_ptr<Rule[]>{ new Rule[rule_size_] };
+			for (int i = 0; i < rule_size_; ++i)
+			{
+				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].rule_id), sizeof(rule_arr_[i].rule_id));
+				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].from_year), sizeof(rule_arr_[i].from_year));
+				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].to_year), sizeof(rule_arr_[i].to_year));
+				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].month), sizeof(rule_arr_[i].month));
+				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].day), sizeof(rule_arr_[i].day));
+				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].day_type), sizeof(rule_arr_[i].day_type));
+				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].at_time), sizeof(rule_arr_[i].at_time));
+				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].at_type), sizeof(rule_arr_[i].at_type));
+				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].offset), sizeof(rule_arr_[i].offset));
+				in_file.read(reinterpret_cast<char*>(&rule_arr_[i].letter), sizeof(rule_arr_[i].letter));
+
+			}
+
+			zone_lookup_size_ = 0;
+			in_file.read(reinterpret_cast<char*>(&zone_lookup_size_), sizeof(zone_lookup_size_));
+			zone_lookup_size_ /= KZONES_SIZE;
+
+			// init and populate zone lookup array
+			zone_lookup_arr_ = std::unique_ptr<Zones[]>{ new Zones[zone_lookup_size_] };
+			for (int i = 0; i < zone_lookup_size_; ++i)
+			{
+				in_file.read(reinterpret_cast<char*>(&zone_lookup_arr_[i].zone_id), sizeof(zone_lookup_arr_[i].zone_id));
+				in_file.read(reinterpret_cast<char*>(&zone_lookup_arr_[i].first), sizeof(zone_lookup_arr_[i].first));
+				in_file.read(reinterpret_cast<char*>(&zone_lookup_arr_[i].size), sizeof(zone_lookup_arr_[i].size));
+			}
+
+
+			rule_lookup_size_ = 0;
+			in_file.read(reinterpret_cast<char*>(&rule_lookup_size_), sizeof(rule_lookup_size_));
+			rule_lookup_size_ /= KRULES_SIZE;
+
+			// init and populate rule lookup array
+			rule_lookup_arr_ = std::unique_ptr<Rules[]>{ new Rules[rule_lookup_size_] };
+			for (int i = 0; i < rule_lookup_size_; ++i)
+			{
+				in_file.read(reinterpret_cast<char*>(&rule_lookup_arr_[i].rule_id), sizeof(rule_lookup_arr_[i].rule_id));
+				in_file.read(reinterpret_cast<char*>(&rule_lookup_arr_[i].first), sizeof(rule_lookup_arr_[i].first));
+				in_file.read(reinterpret_cast<char*>(&rule_lookup_arr_[i].size), sizeof(rule_lookup_arr_[i].size));
+			}
+
+			zone_handle_ = zone_arr_.get();
+			rule_handle_ = rule_arr_.get();
+			zone_lookup_handle_ = zone_lookup_arr_.get();
+			rule_lookup_handle_ = rule_lookup_arr_.get();
+
+			CheckYearRuleSize(0);
+
+			// version 1 files have no precompiled transitions, zone index or rule years
+			ResetUtcTransitions();
+			ResetZoneIndex();
+			ResetRuleYearRanges();
+		}
+
+		//===================================================================
+		// Map tzdb file read-only, sections whose packed layout matches
+		// the in memory layout are used in place
+		//===================================================================
+		void TzdbSnapshot::InitFromMapping()
+		{
+			if (!mapped_file_.Open(path_))
+				throw std::runtime_error("tzdb file could not be mapped, unable to read");
+
+			file_buffer_.reset();
+
+			// version 2 sections are validated and used in place, skip the checksum
+			// so startup does not have to touch every page of the mapping
+			if (IsVersion2(mapped_file_.GetData(), mapped_file_.GetSize()))
+			{
+				InitFromImage(mapped_file_.GetData(), mapped_file_.GetSize(), false);
+				return;
+			}
+
+			const char* cur = mapped_file_.GetData();
+			const char* end = cur + mapped_file_.GetSize();
+			auto tzdb_id = math::GetUniqueID("TZDB_FILE");
+
+			uint32_t in_tzdb_id = 0;
+			int in_file_size = 0;
+			if (mapped_file_.GetSize() < sizeof(in_tzdb_id) + sizeof(in_file_size))
+				throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+
+			ReadMapped(cur, in_tzdb_id);
+			ReadMapped(cur, in_file_size);
+
+			// check if file id and length are correct
+			if (tzdb_id != in_tzdb_id || static_cast<std::size_t>(in_file_size) != mapped_file_.GetSize())
+				throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+
+			// zones are stored packed and never match the in memory layout
+			zone_size_ = ReadMappedSection(cur, end) / KZONE_SIZE;
+			zone_arr_ = std::unique_ptr<Zone[]>{ new Zone[zone_size_] };
+			for (int i = 0; i < zone_size_; ++i)
+			{
+				ReadMapped(cur, zone_arr_[i].zone_id);
+				ReadMapped(cur, zone_arr_[i].rule_id);
+				ReadMapped(cur, zone_arr_[i].mb_until_utc);
+				ReadMapped(cur, zone_arr_[i].until_type);
+				ReadMapped(cur, zone_arr_[i].zone_offset);
+				ReadMapped(cur, zone_arr_[i].next_zone_offset);
+				ReadMapped(cur, zone_arr_[i].mb_rule_offset);
+				ReadMapped(cur, zone_arr_[i].trans_rule_offset);
+				ReadMapped(cur, zone_arr_[i].abbrev);
+			}
+			zone_handle_ = zone_arr_.get();
+
+			// rules are stored packed and never match the in memory layout
+			rule_size_ = ReadMappedSection(cur, end) / KRULE_SIZE;
+			rule_arr_ = std::unique_ptr<Rule[]>{ new Rule[rule_size_] };
+			for (int i = 0; i < rule_size_; ++i)
+			{
+				ReadMapped(cur, rule_arr_[i].rule_id);
+				ReadMapped(cur, rule_arr_[i].from_year);
+				ReadMapped(cur, rule_arr_[i].to_year);
+				ReadMapped(cur, rule_arr_[i].month);
+				ReadMapped(cur, rule_arr_[i].day);
+				ReadMapped(cur, rule_arr_[i].day_type);
+				ReadMapped(cur, rule_arr_[i].at_time);
+				ReadMapped(cur, rule_arr_[i].at_type);
+				ReadMapped(cur, rule_arr_[i].offset);
+				ReadMapped(cur, rule_arr_[i].letter);
+			}
+			rule_handle_ = rule_arr_.get();
+
+			// lookup tables only hold 32 bit fields so they can be used in place
+			int section_size = ReadMappedSection(cur, end);
+			zone_lookup_size_ = section_size / KZONES_SIZE;
+			if (CanUseInPlace<Zones>(cur, KZONES_SIZE))
+			{
+				zone_lookup_arr_.reset();
+				zone_lookup_handle_ = reinterpret_cast<const Zones*>(cur);
+				cur += section_size;
+			}
+			else
+			{
+				zone_lookup_arr_ = std::unique_ptr<Zones[]>{ new Zones[zone_lookup_size_] };
+				for (int i = 0; i < zone_lookup_size_; ++i)
+				{
+					ReadMapped(cur, zone_lookup_arr_[i].zone_id);
+					ReadMapped(cur, zone_lookup_arr_[i].first);
+					ReadMapped(cur, zone_lookup_arr_[i].size);
+				}
+				zone_lookup_handle_ = zone_lookup_arr_.get();
+			}
+
+			section_size = ReadMappedSection(cur, end);
+			rule_lookup_size_ = section_size / KRULES_SIZE;
+			if (CanUseInPlace<Rules>(cur, KRULES_SIZE))
+			{
+				rule_lookup_arr_.reset();
+				rule_lookup_handle_ = reinterpret_cast<const Rules*>(cur);
+				cur += section_size;
+			}
+			else
+			{
+				rule_lookup_arr_ = std::unique_ptr<Rules[]>{ new Rules[rule_lookup_size_] };
+				for (int i = 0; i < rule_lookup_size_; ++i)
+				{
+					ReadMapped(cur, rule_lookup_arr_[i].rule_id);
+					ReadMapped(cur, rule_lookup_arr_[i].first);
+					ReadMapped(cur, rule_lookup_arr_[i].size);
+				}
+				rule_lookup_handle_ = rule_lookup_arr_.get();
+			}
+
+			CheckYearRuleSize(0);
+
+			// version 1 files have no precompiled transitions, zone index or rule years
+			ResetUtcTransitions();
+			ResetZoneIndex();
+			ResetRuleYearRanges();
+		}
+
+		//===================================================================
+		// Point handles straight into a version 2 image, the image must
+		// stay alive and aligned to at least 8 bytes
+		//===================================================================
+		void TzdbSnapshot::InitFromImage(const char* data, std::size_t size, bool verify_checksum)
+		{
+			TzdbHeader header;
+			if (size < sizeof(header))
+				throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+
+			std::memcpy(&header, data, sizeof(header));
+
+			// the bytes past an older header already belong to the first section
+			if (header.header_size == KTZDB_HEADER_SIZE_NO_HORIZON)
+			{
+				header.transition_horizon = 0;
+				header.reserved = 0;
+			}
+
+			if (header.magic != KTZDB_MAGIC || header.version != KTZDB_VERSION ||
+				(header.header_size != sizeof(header) && header.header_size != KTZDB_HEADER_SIZE_NO_HORIZON) ||
+				header.file_size != size || header.section_count < KTZDB_REQUIRED_SECTIONS || header.section_count > KTZDB_MAX_SECTIONS)
+				throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+
+			if (verify_checksum && math::Crc32(data + header.header_size, size - header.header_size) != header.crc)
+				throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+
+			zone_handle_ = GetSection<Zone>(data, header, KTzdbSection_Zone, zone_size_);
+			rule_handle_ = GetSection<Rule>(data, header, KTzdbSection_Rule, rule_size_);
+			zone_lookup_handle_ = GetSection<Zones>(data, header, KTzdbSection_ZoneLookup, zone_lookup_size_);
+			rule_lookup_handle_ = GetSection<Rules>(data, header, KTzdbSection_RuleLookup, rule_lookup_size_);
+
+			for (int i = 0; i < zone_lookup_size_; ++i)
+			{
+				const auto& zones = zone_lookup_handle_[i];
+				if (zones.first < 0 || zones.size < 0 || zones.first > zone_size_ || zones.size > zone_size_ - zones.first)
+					throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+			}
+
+			for (int i = 0; i < rule_lookup_size_; ++i)
+			{
+				const auto& rules = rule_lookup_handle_[i];
+				if (rules.first < 0 || rules.size < 0 || rules.first > rule_size_ || rules.size > rule_size_ - rules.first)
+					throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+			}
+
+			CheckYearRuleSize(header.max_year_rule_size);
+			transition_horizon_ = header.transition_horizon;
+
+			if (header.section_count > KTzdbSection_Abbrev)
+			{
+				utc_transition_handle_ = GetSection<UtcTransition>(data, header, KTzdbSection_UtcTransition, utc_transition_size_);
+				utc_transition_lookup_handle_ = GetSection<UtcTransitions>(data, header, KTzdbSection_UtcTransitionLookup, utc_transition_lookup_size_);
+				abbrev_handle_ = GetSection<uint64_t>(data, header, KTzdbSection_Abbrev, abbrev_size_);
+
+				for (int i = 0; i < utc_transition_lookup_size_; ++i)
+				{
+					const auto& utc_transitions = utc_transition_lookup_handle_[i];
+					if (utc_transitions.first < 0 || utc_transitions.size < 0 || utc_transitions.first > utc_transition_size_ ||
+						utc_transitions.size > utc_transition_size_ - utc_transitions.first)
+						throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+				}
+
+				CheckTransitionHorizon();
+			}
+			else
+			{
+				ResetUtcTransitions();
+			}
+
+			if (header.section_count > KTzdbSection_ZoneIndexName)
+			{
+				zone_index_displacement_handle_ = GetSection<uint32_t>(data, header, KTzdbSection_ZoneIndexDisplacement, zone_index_displacement_size_);
+				zone_index_slot_handle_ = GetSection<ZoneIndexSlot>(data, header, KTzdbSection_ZoneIndexSlot, zone_index_slot_size_);
+				zone_index_name_handle_ = GetSection<char>(data, header, KTzdbSection_ZoneIndexName, zone_index_name_size_);
+
+				for (int i = 0; i < zone_index_slot_size_; ++i)
+				{
+					const auto& slot = zone_index_slot_handle_[i];
+					if (slot.name_offset > static_cast<uint32_t>(zone_index_name_size_) ||
+						slot.name_size > static_cast<uint32_t>(zone_index_name_size_) - slot.name_offset)
+						throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+				}
+
+				// an empty index can not be searched
+				if (zone_index_displacement_size_ == 0 || zone_index_slot_size_ == 0)
+					ResetZoneIndex();
+			}
+			else
+			{
+				ResetZoneIndex();
+			}
+
+			if (header.section_count > KTzdbSection_RuleYearRangeLookup)
+			{
+				rule_year_range_handle_ = GetSection<RuleYearRange>(data, header, KTzdbSection_RuleYearRange, rule_year_range_size_);
+				rule_year_range_lookup_handle_ = GetSection<RuleYearRanges>(data, header, KTzdbSection_RuleYearRangeLookup, rule_year_range_lookup_size_);
+
+				for (int i = 0; i < rule_year_range_lookup_size_; ++i)
+				{
+					const auto& ranges = rule_year_range_lookup_handle_[i];
+					if (ranges.first < 0 || ranges.size < 0 || ranges.first > rule_year_range_size_ || ranges.size > rule_year_range_size_ - ranges.first)
+						throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+				}
+			}
+			else
+			{
+				ResetRuleYearRanges();
+			}
+
+			zone_arr_.reset();
+			rule_arr_.reset();
+			zone_lookup_arr_.reset();
+			rule_lookup_arr_.reset();
+		}
+
+		//===================================================================
+		// Point handles at tables compiled into the program, they come
+		// from the same compiler as the file so are not checked again
+		//===================================================================
+		void TzdbSnapshot::InitFromTables(const EmbeddedTzdb& tables)
+		{
+			zone_handle_ = tables.zones;
+			zone_size_ = tables.zone_size;
+			rule_handle_ = tables.rules;
+			rule_size_ = tables.rule_size;
+			zone_lookup_handle_ = tables.zone_lookup;
+			zone_lookup_size_ = tables.zone_lookup_size;
+			rule_lookup_handle_ = tables.rule_lookup;
+			rule_lookup_size_ = tables.rule_lookup_size;
+
+			utc_transition_handle_ = tables.utc_transitions;
+			utc_transition_size_ = tables.utc_transition_size;
+			utc_transition_lookup_handle_ = tables.utc_transition_lookup;
+			utc_transition_lookup_size_ = tables.utc_transition_lookup_size;
+			abbrev_handle_ = tables.abbrevs;
+			abbrev_size_ = tables.abbrev_size;
+
+			transition_horizon_ = tables.transition_horizon;
+
+			if (utc_transition_lookup_size_ == 0)
+				ResetUtcTransitions();
+
+			zone_index_displacement_handle_ = tables.zone_index_displacements;
+			zone_index_displacement_size_ = tables.zone_index_displacement_size;
+			zone_index_slot_handle_ = tables.zone_index_slots;
+			zone_index_slot_size_ = tables.zone_index_slot_size;
+			zone_index_name_handle_ = tables.zone_index_names;
+			zone_index_name_size_ = tables.zone_index_name_size;
+
+			// an empty index can not be searched
+			if (zone_index_displacement_size_ == 0 || zone_index_slot_size_ == 0)
+				ResetZoneIndex();
+
+			rule_year_range_handle_ = tables.rule_year_ranges;
+			rule_year_range_size_ = tables.rule_year_range_size;
+			rule_year_range_lookup_handle_ = tables.rule_year_range_lookup;
+			rule_year_range_lookup_size_ = tables.rule_year_range_lookup_size;
+
+			if (rule_year_range_lookup_size_ == 0)
+				ResetRuleYearRanges();
+		}
+
+		//==================================================
+		// Drop precompiled transitions, zone rules are used
+		//==================================================
+		void TzdbSnapshot::ResetUtcTransitions()
+		{
+			utc_transition_handle_ = nullptr;
+			utc_transition_lookup_handle_ = nullptr;
+			abbrev_handle_ = nullptr;
+
+			utc_transition_size_ = 0;
+			utc_transition_lookup_size_ = 0;
+			abbrev_size_ = 0;
+			transition_horizon_ = 0;
+		}
+
+		//==================================================
+		// Convert the precompiled transitions to ticks so
+		// handles and lookups share one integer table
+		//==================================================
+		void TzdbSnapshot::InitUtcTransitionTicks()
+		{
+			if (utc_transition_size_ == 0)
+				return;
+
+			utc_transition_tick_arr_.reset(new RDTicks[utc_transition_size_]);
+			offset_tick_arr_.reset(new RDTicks[utc_transition_size_]);
+
+			for (int i = 0; i < utc_transition_size_; ++i)
+			{
+				utc_transition_tick_arr_[i] = math::TicksFromFixed(utc_transition_handle_[i].utc);
+				offset_tick_arr_[i] = math::TicksFromFixed(utc_transition_handle_[i].offset);
+			}
+		}
+
+		//==================================================
+		// Drop zone index, names are found by hashed id
+		//==================================================
+		void TzdbSnapshot::ResetZoneIndex()
+		{
+			zone_index_displacement_handle_ = nullptr;
+			zone_index_slot_handle_ = nullptr;
+			zone_index_name_handle_ = nullptr;
+
+			zone_index_displacement_size_ = 0;
+			zone_index_slot_size_ = 0;
+			zone_index_name_size_ = 0;
+		}
+
+		//=====================================================================
+		// Refuse rules needing more transitions in one year than rule groups
+		// hold, files that do not record it have it counted
+		//=====================================================================
+		void TzdbSnapshot::CheckYearRuleSize(uint32_t max_year_rule_size) const
+		{
+			if (max_year_rule_size == 0)
+			{
+				for (int i = 0; i < rule_lookup_size_; ++i)
+				{
+					const auto& rules = rule_lookup_handle_[i];
+					if (rules.first < 0 || rules.size < 0 || rules.first > rule_size_ || rules.size > rule_size_ - rules.first)
+						throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+				}
+
+				max_year_rule_size = RuleGroup::FindMaxYearRuleSize(rule_lookup_handle_, rule_lookup_size_, rule_handle_);
+			}
+
+			if (max_year_rule_size > static_cast<uint32_t>(KMAX_YEAR_RULE_SIZE))
+				throw std::runtime_error("tzdb has more rules in effect in one year than are supported");
+		}
+
+		//=====================================================================
+		// Zones are precompiled up to the recorded horizon, a tail past the
+		// start of the year after it means the lookup does not belong to
+		// the transitions. Files that do not record it are not checked
+		//=====================================================================
+		void TzdbSnapshot::CheckTransitionHorizon() const
+		{
+			if (transition_horizon_ == 0)
+				return;
+
+			if (transition_horizon_ < 1 || transition_horizon_ >= MAX - 1)
+				throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+
+			RD horizon_utc = BasicDateTime<>(transition_horizon_ + 1, 1, 1, 0, 0, 0, 0, KTimeType_Utc).GetFixed();
+			for (int i = 0; i < utc_transition_lookup_size_; ++i)
+			{
+				RD tail_utc = utc_transition_lookup_handle_[i].tail_utc;
+				if (tail_utc > horizon_utc && tail_utc != DMAX)
+					throw std::runtime_error("tzdb file posibly corrupt, unable to read");
+			}
+		}
+
+		//==================================================
+		// Drop rule year ranges, rule groups scan the rules
+		//==================================================
+		void TzdbSnapshot::ResetRuleYearRanges()
+		{
+			rule_year_range_handle_ = nullptr;
+			rule_year_range_lookup_handle_ = nullptr;
+
+			rule_year_range_size_ = 0;
+			rule_year_range_lookup_size_ = 0;
+		}
+
+	}
+}
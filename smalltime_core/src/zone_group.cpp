@@ -5,7 +5,6 @@
 #include <array>
 
 #include "../include/smalltime_exceptions.h"
-#include "../include/float_util.h"
 #include <time_math.h>
 #include <smalltime_exceptions.h>
 #include <rule_group.h>
@@ -17,7 +16,7 @@ namespace smalltime
 		//=============================================
 		// Ctor
 		//=============================================
-		ZoneGroup::ZoneGroup(Zones zones, const Zone* const zone_arr) : zones_(zones), zone_arr_(zone_arr)
+		ZoneGroup::ZoneGroup(Zones zones, const Zone* const zone_arr, Status* const status) : zone_arr_(zone_arr), zones_(zones), status_(status)
 		{
 
 		}
@@ -30,27 +29,11 @@ namespace smalltime
 			const Zone* cur_zone = nullptr;
 			int closest_zone_index = 0;
 			int last_zone_index = zones_.first + zones_.size - 1;
-			ZoneTransition zt(0.0, 0.0, 0.0, 0.0, 0.0);
+			RDTicks cur_ticks = math::TicksFromFixed(cur_dt.GetFixed());
 
 			for (int i = zones_.first; i <= last_zone_index; ++i)
 			{
-				zt.Reset(zone_arr_[i].mb_until_utc, zone_arr_[i].zone_offset, zone_arr_[i].next_zone_offset, zone_arr_[i].mb_rule_offset, zone_arr_[i].trans_rule_offset);
-
-				RD trans_any = 0.0;
-				switch (cur_dt.GetType())
-				{
-				case KTimeType_Wall:
-					trans_any = zt.trans_wall_;
-					break;
-				case KTimeType_Std:
-					trans_any = zt.trans_std_;
-					break;
-				case KTimeType_Utc:
-					trans_any = zt.trans_utc_;
-					break;
-				}
-
-				if (cur_dt.GetFixed() < trans_any || i == last_zone_index)
+				if (cur_ticks < FindTransitionTicks(zone_arr_[i], cur_dt.GetType()) || i == last_zone_index)
 				{
 					cur_zone = &zone_arr_[i];
 					closest_zone_index = i;
@@ -63,7 +46,8 @@ namespace smalltime
 			if (cur_zone == nullptr)
 				return cur_zone;
 
-			return CorrectForAmbigAny(cur_dt, closest_zone_index, zt, choose);
+			ZoneTransition zt(cur_zone->mb_until_utc, cur_zone->zone_offset, cur_zone->next_zone_offset, cur_zone->mb_rule_offset, cur_zone->trans_rule_offset);
+			return CorrectForAmbigAny(cur_ticks, cur_dt.GetType(), closest_zone_index, zt, choose);
 
 		}
 
@@ -77,27 +61,11 @@ namespace smalltime
 			int closest_zone_index = -1;
 			int prev_zone_index = -1;
 			int last_zone_index = zones_.first + zones_.size - 1;
-			ZoneTransition zt(0.0, 0.0, 0.0, 0.0, 0.0);
+			RDTicks cur_ticks = math::TicksFromFixed(cur_dt.GetFixed());
 
 			for (int i = zones_.first; i <= last_zone_index; ++i)
 			{
-				zt.Reset(zone_arr_[i].mb_until_utc, zone_arr_[i].zone_offset, zone_arr_[i].next_zone_offset, zone_arr_[i].mb_rule_offset, zone_arr_[i].trans_rule_offset);
-
-				RD trans_any = 0.0;
-				switch (cur_dt.GetType())
-				{
-				case KTimeType_Wall:
-					trans_any = zt.trans_wall_;
-					break;
-				case KTimeType_Std:
-					trans_any = zt.trans_std_;
-					break;
-				case KTimeType_Utc:
-					trans_any = zt.trans_utc_;
-					break;
-				}
-
-				if (cur_dt.GetFixed() < trans_any || i == last_zone_index)
+				if (cur_ticks < FindTransitionTicks(zone_arr_[i], cur_dt.GetType()) || i == last_zone_index)
 				{
 					closest_zone_index = i;
 					cur_zone = &zone_arr_[closest_zone_index];
@@ -116,44 +84,40 @@ namespace smalltime
 			if (cur_zone == nullptr)
 				return std::make_pair(prev_zone, cur_zone);
 
-			return CorrectPairForAmbigAny(cur_dt, closest_zone_index, zt, choose);
+			ZoneTransition zt(cur_zone->mb_until_utc, cur_zone->zone_offset, cur_zone->next_zone_offset, cur_zone->mb_rule_offset, cur_zone->trans_rule_offset);
+			return CorrectPairForAmbigAny(cur_ticks, cur_dt.GetType(), closest_zone_index, zt, choose);
 		}
 
 		//========================================================
 		// Correct for ambigousness between zones
 		//========================================================
-		const Zone* const ZoneGroup::CorrectForAmbigAny(const BasicDateTime<>& cur_dt, int cur_zone_index, const ZoneTransition& cur_zone_transition, Choose choose)
+		const Zone* const ZoneGroup::CorrectForAmbigAny(RDTicks cur_ticks, TimeType time_type, int cur_zone_index, const ZoneTransition& cur_zone_transition, Choose choose)
 		{
 
 			auto cur_zone = &zone_arr_[cur_zone_index];
 			auto next_zone = FindNextZone(cur_zone_index);
 
-			RD mb_any = 0.0;
-			RD fi_any = 0.0;
-			TimeType time_type = KTimeType_Wall;
+			RDTicks mb_any = 0;
+			RDTicks fi_any = 0;
 
-			switch (cur_dt.GetType())
+			switch (time_type)
 			{
 			case KTimeType_Wall:
 				mb_any = cur_zone_transition.mb_trans_wall_;
 				fi_any = cur_zone_transition.first_inst_wall_;
-				time_type = KTimeType_Wall;
 				break;
 			case KTimeType_Std:
 				mb_any = cur_zone_transition.mb_trans_std_;
 				fi_any = cur_zone_transition.first_inst_std_;
-				time_type = KTimeType_Std;
 				break;
 			case KTimeType_Utc:
 				mb_any = cur_zone_transition.mb_trans_utc_;
 				fi_any = cur_zone_transition.trans_utc_;
-				time_type = KTimeType_Utc;
 				break;
 			}
 
 			// check for ambig with current and next zone
-			if ((fi_any <= cur_dt.GetFixed() || AlmostEqualRelative(fi_any, cur_dt.GetFixed())) &&
-				(cur_dt.GetFixed() <= mb_any || AlmostEqualRelative(mb_any, cur_dt.GetFixed())))
+			if (fi_any <= cur_ticks && cur_ticks <= mb_any)
 			{
 				switch (choose)
 				{
@@ -163,7 +127,10 @@ namespace smalltime
 				case Choose::KLatest:
 					return next_zone;
 				case Choose::KError:
-					throw TimeZoneAmbigMultiException(BasicDateTime<>(fi_any, time_type), BasicDateTime<>(mb_any, time_type));
+					if (!status_)
+						throw TimeZoneAmbigMultiException(BasicDateTime<>(math::FixedFromTicks(fi_any), time_type), BasicDateTime<>(math::FixedFromTicks(mb_any), time_type));
+					*status_ = Status::KAmbigMulti;
+					return cur_zone;
 				}
 			}
 
@@ -174,31 +141,26 @@ namespace smalltime
 
 			ZoneTransition prev_zone_transition(prev_zone->mb_until_utc, prev_zone->zone_offset, prev_zone->next_zone_offset, prev_zone->mb_rule_offset, prev_zone->trans_rule_offset);
 
-			mb_any = 0.0;
-			fi_any = 0.0;
-			time_type = KTimeType_Wall;
+			mb_any = 0;
+			fi_any = 0;
 
-			switch (cur_dt.GetType())
+			switch (time_type)
 			{
 			case KTimeType_Wall:
 				mb_any = prev_zone_transition.mb_trans_wall_;
 				fi_any = prev_zone_transition.first_inst_wall_;
-				time_type = KTimeType_Wall;
 				break;
 			case KTimeType_Std:
 				mb_any = prev_zone_transition.mb_trans_std_;
 				fi_any = prev_zone_transition.first_inst_std_;
-				time_type = KTimeType_Std;
 				break;
 			case KTimeType_Utc:
 				mb_any = prev_zone_transition.mb_trans_utc_;
 				fi_any = prev_zone_transition.trans_utc_;
-				time_type = KTimeType_Utc;
 				break;
 			}
 
-			if ((mb_any < cur_dt.GetFixed() && !AlmostEqualRelative(mb_any, cur_dt.GetFixed())) &&
-				(cur_dt.GetFixed() < fi_any) && !AlmostEqualRelative(cur_dt.GetFixed(), fi_any))
+			if (mb_any < cur_ticks && cur_ticks < fi_any)
 			{
 				switch (choose)
 				{
@@ -208,7 +170,10 @@ namespace smalltime
 				case Choose::KLatest:
 					return cur_zone;
 				case Choose::KError:
-					throw TimeZoneAmbigNoneException(BasicDateTime<>(mb_any, time_type), BasicDateTime<>(fi_any, time_type));
+					if (!status_)
+						throw TimeZoneAmbigNoneException(BasicDateTime<>(math::FixedFromTicks(mb_any), time_type), BasicDateTime<>(math::FixedFromTicks(fi_any), time_type));
+					*status_ = Status::KAmbigNone;
+					return prev_zone;
 				}
 			}
 
@@ -220,39 +185,34 @@ namespace smalltime
 		//========================================================
 		// Correct for ambigousness between zones
 		//========================================================
-		std::pair<const Zone* const, const Zone* const> ZoneGroup::CorrectPairForAmbigAny(const BasicDateTime<>& cur_dt, int cur_zone_index, const ZoneTransition& cur_zone_transition, Choose choose)
+		std::pair<const Zone* const, const Zone* const> ZoneGroup::CorrectPairForAmbigAny(RDTicks cur_ticks, TimeType time_type, int cur_zone_index, const ZoneTransition& cur_zone_transition, Choose choose)
 		{
 
 			auto cur_zone = &zone_arr_[cur_zone_index];
 			auto prev_zone = FindPreviousZone(cur_zone_index);
 			auto next_zone = FindNextZone(cur_zone_index);
 
-			RD mb_any = 0.0;
-			RD fi_any = 0.0;
-			TimeType time_type = KTimeType_Wall;
+			RDTicks mb_any = 0;
+			RDTicks fi_any = 0;
 
-			switch (cur_dt.GetType())
+			switch (time_type)
 			{
 			case KTimeType_Wall:
 				mb_any = cur_zone_transition.mb_trans_wall_;
 				fi_any = cur_zone_transition.first_inst_wall_;
-				time_type = KTimeType_Wall;
 				break;
 			case KTimeType_Std:
 				mb_any = cur_zone_transition.mb_trans_std_;
 				fi_any = cur_zone_transition.first_inst_std_;
-				time_type = KTimeType_Std;
 				break;
 			case KTimeType_Utc:
 				mb_any = cur_zone_transition.mb_trans_utc_;
 				fi_any = cur_zone_transition.trans_utc_;
-				time_type = KTimeType_Utc;
 				break;
 			}
 
 			// check for ambig with current and next zone
-			if ((fi_any <= cur_dt.GetFixed() || AlmostEqualRelative(fi_any, cur_dt.GetFixed())) &&
-				(cur_dt.GetFixed() <= mb_any || AlmostEqualRelative(mb_any, cur_dt.GetFixed())))
+			if (fi_any <= cur_ticks && cur_ticks <= mb_any)
 			{
 				switch (choose)
 				{
@@ -262,7 +222,10 @@ namespace smalltime
 				case Choose::KLatest:
 					return std::make_pair(cur_zone, next_zone);
 				case Choose::KError:
-					throw TimeZoneAmbigMultiException(BasicDateTime<>(fi_any, time_type), BasicDateTime<>(mb_any, time_type));
+					if (!status_)
+						throw TimeZoneAmbigMultiException(BasicDateTime<>(math::FixedFromTicks(fi_any), time_type), BasicDateTime<>(math::FixedFromTicks(mb_any), time_type));
+					*status_ = Status::KAmbigMulti;
+					return std::make_pair(prev_zone, cur_zone);
 				}
 			}
 
@@ -274,31 +237,26 @@ namespace smalltime
 
 			ZoneTransition prev_zone_transition(prev_zone->mb_until_utc, prev_zone->zone_offset, prev_zone->next_zone_offset, prev_zone->mb_rule_offset, prev_zone->trans_rule_offset);
 
-			mb_any = 0.0;
-			fi_any = 0.0;
-			time_type = KTimeType_Wall;
+			mb_any = 0;
+			fi_any = 0;
 
-			switch (cur_dt.GetType())
+			switch (time_type)
 			{
 			case KTimeType_Wall:
 				mb_any = prev_zone_transition.mb_trans_wall_;
 				fi_any = prev_zone_transition.first_inst_wall_;
-				time_type = KTimeType_Wall;
 				break;
 			case KTimeType_Std:
 				mb_any = prev_zone_transition.mb_trans_std_;
 				fi_any = prev_zone_transition.first_inst_std_;
-				time_type = KTimeType_Std;
 				break;
 			case KTimeType_Utc:
 				mb_any = prev_zone_transition.mb_trans_utc_;
 				fi_any = prev_zone_transition.trans_utc_;
-				time_type = KTimeType_Utc;
 				break;
 			}
 
-			if ((mb_any < cur_dt.GetFixed() && !AlmostEqualRelative(mb_any, cur_dt.GetFixed()))
-				&& (cur_dt.GetFixed() < fi_any && !AlmostEqualRelative(cur_dt.GetFixed(), fi_any)))
+			if (mb_any < cur_ticks && cur_ticks < fi_any)
 			{
 				switch (choose)
 				{
@@ -308,7 +266,10 @@ namespace smalltime
 				case Choose::KLatest:
 					return std::make_pair(prev_zone, cur_zone);
 				case Choose::KError:
-					throw TimeZoneAmbigNoneException(BasicDateTime<>(mb_any, time_type), BasicDateTime<>(fi_any, time_type));
+					if (!status_)
+						throw TimeZoneAmbigNoneException(BasicDateTime<>(math::FixedFromTicks(mb_any), time_type), BasicDateTime<>(math::FixedFromTicks(fi_any), time_type));
+					*status_ = Status::KAmbigNone;
+					return std::make_pair(prev_prev_zone, prev_zone);
 				}
 			}
 
@@ -316,6 +277,29 @@ namespace smalltime
 
 		}
 
+		//=================================================================
+		// Transition of a zone in the time type asked for, the search only
+		// compares this so the full transition is built for the match
+		//=================================================================
+		RDTicks ZoneGroup::FindTransitionTicks(const Zone& zone, TimeType time_type)
+		{
+			RDTicks trans_any = math::TicksFromFixed(zone.mb_until_utc) + 1;
+
+			switch (time_type)
+			{
+			case KTimeType_Wall:
+				trans_any += math::TicksFromFixed(zone.zone_offset) + math::TicksFromFixed(zone.mb_rule_offset);
+				break;
+			case KTimeType_Std:
+				trans_any += math::TicksFromFixed(zone.zone_offset);
+				break;
+			case KTimeType_Utc:
+				break;
+			}
+
+			return trans_any;
+		}
+
 		//=============================================
 		// Find previous zone if any
 		//=============================================
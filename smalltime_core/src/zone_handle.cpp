@@ -0,0 +1,123 @@
+#include "../include/zone_handle.h"
+
+#include "../include/core_math.h"
+#include "../include/time_math.h"
+#include "../include/smalltime_exceptions.h"
+
+namespace smalltime
+{
+	namespace tz
+	{
+		//==========================================================
+		// Ctor - resolve the zone by name
+		//==========================================================
+		ZoneHandle::ZoneHandle(const std::string& time_zone_name) : ZoneHandle(time_zone_name, nullptr)
+		{
+
+		}
+
+		//==========================================================
+		// Ctor - zone resolved at compile time
+		//==========================================================
+		ZoneHandle::ZoneHandle(const ZoneLiteral& zone_literal) : ZoneHandle(zone_literal.name, &zone_literal)
+		{
+
+		}
+
+		//==========================================================
+		// Ctor - resolve the zone and the rules of each zone line,
+		// the literal is only used when it matches the snapshot
+		//==========================================================
+		ZoneHandle::ZoneHandle(const std::string& time_zone_name, const ZoneLiteral* const zone_literal) :
+			name_(time_zone_name),
+			zone_id_(math::GetUniqueID(time_zone_name)),
+			snapshot_(TimeZoneDB::GetSnapshot())
+		{
+			if (zone_literal != nullptr && MatchesSnapshot(*zone_literal))
+				zones_ = zone_literal->zones;
+			else
+				zones_ = snapshot_->FindZones(time_zone_name);
+
+			if (zones_.first == -1)
+				throw InvalidTimeZoneException(time_zone_name);
+
+			zone_arr_ = snapshot_->GetZoneHandle();
+			rule_arr_ = snapshot_->GetRuleHandle();
+			utc_transition_arr_ = snapshot_->GetUtcTransitionHandle();
+			utc_transitions_ = snapshot_->FindUtcTransitions(zone_id_);
+
+			zone_rules_.reserve(zones_.size);
+			zone_rule_years_.reserve(zones_.size);
+			for (int i = zones_.first; i < zones_.first + zones_.size; ++i)
+			{
+				if (zone_arr_[i].rule_id > 0)
+				{
+					zone_rules_.push_back(snapshot_->FindRules(zone_arr_[i].rule_id));
+					zone_rule_years_.push_back(snapshot_->FindRuleYearRanges(zone_arr_[i].rule_id));
+				}
+				else
+				{
+					zone_rules_.push_back({ zone_arr_[i].rule_id, -1, -1 });
+					zone_rule_years_.push_back({ zone_arr_[i].rule_id, -1, -1 });
+				}
+			}
+
+			utc_transition_ticks_ = nullptr;
+			offset_ticks_ = nullptr;
+			tail_ticks_ = 0;
+			if (utc_transitions_.first != -1)
+			{
+				utc_transition_ticks_ = snapshot_->GetUtcTransitionTickHandle() + utc_transitions_.first;
+				offset_ticks_ = snapshot_->GetOffsetTickHandle() + utc_transitions_.first;
+				tail_ticks_ = math::TicksFromFixed(utc_transitions_.tail_utc);
+			}
+		}
+
+		//===========================================================
+		// Check the literal's zone lines are where the snapshot
+		// has them, a tzdb file loaded in place of the embedded
+		// one is searched by name instead
+		//===========================================================
+		bool ZoneHandle::MatchesSnapshot(const ZoneLiteral& zone_literal) const
+		{
+			const auto& zones = zone_literal.zones;
+			const auto zone_size = snapshot_->GetZoneSize();
+			const auto* zone_arr = snapshot_->GetZoneHandle();
+
+			if (zones.first < 0 || zones.size < 1 || zones.first + zones.size > zone_size)
+				return false;
+
+			// the range must cover every line of the zone and nothing else
+			const auto last = zones.first + zones.size - 1;
+			return zone_arr[zones.first].zone_id == zone_literal.line_zone_id && zone_arr[last].zone_id == zone_literal.line_zone_id &&
+				(zones.first == 0 || zone_arr[zones.first - 1].zone_id != zone_literal.line_zone_id) &&
+				(last + 1 == zone_size || zone_arr[last + 1].zone_id != zone_literal.line_zone_id);
+		}
+
+		//===========================================================
+		// Rules of a zone line belonging to this zone
+		//===========================================================
+		Rules ZoneHandle::FindRules(const Zone* const zone) const
+		{
+			auto index = static_cast<int>(zone - zone_arr_) - zones_.first;
+
+			if (index < 0 || index >= zones_.size)
+				return snapshot_->FindRules(zone->rule_id);
+
+			return zone_rules_[index];
+		}
+
+		//===========================================================
+		// Active years of the rules of a zone line
+		//===========================================================
+		RuleYearRanges ZoneHandle::FindRuleYearRanges(const Zone* const zone) const
+		{
+			auto index = static_cast<int>(zone - zone_arr_) - zones_.first;
+
+			if (index < 0 || index >= zones_.size)
+				return snapshot_->FindRuleYearRanges(zone->rule_id);
+
+			return zone_rule_years_[index];
+		}
+	}
+}
@@ -0,0 +1,53 @@
+#include "../include/zone_index.h"
+#include "../include/murmur_hash3.h"
+
+#include <cstring>
+
+namespace smalltime
+{
+	namespace tz
+	{
+		//==================================================================
+		// Hash the name once and spread it into bucket and slot hashes,
+		// names are short so one 32 bit hash is cheaper than a wide one
+		//==================================================================
+		ZoneNameHash HashZoneName(const char* name, std::size_t size)
+		{
+			uint32_t hash = 0;
+			MurmurHash3_x86_32(name, static_cast<int>(size), KZONE_INDEX_SEED, &hash);
+
+			// murmur3 64 bit finalizer
+			uint64_t mixed = hash * 0x9e3779b97f4a7c15ULL;
+			mixed ^= mixed >> 33;
+			mixed *= 0xff51afd7ed558ccdULL;
+			mixed ^= mixed >> 33;
+
+			ZoneNameHash zone_name_hash;
+			zone_name_hash.bucket = hash;
+			zone_name_hash.f1 = static_cast<uint32_t>(mixed);
+			// odd so every displacement moves the slot
+			zone_name_hash.f2 = static_cast<uint32_t>(mixed >> 32) | 1;
+
+			return zone_name_hash;
+		}
+
+		//==================================================================
+		// Find the only slot name can be in and check the name stored there
+		//==================================================================
+		int FindZoneIndex(const std::string& name, const uint32_t* displacement_arr, int bucket_count,
+			const ZoneIndexSlot* slot_arr, int slot_count, const char* name_arr)
+		{
+			if (bucket_count < 1 || slot_count < 1)
+				return -1;
+
+			auto hash = HashZoneName(name.data(), name.size());
+			auto displacement = displacement_arr[hash.bucket % static_cast<uint32_t>(bucket_count)];
+			const auto& slot = slot_arr[ZoneIndexSlotOf(hash, displacement, static_cast<uint32_t>(slot_count))];
+
+			if (slot.name_size != name.size() || std::memcmp(name_arr + slot.name_offset, name.data(), name.size()) != 0)
+				return -1;
+
+			return slot.lookup_index;
+		}
+	}
+}